@@ -15,6 +15,9 @@ AudioRecorder::AudioRecorder()
     exportThread = std::make_unique<ExportThread>(*this);
     exportThread->startThread(juce::Thread::Priority::normal);
     
+    diskWriterThread = std::make_unique<DiskWriterThread>(*this);
+    diskWriterThread->startThread(juce::Thread::Priority::normal);
+    
     logRecordingEvent("AudioRecorder initialized");
 }
 
@@ -29,6 +32,9 @@ AudioRecorder::~AudioRecorder()
         exportThread.reset();
     }
     
+    // Finalises any take still streaming
+    diskWriterThread.reset();
+    
     releaseResources();
 }
 
@@ -41,17 +47,32 @@ void AudioRecorder::prepareToPlay(double sr, int samplesPerBlock_, int numChanne
     samplesPerBlock = samplesPerBlock_;
     numChannels = numChannels_;
     
-    // Calculate buffer size based on max recording time
-    const int bufferSamples = static_cast<int>(sampleRate * maxRecordingTimeSeconds);
-    circularBuffer.setSize(numChannels, bufferSamples);
+    // Calculate buffer size based on max recording time; streamed takes never touch it
+    if (recordingMode.load() == RecordingMode::Memory)
+    {
+        const int bufferSamples = static_cast<int>(sampleRate * maxRecordingTimeSeconds);
+        circularBuffer.setSize(numChannels, bufferSamples);
+    }
+    
+    prepareStreamRing();
     
     logRecordingEvent(juce::String("AudioRecorder prepared: ") + 
                      juce::String(sampleRate, 1) + "Hz, " + 
                      juce::String(numChannels) + " channels, " +
-                     juce::String(maxRecordingTimeSeconds, 1) + "s buffer");
+                     (recordingMode.load() == RecordingMode::Memory
+                         ? juce::String(maxRecordingTimeSeconds, 1) + "s buffer"
+                         : juce::String("streaming to disk")));
 }
 
 void AudioRecorder::processBlock(const juce::AudioBuffer<float>& inputBuffer)
+{
+    // Raised before the state is read, so a stop either stops this block or waits for it
+    inProcessBlock.store(true);
+    recordBlock(inputBuffer);
+    inProcessBlock.store(false);
+}
+
+void AudioRecorder::recordBlock(const juce::AudioBuffer<float>& inputBuffer)
 {
     if (currentState.load() != RecordingState::Recording)
         return;
@@ -63,6 +84,17 @@ void AudioRecorder::processBlock(const juce::AudioBuffer<float>& inputBuffer)
     if (numSamples <= 0 || inputChannels <= 0)
         return;
     
+    // Streamed takes have no length limit; the disk writer drains the ring
+    if (recordingMode.load() == RecordingMode::StreamToDisk)
+    {
+        if (!streamTakeOpen.load())
+            return;
+        
+        pushToStream(inputBuffer, numSamples);
+        totalRecordedSamples.fetch_add(numSamples);
+        return;
+    }
+    
     // Write to circular buffer - this is lock-free and real-time safe
     circularBuffer.writeBlock(inputBuffer, 0, numSamples);
     
@@ -107,7 +139,14 @@ bool AudioRecorder::startRecording()
 {
     if (currentState.load() == RecordingState::Recording)
         return true; // Already recording
-        
+    
+    const bool streaming = recordingMode.load() == RecordingMode::StreamToDisk;
+    if (streaming && currentState.load() == RecordingState::Stopping)
+    {
+        logRecordingEvent("Warning: Previous take is still being written to disk");
+        return false;
+    }
+    
     if (!ensureRecordingDirectory())
     {
         currentState.store(RecordingState::Error);
@@ -120,6 +159,14 @@ bool AudioRecorder::startRecording()
     totalRecordedSamples.store(0);
     recordingStartSample = circularBuffer.getWritePosition();
     bufferOverrunCount.store(0);
+    droppedSamples.store(0);
+    
+    // The disk writer resets the ring as it opens the file; until then nothing is pushed
+    if (streaming)
+    {
+        streamTakeRequested.store(true);
+        diskWriterThread->notify();
+    }
     
     currentState.store(RecordingState::Recording);
     logRecordingEvent("Recording started");
@@ -129,20 +176,39 @@ bool AudioRecorder::startRecording()
 
 void AudioRecorder::stopRecording()
 {
-    if (currentState.load() == RecordingState::Stopped)
+    auto state = currentState.load();
+    if (state == RecordingState::Stopped)
         return; // Already stopped
-        
-    currentState.store(RecordingState::Stopping);
     
-    // Give a moment for any final audio processing
-    juce::Thread::sleep(10);
+    // A streamed take is finalised by the disk writer, which then reports Stopped
+    if (recordingMode.load() == RecordingMode::StreamToDisk)
+    {
+        if (state == RecordingState::Stopping)
+            return;
+        
+        if (state == RecordingState::Recording
+            && currentState.compare_exchange_strong(state, RecordingState::Stopping))
+        {
+            logRecordingEvent("Recording stopping, finalising streamed take");
+            return;
+        }
+    }
     
+    // A block that read the state before this store may still be writing
     currentState.store(RecordingState::Stopped);
+    waitForAudioBlock();
     
     const double duration = getRecordedSeconds();
     logRecordingEvent(juce::String("Recording stopped. Duration: ") + formatDuration(duration));
 }
 
+void AudioRecorder::waitForAudioBlock() const
+{
+    // Bounded by one block; called from the audio thread itself the flag is already clear
+    while (inProcessBlock.load())
+        juce::Thread::yield();
+}
+
 void AudioRecorder::clearBuffer()
 {
     circularBuffer.clear();
@@ -156,12 +222,29 @@ void AudioRecorder::clearBuffer()
 
 bool AudioRecorder::exportToFile(const juce::File& outputFile, ExportFormat format)
 {
+    return exportToFiles({ ExportTarget{ outputFile, format } });
+}
+
+bool AudioRecorder::exportToFiles(const std::vector<ExportTarget>& targets)
+{
+    if (targets.empty())
+        return false;
+    
     if (currentState.load() == RecordingState::Recording)
     {
         logRecordingEvent("Warning: Cannot export while recording");
         return false;
     }
     
+    // An auto-stop is raised from inside processBlock; let that block finish
+    waitForAudioBlock();
+    
+    if (recordingMode.load() == RecordingMode::StreamToDisk)
+    {
+        logRecordingEvent("Warning: Streamed takes are already on disk: " + getLastStreamedFile().getFileName());
+        return false;
+    }
+    
     const juce::int64 samplesRecorded = totalRecordedSamples.load();
     if (samplesRecorded <= 0)
     {
@@ -170,12 +253,58 @@ bool AudioRecorder::exportToFile(const juce::File& outputFile, ExportFormat form
     }
     
     // Start async export
-    exportThread->exportBuffer(outputFile, format, recordingStartSample, samplesRecorded);
-    logRecordingEvent("Export started: " + outputFile.getFileName());
+    if (!exportThread->exportBuffer(targets, recordingStartSample, samplesRecorded))
+    {
+        logRecordingEvent("Warning: An export is already running");
+        return false;
+    }
+    
+    for (const auto& target : targets)
+        logRecordingEvent("Export started: " + target.file.getFileName());
     
     return true;
 }
 
+void AudioRecorder::cancelExport()
+{
+    exportThread->cancel();
+}
+
+bool AudioRecorder::isExporting() const
+{
+    return exportThread->isBusy();
+}
+
+float AudioRecorder::getExportProgress() const
+{
+    return exportThread->getProgress();
+}
+
+std::vector<AudioRecorder::ExportTarget> AudioRecorder::createExportTargets(const juce::File& baseFile, int formatMask)
+{
+    static constexpr ExportFormat allFormats[] = { ExportFormat::WAV_16bit, ExportFormat::WAV_24bit,
+                                                   ExportFormat::WAV_32bit_Float, ExportFormat::AIFF_16bit,
+                                                   ExportFormat::AIFF_24bit };
+    static constexpr const char* suffixes[] = { "_16bit", "_24bit", "_32float", "_16bit", "_24bit" };
+    
+    std::vector<ExportTarget> targets;
+    const bool severalFormats = (formatMask & (formatMask - 1)) != 0;
+    const auto baseName = baseFile.getFileNameWithoutExtension();
+    
+    for (size_t i = 0; i < std::size(allFormats); ++i)
+    {
+        if ((formatMask & getFormatBit(allFormats[i])) == 0)
+            continue;
+        
+        // Formats sharing an extension need distinct names
+        const auto name = baseName + (severalFormats ? juce::String(suffixes[i]) : juce::String())
+                        + getFileExtension(allFormats[i]);
+        targets.push_back({ baseFile.getSiblingFile(name), allFormats[i] });
+    }
+    
+    return targets;
+}
+
 bool AudioRecorder::exportCurrentRecording(const juce::String& filename, ExportFormat format)
 {
     if (!ensureRecordingDirectory())
@@ -187,20 +316,7 @@ bool AudioRecorder::exportCurrentRecording(const juce::String& filename, ExportF
         
     // Add extension based on format
     if (!actualFilename.contains("."))
-    {
-        switch (format)
-        {
-            case ExportFormat::WAV_16bit:
-            case ExportFormat::WAV_24bit:
-            case ExportFormat::WAV_32bit_Float:
-                actualFilename += ".wav";
-                break;
-            case ExportFormat::AIFF_16bit:
-            case ExportFormat::AIFF_24bit:
-                actualFilename += ".aiff";
-                break;
-        }
-    }
+        actualFilename += getFileExtension(format);
     
     auto outputFile = recordingDirectory.getChildFile(actualFilename);
     return exportToFile(outputFile, format);
@@ -217,6 +333,7 @@ AudioRecorder::RecordingInfo AudioRecorder::getRecordingInfo() const
     info.recordedSeconds = getRecordedSeconds();
     info.bufferUsagePercent = getBufferUsagePercent();
     info.bufferOverruns = bufferOverrunCount.load();
+    info.droppedSamples = droppedSamples.load();
     
     return info;
 }
@@ -231,6 +348,13 @@ double AudioRecorder::getRecordedSeconds() const
 
 float AudioRecorder::getBufferUsagePercent() const
 {
+    if (recordingMode.load() == RecordingMode::StreamToDisk)
+    {
+        const int ringSize = streamFifo.getTotalSize();
+        return ringSize > 0 ? static_cast<float>(streamFifo.getNumReady()) / static_cast<float>(ringSize) * 100.0f
+                            : 0.0f;
+    }
+    
     const juce::int64 availableSamples = circularBuffer.getAvailableSamples();
     const juce::int64 maxSamples = static_cast<juce::int64>(sampleRate * maxRecordingTimeSeconds);
     
@@ -269,6 +393,27 @@ juce::Array<juce::File> AudioRecorder::getRecentRecordings() const
     return files;
 }
 
+juce::String AudioRecorder::getFileExtension(ExportFormat format)
+{
+    switch (format)
+    {
+        case ExportFormat::AIFF_16bit:
+        case ExportFormat::AIFF_24bit:
+            return ".aiff";
+        case ExportFormat::WAV_16bit:
+        case ExportFormat::WAV_24bit:
+        case ExportFormat::WAV_32bit_Float:
+        default:
+            return ".wav";
+    }
+}
+
+juce::File AudioRecorder::getLastStreamedFile() const
+{
+    const juce::ScopedLock lock(streamFileLock);
+    return lastStreamedFile;
+}
+
 //==============================================================================
 // Configuration
 
@@ -288,6 +433,29 @@ void AudioRecorder::setBufferSize(int numSamples)
     }
 }
 
+void AudioRecorder::setRecordingMode(RecordingMode mode)
+{
+    const auto state = currentState.load();
+    if (state == RecordingState::Recording || state == RecordingState::Stopping)
+    {
+        logRecordingEvent("Warning: Cannot change recording mode while recording");
+        return;
+    }
+    
+    if (recordingMode.exchange(mode) == mode)
+        return;
+    
+    // The in-memory take buffer is only needed when not streaming
+    if (mode == RecordingMode::StreamToDisk)
+        circularBuffer.release();
+    else
+        circularBuffer.setSize(numChannels, static_cast<int>(sampleRate * maxRecordingTimeSeconds));
+    
+    totalRecordedSamples.store(0);
+    logRecordingEvent(mode == RecordingMode::StreamToDisk ? "Recording mode: stream to disk"
+                                                          : "Recording mode: memory");
+}
+
 //==============================================================================
 // Private Methods
 
@@ -297,6 +465,59 @@ void AudioRecorder::updateRecordingState()
     // For now, state is managed directly in other methods
 }
 
+void AudioRecorder::prepareStreamRing()
+{
+    // Never reallocate under a take the disk writer is still draining
+    const auto state = currentState.load();
+    if (streamFifo.getTotalSize() > 1 && (state == RecordingState::Recording || state == RecordingState::Stopping))
+        return;
+    
+    const int ringSamples = juce::jmax(STREAM_CHUNK_SAMPLES * 2,
+                                       static_cast<int>(sampleRate * STREAM_RING_SECONDS));
+    
+    streamRing.setSize(juce::jmax(1, numChannels), ringSamples);
+    streamRing.clear();
+    streamFifo.setTotalSize(ringSamples);
+    streamFifo.reset();
+}
+
+void AudioRecorder::pushToStream(const juce::AudioBuffer<float>& inputBuffer, int numSamples)
+{
+    int start1, size1, start2, size2;
+    streamFifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+    
+    const int channelsToWrite = juce::jmin(inputBuffer.getNumChannels(), streamRing.getNumChannels());
+    
+    for (int ch = 0; ch < streamRing.getNumChannels(); ++ch)
+    {
+        if (ch < channelsToWrite)
+        {
+            if (size1 > 0)
+                streamRing.copyFrom(ch, start1, inputBuffer, ch, 0, size1);
+            if (size2 > 0)
+                streamRing.copyFrom(ch, start2, inputBuffer, ch, size1, size2);
+        }
+        else
+        {
+            if (size1 > 0)
+                streamRing.clear(ch, start1, size1);
+            if (size2 > 0)
+                streamRing.clear(ch, start2, size2);
+        }
+    }
+    
+    streamFifo.finishedWrite(size1 + size2);
+    
+    // Whatever did not fit is lost; count it exactly rather than flagging
+    const int dropped = numSamples - (size1 + size2);
+    if (dropped > 0)
+    {
+        droppedSamples.fetch_add(dropped);
+        bufferOverrunCount.fetch_add(1);
+        lastOverrunTime = juce::Time::getMillisecondCounter();
+    }
+}
+
 bool AudioRecorder::ensureRecordingDirectory()
 {
     if (!recordingDirectory.exists())
@@ -363,6 +584,14 @@ void AudioRecorder::CircularBuffer::clear()
     hasOverrunFlag.store(false);
 }
 
+void AudioRecorder::CircularBuffer::release()
+{
+    buffer.reset();
+    bufferSize = 0;
+    writePosition.store(0);
+    hasOverrunFlag.store(false);
+}
+
 void AudioRecorder::CircularBuffer::writeBlock(const juce::AudioBuffer<float>& source, int startSample, int numSamples)
 {
     if (!buffer || numSamples <= 0)
@@ -477,17 +706,26 @@ AudioRecorder::ExportThread::~ExportThread()
     waitForThreadToExit(2000);
 }
 
-void AudioRecorder::ExportThread::exportBuffer(const juce::File& file, ExportFormat format, 
-                                              juce::int64 startSample, juce::int64 numSamples)
+bool AudioRecorder::ExportThread::exportBuffer(const std::vector<ExportTarget>& targets,
+                                               juce::int64 startSample, juce::int64 numSamples)
 {
-    pendingFile = file;
-    pendingFormat = format;
-    pendingStartSample = startSample;
-    pendingNumSamples = numSamples;
+    if (hasExportTask.load())
+        return false;
+    
+    {
+        const juce::ScopedLock lock(taskLock);
+        pendingTargets = targets;
+        pendingStartSample = startSample;
+        pendingNumSamples = numSamples;
+    }
+    
+    cancelRequested.store(false);
+    progress.store(0.0f);
     hasExportTask.store(true);
     
     // Wake up the thread
     notify();
+    return true;
 }
 
 void AudioRecorder::ExportThread::run()
@@ -496,16 +734,26 @@ void AudioRecorder::ExportThread::run()
     {
         if (hasExportTask.load())
         {
-            // Process the export task
-            const bool success = writeBufferToFile(pendingFile, pendingFormat, pendingStartSample, pendingNumSamples);
-            
-            if (success)
+            std::vector<ExportTarget> targets;
+            juce::int64 startSample = 0, numSamples = 0;
             {
-                recorder.logRecordingEvent("Export completed: " + pendingFile.getFileName());
+                const juce::ScopedLock lock(taskLock);
+                targets = pendingTargets;
+                startSample = pendingStartSample;
+                numSamples = pendingNumSamples;
             }
-            else
+            
+            // Process the export task
+            const bool success = writeBufferToFiles(targets, startSample, numSamples);
+            
+            for (const auto& target : targets)
             {
-                recorder.logRecordingEvent("Export failed: " + pendingFile.getFileName());
+                if (success)
+                    recorder.logRecordingEvent("Export completed: " + target.file.getFileName());
+                else if (cancelRequested.load())
+                    recorder.logRecordingEvent("Export cancelled: " + target.file.getFileName());
+                else
+                    recorder.logRecordingEvent("Export failed: " + target.file.getFileName());
             }
             
             hasExportTask.store(false);
@@ -518,49 +766,162 @@ void AudioRecorder::ExportThread::run()
     }
 }
 
-bool AudioRecorder::ExportThread::writeBufferToFile(const juce::File& file, ExportFormat format, 
-                                                   juce::int64 startSample, juce::int64 numSamples)
+//==============================================================================
+// TargetEncoder - one output file of a multi-target export
+
+class AudioRecorder::ExportThread::TargetEncoder
 {
-    if (numSamples <= 0)
-        return false;
+public:
+    TargetEncoder(const ExportTarget& target_, int numChannels_, int blockSize, int seed)
+        : target(target_), numChannels(numChannels_), random(seed)
+    {
+        dither = target.format == ExportFormat::WAV_16bit || target.format == ExportFormat::AIFF_16bit;
         
-    auto writer = createWriter(file, format);
-    if (!writer)
-        return false;
+        if (dither)
+            scratch.setSize(numChannels, blockSize);
+    }
+    
+    bool open(AudioRecorder& recorder)
+    {
+        writer = recorder.createWriter(target.file, target.format);
+        return writer != nullptr;
+    }
+    
+    bool encode(const juce::AudioBuffer<float>& source, int numSamples)
+    {
+        if (!dither)
+            return writer->writeFromAudioSampleBuffer(source, 0, numSamples);
         
+        // TPDF dither: the difference of two uniform variables spans +/-1 LSB
+        constexpr float lsb = 1.0f / 32768.0f;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const float* input = source.getReadPointer(ch);
+            float* output = scratch.getWritePointer(ch);
+            
+            for (int i = 0; i < numSamples; ++i)
+                output[i] = input[i] + (random.nextFloat() - random.nextFloat()) * lsb;
+        }
+        
+        return writer->writeFromAudioSampleBuffer(scratch, 0, numSamples);
+    }
+    
+    bool finish()
+    {
+        const bool ok = writer->flush();
+        writer.reset();
+        return ok;
+    }
+    
+    void discard()
+    {
+        writer.reset();
+        target.file.deleteFile();
+    }
+
+private:
+    ExportTarget target;
+    int numChannels = 2;
+    bool dither = false;
+    juce::Random random;
+    juce::AudioBuffer<float> scratch;
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+};
+
+bool AudioRecorder::ExportThread::writeBufferToFiles(const std::vector<ExportTarget>& targets,
+                                                     juce::int64 startSample, juce::int64 numSamples)
+{
+    if (numSamples <= 0 || targets.empty())
+        return false;
+    
     // Export in chunks to avoid large memory allocations
-    constexpr int CHUNK_SIZE = 8192;
-    juce::AudioBuffer<float> tempBuffer(recorder.numChannels, CHUNK_SIZE);
+    constexpr int CHUNK_SIZE = 65536;
+    const int numChannels = recorder.numChannels;
     
-    juce::int64 samplesRemaining = numSamples;
-    juce::int64 currentSample = startSample;
+    std::vector<std::unique_ptr<TargetEncoder>> encoders;
+    const auto discardAll = [&encoders]
+    {
+        for (auto& encoder : encoders)
+            encoder->discard();
+        return false;
+    };
     
-    while (samplesRemaining > 0 && !threadShouldExit())
+    for (size_t i = 0; i < targets.size(); ++i)
     {
-        const int samplesToWrite = static_cast<int>(juce::jmin(samplesRemaining, static_cast<juce::int64>(CHUNK_SIZE)));
+        encoders.push_back(std::make_unique<TargetEncoder>(targets[i], numChannels, CHUNK_SIZE,
+                                                           static_cast<int>(i) + 1));
+        if (!encoders.back()->open(recorder))
+        {
+            recorder.logRecordingEvent("Error: Could not open " + targets[i].file.getFileName());
+            return discardAll();
+        }
+    }
+    
+    // Double-buffered: the next block is read while the encoders work on this one
+    juce::AudioBuffer<float> blocks[2] = { juce::AudioBuffer<float>(numChannels, CHUNK_SIZE),
+                                           juce::AudioBuffer<float>(numChannels, CHUNK_SIZE) };
+    std::atomic<int> pendingJobs{ 0 };
+    std::atomic<bool> encodeFailed{ false };
+    juce::WaitableEvent blockEncoded;
+    
+    const auto chunkLength = [numSamples](juce::int64 position)
+    {
+        return static_cast<int>(juce::jmin(numSamples - position, static_cast<juce::int64>(CHUNK_SIZE)));
+    };
+    
+    int current = 0;
+    recorder.circularBuffer.readBlock(blocks[current], startSample, chunkLength(0));
+    
+    for (juce::int64 position = 0; position < numSamples;)
+    {
+        const int count = chunkLength(position);
+        const auto& block = blocks[current];
+        
+        pendingJobs.store(static_cast<int>(encoders.size()));
+        for (auto& encoder : encoders)
+        {
+            auto* target = encoder.get();
+            encoderPool.addJob([&, target, count]
+            {
+                if (!target->encode(block, count))
+                    encodeFailed.store(true);
+                
+                if (--pendingJobs == 0)
+                    blockEncoded.signal();
+            });
+        }
         
-        // Read from circular buffer
-        recorder.circularBuffer.readBlock(tempBuffer, currentSample, samplesToWrite);
+        const juce::int64 nextPosition = position + count;
+        if (nextPosition < numSamples)
+            recorder.circularBuffer.readBlock(blocks[1 - current], startSample + nextPosition, chunkLength(nextPosition));
         
-        // Write to file
-        if (!writer->writeFromAudioSampleBuffer(tempBuffer, 0, samplesToWrite))
+        blockEncoded.wait(-1);
+        
+        if (encodeFailed.load())
         {
             recorder.logRecordingEvent("Error writing audio data to file");
-            return false;
+            return discardAll();
         }
         
-        samplesRemaining -= samplesToWrite;
-        currentSample += samplesToWrite;
+        if (cancelRequested.load() || threadShouldExit())
+            return discardAll();
         
-        // Small yield to prevent blocking
-        juce::Thread::yield();
+        position = nextPosition;
+        current = 1 - current;
+        progress.store(static_cast<float>(static_cast<double>(position) / static_cast<double>(numSamples)));
     }
     
-    writer->flush();
-    return true;
+    bool ok = true;
+    for (auto& encoder : encoders)
+        ok = encoder->finish() && ok;
+    
+    return ok;
 }
 
-std::unique_ptr<juce::AudioFormatWriter> AudioRecorder::ExportThread::createWriter(const juce::File& file, ExportFormat format)
+//==============================================================================
+// Writer Creation
+
+std::unique_ptr<juce::AudioFormatWriter> AudioRecorder::createWriter(const juce::File& file, ExportFormat format)
 {
     juce::AudioFormatManager formatManager;
     formatManager.registerBasicFormats();
@@ -594,21 +955,195 @@ std::unique_ptr<juce::AudioFormatWriter> AudioRecorder::ExportThread::createWrit
     
     if (!audioFormat)
     {
-        recorder.logRecordingEvent("Error: Unsupported audio format");
+        logRecordingEvent("Error: Unsupported audio format");
         return nullptr;
     }
     
     auto fileStream = file.createOutputStream();
     if (!fileStream)
     {
-        recorder.logRecordingEvent("Error: Could not create output file stream");
+        logRecordingEvent("Error: Could not create output file stream");
         return nullptr;
     }
     
+    // createOutputStream appends; an export replaces any existing file
+    fileStream->setPosition(0);
+    fileStream->truncate();
+    
     return std::unique_ptr<juce::AudioFormatWriter>(
         audioFormat->createWriterFor(fileStream.release(), 
-                                   recorder.sampleRate,
-                                   recorder.numChannels,
+                                   sampleRate,
+                                   numChannels,
                                    bitsPerSample,
                                    {}, 0));
-}
\ No newline at end of file
+}
+
+//==============================================================================
+// DiskWriterThread Implementation
+
+AudioRecorder::DiskWriterThread::DiskWriterThread(AudioRecorder& owner_)
+    : juce::Thread("AudioRecorder Disk Writer"), recorder(owner_)
+{
+}
+
+AudioRecorder::DiskWriterThread::~DiskWriterThread()
+{
+    stopThread(4000);
+    ioThread.stopThread(2000);
+}
+
+void AudioRecorder::DiskWriterThread::run()
+{
+    while (!threadShouldExit())
+    {
+        if (recorder.streamTakeRequested.exchange(false) && !openTake())
+        {
+            recorder.currentState.store(RecordingState::Error);
+            continue;
+        }
+        
+        if (isTakeOpen())
+        {
+            // Once the audio thread has stopped writing, flush the tail and finalise.
+            // A block that saw the take still recording may be mid-push, so wait it out
+            const bool finishing = recorder.currentState.load() != RecordingState::Recording;
+            if (finishing)
+                recorder.waitForAudioBlock();
+            
+            const bool ok = drainRing(finishing);
+            
+            if (finishing || !ok)
+            {
+                closeTake();
+                recorder.currentState.store(ok ? RecordingState::Stopped : RecordingState::Error);
+                continue;
+            }
+        }
+        
+        wait(STREAM_POLL_MS);
+    }
+    
+    // Shutting down mid-take: keep what has been captured
+    if (isTakeOpen())
+    {
+        recorder.streamTakeOpen.store(false);
+        recorder.waitForAudioBlock();
+        drainRing(true);
+        closeTake();
+        recorder.currentState.store(RecordingState::Stopped);
+    }
+}
+
+bool AudioRecorder::DiskWriterThread::openTake()
+{
+    const auto format = recorder.streamingFormat;
+    takeFile = recorder.recordingDirectory.getChildFile(recorder.generateTimestampedFilename()
+                                                        + getFileExtension(format))
+                                          .getNonexistentSibling();
+    samplesWritten = 0;
+    
+    writer = recorder.createWriter(takeFile, format);
+    if (!writer)
+    {
+        recorder.logRecordingEvent("Error: Could not open streaming file " + takeFile.getFileName());
+        return false;
+    }
+    
+    // Optionally hand file I/O to a second thread so slow disks never stall the ring drain
+    if (recorder.useThreadedWriter)
+    {
+        if (!ioThread.isThreadRunning())
+            ioThread.startThread(juce::Thread::Priority::normal);
+        
+        threadedWriter = std::make_unique<juce::AudioFormatWriter::ThreadedWriter>(writer.release(), ioThread,
+                                                                                    STREAM_CHUNK_SAMPLES * 4);
+    }
+    
+    channelPointers.assign(static_cast<size_t>(recorder.streamRing.getNumChannels()), nullptr);
+    
+    // Nothing is pushed while no take is open, so the reader can reset the ring;
+    // anything a failed or interrupted take left behind is discarded here
+    recorder.streamFifo.reset();
+    recorder.streamTakeOpen.store(true);
+    
+    {
+        const juce::ScopedLock lock(recorder.streamFileLock);
+        recorder.lastStreamedFile = takeFile;
+    }
+    
+    recorder.logRecordingEvent("Streaming to " + takeFile.getFullPathName());
+    return true;
+}
+
+bool AudioRecorder::DiskWriterThread::drainRing(bool writeAll)
+{
+    const int numReady = recorder.streamFifo.getNumReady();
+    
+    // Batch small blocks into large sequential writes
+    if (numReady == 0 || (!writeAll && numReady < STREAM_CHUNK_SAMPLES))
+        return true;
+    
+    int start1, size1, start2, size2;
+    recorder.streamFifo.prepareToRead(numReady, start1, size1, start2, size2);
+    
+    const bool ok = writeRegion(start1, size1) && writeRegion(start2, size2);
+    
+    recorder.streamFifo.finishedRead(size1 + size2);
+    return ok;
+}
+
+bool AudioRecorder::DiskWriterThread::writeRegion(int start, int numSamples)
+{
+    if (numSamples <= 0)
+        return true;
+    
+    if (writer)
+    {
+        if (!writer->writeFromAudioSampleBuffer(recorder.streamRing, start, numSamples))
+        {
+            recorder.logRecordingEvent("Error writing audio data to " + takeFile.getFileName());
+            return false;
+        }
+        
+        samplesWritten += numSamples;
+        return true;
+    }
+    
+    // The threaded writer refuses blocks when its own FIFO is full; retry until accepted
+    for (int offset = 0; offset < numSamples;)
+    {
+        const int count = juce::jmin(numSamples - offset, STREAM_CHUNK_SAMPLES);
+        
+        for (size_t ch = 0; ch < channelPointers.size(); ++ch)
+            channelPointers[ch] = recorder.streamRing.getReadPointer(static_cast<int>(ch), start + offset);
+        
+        if (threadedWriter->write(channelPointers.data(), count))
+        {
+            offset += count;
+            samplesWritten += count;
+        }
+        else if (threadShouldExit())
+        {
+            return false;
+        }
+        else
+        {
+            wait(1);
+        }
+    }
+    
+    return true;
+}
+
+void AudioRecorder::DiskWriterThread::closeTake()
+{
+    recorder.streamTakeOpen.store(false);
+    
+    // Destroying the writers flushes pending data and finalises the header
+    threadedWriter.reset();
+    writer.reset();
+    
+    recorder.logRecordingEvent("Streamed take closed: " + takeFile.getFileName() + " ("
+                               + recorder.formatDuration(static_cast<double>(samplesWritten) / recorder.sampleRate)
+                               + ", " + juce::String(recorder.droppedSamples.load()) + " samples dropped)");
+}
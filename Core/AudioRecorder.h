@@ -3,6 +3,7 @@
 #include <JuceHeader.h>
 #include <atomic>
 #include <memory>
+#include <vector>
 
 /**
  * AudioRecorder - Real-time audio capture for ARTEFACT
@@ -12,7 +13,12 @@
  * 
  * Features:
  * - Lock-free circular buffer for real-time capture
+ * - Streaming mode: the audio thread feeds an SPSC ring that a disk writer
+ *   thread drains to file in large sequential chunks, so take length is
+ *   unbounded and memory use is constant
  * - WAV and AIFF export formats  
+ * - Multi-target export: one pass over the take feeds several encoders on a
+ *   worker pool, with TPDF dither for 16-bit targets
  * - Configurable sample rate and bit depth
  * - Performance monitoring and overflow detection
  * - Terminal-style status reporting
@@ -31,6 +37,12 @@ public:
         Error
     };
     
+    enum class RecordingMode
+    {
+        Memory,         // Capture into the circular buffer, write on export
+        StreamToDisk    // Write to a file in the recording directory while capturing
+    };
+    
     enum class ExportFormat
     {
         WAV_16bit,
@@ -40,6 +52,12 @@ public:
         AIFF_24bit
     };
     
+    struct ExportTarget
+    {
+        juce::File file;
+        ExportFormat format = ExportFormat::WAV_24bit;
+    };
+    
     struct RecordingInfo
     {
         RecordingState state = RecordingState::Stopped;
@@ -47,6 +65,7 @@ public:
         double recordedSeconds = 0.0;
         float bufferUsagePercent = 0.0f;
         int bufferOverruns = 0;
+        juce::int64 droppedSamples = 0;
         
         RecordingInfo() = default;
     };
@@ -69,23 +88,40 @@ public:
     
     // Export functionality
     bool exportToFile(const juce::File& outputFile, ExportFormat format = ExportFormat::WAV_24bit);
+    bool exportToFiles(const std::vector<ExportTarget>& targets);
     bool exportCurrentRecording(const juce::String& filename, ExportFormat format = ExportFormat::WAV_24bit);
+    void cancelExport();
+    bool isExporting() const;
+    float getExportProgress() const;
+    
+    // One target per bit set in formatMask (see getFormatBit), named after baseFile
+    static std::vector<ExportTarget> createExportTargets(const juce::File& baseFile, int formatMask);
+    static int getFormatBit(ExportFormat format) { return 1 << static_cast<int>(format); }
     
     // Configuration
     void setMaxRecordingTime(double maxSeconds) { maxRecordingTimeSeconds = maxSeconds; }
     void setBufferSize(int numSamples);
     void setRecordingDirectory(const juce::File& directory) { recordingDirectory = directory; }
     
+    // Streaming configuration (only while not recording)
+    void setRecordingMode(RecordingMode mode);
+    RecordingMode getRecordingMode() const { return recordingMode.load(); }
+    void setStreamingFormat(ExportFormat format) { streamingFormat = format; }
+    void setUseThreadedWriter(bool shouldUse) { useThreadedWriter = shouldUse; }
+    juce::File getLastStreamedFile() const;
+    
     // Status and monitoring
     RecordingInfo getRecordingInfo() const;
     RecordingState getState() const { return currentState.load(); }
     bool isRecording() const { return currentState.load() == RecordingState::Recording; }
     double getRecordedSeconds() const;
     float getBufferUsagePercent() const;
+    juce::int64 getDroppedSamples() const { return droppedSamples.load(); }
     
     // File management
     juce::String generateTimestampedFilename(const juce::String& baseName = "ARTEFACT_Recording") const;
     juce::Array<juce::File> getRecentRecordings() const;
+    static juce::String getFileExtension(ExportFormat format);
     
 private:
     //==============================================================================
@@ -99,6 +135,7 @@ private:
         
         void setSize(int numChannels, int numSamples);
         void clear();
+        void release();
         
         // Thread-safe write (called from audio thread)
         void writeBlock(const juce::AudioBuffer<float>& source, int startSample, int numSamples);
@@ -131,26 +168,66 @@ private:
         ExportThread(AudioRecorder& owner);
         ~ExportThread() override;
         
-        void exportBuffer(const juce::File& file, ExportFormat format, 
-                         juce::int64 startSample, juce::int64 numSamples);
+        bool exportBuffer(const std::vector<ExportTarget>& targets,
+                          juce::int64 startSample, juce::int64 numSamples);
+        void cancel() { cancelRequested.store(true); }
+        bool isBusy() const { return hasExportTask.load(); }
+        float getProgress() const { return progress.load(); }
         
         void run() override;
-        
+    
     private:
+        class TargetEncoder;
+        
         AudioRecorder& recorder;
-        juce::File pendingFile;
-        ExportFormat pendingFormat = ExportFormat::WAV_24bit;
+        juce::CriticalSection taskLock;
+        std::vector<ExportTarget> pendingTargets;
         juce::int64 pendingStartSample = 0;
         juce::int64 pendingNumSamples = 0;
         std::atomic<bool> hasExportTask{ false };
+        std::atomic<bool> cancelRequested{ false };
+        std::atomic<float> progress{ 0.0f };
+        juce::ThreadPool encoderPool{ juce::jlimit(1, 4, juce::SystemStats::getNumCpus() - 1) };
         
-        bool writeBufferToFile(const juce::File& file, ExportFormat format, 
-                              juce::int64 startSample, juce::int64 numSamples);
-        std::unique_ptr<juce::AudioFormatWriter> createWriter(const juce::File& file, ExportFormat format);
+        bool writeBufferToFiles(const std::vector<ExportTarget>& targets,
+                                juce::int64 startSample, juce::int64 numSamples);
         
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ExportThread)
     };
     
+    //==============================================================================
+    // Disk Streaming
+    
+    static constexpr int STREAM_RING_SECONDS = 4;       // Slack between audio and disk
+    static constexpr int STREAM_CHUNK_SAMPLES = 32768;  // Minimum sequential write size
+    static constexpr int STREAM_POLL_MS = 10;
+    
+    class DiskWriterThread : public juce::Thread
+    {
+    public:
+        DiskWriterThread(AudioRecorder& owner);
+        ~DiskWriterThread() override;
+        
+        void run() override;
+    
+    private:
+        AudioRecorder& recorder;
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+        std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> threadedWriter;
+        juce::TimeSliceThread ioThread{ "AudioRecorder Disk IO" };
+        std::vector<const float*> channelPointers;
+        juce::File takeFile;
+        juce::int64 samplesWritten = 0;
+        
+        bool isTakeOpen() const { return writer != nullptr || threadedWriter != nullptr; }
+        bool openTake();
+        bool drainRing(bool writeAll);
+        bool writeRegion(int start, int numSamples);
+        void closeTake();
+        
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DiskWriterThread)
+    };
+    
     //==============================================================================
     // Member Variables
     
@@ -160,6 +237,9 @@ private:
     int samplesPerBlock = 512;
     int numChannels = 2;
     
+    // Set for the duration of processBlock; stopRecording waits for it to clear
+    std::atomic<bool> inProcessBlock{ false };
+    
     // Recording state
     std::atomic<juce::int64> totalRecordedSamples{ 0 };
     juce::int64 recordingStartSample = 0;
@@ -173,6 +253,19 @@ private:
     juce::File recordingDirectory;
     std::unique_ptr<ExportThread> exportThread;
     
+    // Streaming state (ring written by the audio thread, read by the disk writer)
+    std::atomic<RecordingMode> recordingMode{ RecordingMode::Memory };
+    ExportFormat streamingFormat = ExportFormat::WAV_24bit;
+    bool useThreadedWriter = false;
+    juce::AbstractFifo streamFifo{ 1 };
+    juce::AudioBuffer<float> streamRing;
+    std::atomic<bool> streamTakeRequested{ false };
+    std::atomic<bool> streamTakeOpen{ false };   // Raised by the disk writer once the ring is reset for a take
+    std::atomic<juce::int64> droppedSamples{ 0 };
+    juce::CriticalSection streamFileLock;
+    juce::File lastStreamedFile;
+    std::unique_ptr<DiskWriterThread> diskWriterThread;
+    
     // Performance monitoring
     std::atomic<int> bufferOverrunCount{ 0 };
     juce::uint32 lastOverrunTime = 0;
@@ -181,7 +274,12 @@ private:
     // Private Methods
     
     void updateRecordingState();
+    void recordBlock(const juce::AudioBuffer<float>& inputBuffer);
+    void waitForAudioBlock() const;
     bool ensureRecordingDirectory();
+    void prepareStreamRing();
+    void pushToStream(const juce::AudioBuffer<float>& inputBuffer, int numSamples);
+    std::unique_ptr<juce::AudioFormatWriter> createWriter(const juce::File& file, ExportFormat format);
     juce::String formatDuration(double seconds) const;
     void logRecordingEvent(const juce::String& message) const;
     
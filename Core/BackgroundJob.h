@@ -0,0 +1,159 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+/**
+ * BackgroundJob - Newest-request-wins worker behind the file importers
+ *
+ * start() queues a job from the message thread and bumps the generation, so
+ * a job already running sees isCancelled() and is abandoned. One worker
+ * thread runs the owner's work function on the newest job and publishes the
+ * result for takeResult() to hand over once; a null result (unreadable file,
+ * failed decode) just ends the job.
+ *
+ * Work that fans out goes to getPool(), a single pool shared by every
+ * importer in the process, so concurrent imports never add a thread per core
+ * each.
+ *
+ * Job must have a juce::uint32 generation member, which start() fills in.
+ * Declare the BackgroundJob last in its owner: it stops its thread before
+ * the members the work function uses are destroyed.
+ */
+template <typename Job, typename Result>
+class BackgroundJob
+{
+public:
+    using Work = std::function<std::shared_ptr<Result>(const Job&)>;
+    
+    BackgroundJob(const juce::String& threadName, Work workToRun)
+        : work(std::move(workToRun)), worker(*this, threadName)
+    {
+        worker.startThread(juce::Thread::Priority::low);
+    }
+    
+    ~BackgroundJob()
+    {
+        worker.stopThread(4000);
+    }
+    
+    //==============================================================================
+    // Message thread
+    
+    void start(Job job)
+    {
+        {
+            const juce::ScopedLock lock(jobLock);
+            
+            job.generation = ++generation;
+            pendingJob = std::move(job);
+            hasPendingJob = true;
+            completedResult.reset();
+            
+            progress.store(0.0f);
+            busy.store(true);
+        }
+        
+        worker.notify();
+    }
+    
+    void cancel()
+    {
+        const juce::ScopedLock lock(jobLock);
+        
+        ++generation;
+        hasPendingJob = false;
+        completedResult.reset();
+        
+        progress.store(0.0f);
+        busy.store(false);
+    }
+    
+    bool isBusy() const { return busy.load(); }
+    float getProgress() const { return progress.load(); }
+    
+    // Finished job's result, handed over once; nullptr until then
+    std::shared_ptr<const Result> takeResult()
+    {
+        const juce::ScopedLock lock(jobLock);
+        return std::move(completedResult);
+    }
+    
+    //==============================================================================
+    // Worker thread and its pool jobs
+    
+    bool isCancelled(const Job& job) const
+    {
+        return job.generation != generation.load() || worker.threadShouldExit();
+    }
+    
+    void setProgress(float newProgress) { progress.store(newProgress); }
+    
+    juce::ThreadPool& getPool() const { return sharedPool->pool; }
+
+private:
+    struct SharedPool
+    {
+        juce::ThreadPool pool{ juce::jmax(1, juce::SystemStats::getNumCpus() - 1) };
+    };
+    
+    bool processNextJob()
+    {
+        Job job;
+        {
+            const juce::ScopedLock lock(jobLock);
+            if (!hasPendingJob)
+                return false;
+            
+            job = pendingJob;
+            hasPendingJob = false;
+        }
+        
+        auto result = work(job);
+        
+        const juce::ScopedLock lock(jobLock);
+        if (job.generation != generation.load())
+            return true;
+        
+        completedResult = std::move(result);
+        progress.store(completedResult != nullptr ? 1.0f : 0.0f);
+        busy.store(false);
+        return true;
+    }
+    
+    class WorkerThread : public juce::Thread
+    {
+    public:
+        WorkerThread(BackgroundJob& owner, const juce::String& name) : juce::Thread(name), job(owner) {}
+        
+        void run() override
+        {
+            while (!threadShouldExit())
+            {
+                if (!job.processNextJob())
+                    wait(-1);
+            }
+        }
+    
+    private:
+        BackgroundJob& job;
+    };
+    
+    Work work;
+    juce::SharedResourcePointer<SharedPool> sharedPool;
+    
+    juce::CriticalSection jobLock;
+    Job pendingJob;
+    bool hasPendingJob = false;
+    std::shared_ptr<const Result> completedResult;
+    
+    std::atomic<juce::uint32> generation{0};
+    std::atomic<bool> busy{false};
+    std::atomic<float> progress{0.0f};
+    
+    WorkerThread worker;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BackgroundJob)
+};
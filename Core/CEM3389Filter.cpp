@@ -9,6 +9,7 @@
  ******************************************************************************/
 
 #include "CEM3389Filter.h"
+#include <cstring>
 
 //==============================================================================
 // Constructor
@@ -36,10 +37,31 @@ CEM3389Filter::CEM3389Filter()
 void CEM3389Filter::setSampleRate(double sampleRate)
 {
     currentSampleRate = sampleRate;
+    processingSampleRate = sampleRate;
     reset();
     updateFilterCoefficients();
 }
 
+void CEM3389Filter::prepare(double sampleRate, int maxBlockSize, int numChannels)
+{
+    setSampleRate(sampleRate);
+    
+    // 2x oversampler for the Render tier
+    oversampledChannels = juce::jlimit(1, MAX_CHANNELS, numChannels);
+    oversampler = std::make_unique<juce::dsp::Oversampling<float>>(
+        static_cast<size_t>(oversampledChannels), 1,
+        juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true);
+    oversampler->initProcessing(static_cast<size_t>(maxBlockSize));
+}
+
+int CEM3389Filter::getLatencySamples(ProcessingQuality quality) const
+{
+    if (quality != ProcessingQuality::Render || oversampler == nullptr)
+        return 0;
+    
+    return juce::roundToInt(oversampler->getLatencyInSamples());
+}
+
 void CEM3389Filter::reset()
 {
     // Clear all filter state
@@ -51,19 +73,87 @@ void CEM3389Filter::reset()
     
     modulationPhase = 0.0f;
     noiseGenerator.setSeedRandomly();
+    
+    if (oversampler != nullptr)
+        oversampler->reset();
+    
+    for (int ch = 0; ch < MAX_CHANNELS; ++ch)
+        noiseState[ch] = static_cast<uint32_t>(noiseGenerator.nextInt()) | 1u;
 }
 
 void CEM3389Filter::processBlock(juce::AudioBuffer<float>& buffer)
 {
-    const int numChannels = buffer.getNumChannels();
+    const int numChannels = juce::jmin(buffer.getNumChannels(), MAX_CHANNELS);
     const int numSamples = buffer.getNumSamples();
     
-    // Update auto-modulation for living sound
-    updateAutoModulation();
-    updateFilterCoefficients();
+    if (numChannels == 0 || numSamples == 0)
+        return;
+    
+    const auto quality = processingQuality.load();
+    const bool oversample = quality == ProcessingQuality::Render
+                         && oversampler != nullptr
+                         && numChannels <= oversampledChannels;
+    
+    // Coefficients follow the rate the filter actually runs at
+    const double targetRate = oversample ? currentSampleRate * 2.0 : currentSampleRate;
+    if (processingSampleRate != targetRate)
+    {
+        processingSampleRate = targetRate;
+        updateFilterCoefficients();
+        
+        // Don't replay whatever the oversampler held from the last Render stretch
+        if (oversample)
+            oversampler->reset();
+    }
+    
+    if (!oversample)
+    {
+        processFilterBlock(buffer, quality == ProcessingQuality::Eco);
+        return;
+    }
+    
+    juce::dsp::AudioBlock<float> block(buffer);
+    auto upsampled = oversampler->processSamplesUp(block.getSubsetChannelBlock(0, static_cast<size_t>(numChannels)));
+    
+    float* upsampledChannels[MAX_CHANNELS] = {};
+    for (int channel = 0; channel < numChannels; ++channel)
+        upsampledChannels[channel] = upsampled.getChannelPointer(static_cast<size_t>(channel));
+    
+    juce::AudioBuffer<float> upsampledBuffer(upsampledChannels, numChannels, static_cast<int>(upsampled.getNumSamples()));
+    processFilterBlock(upsampledBuffer, false);
+    
+    auto outputBlock = block.getSubsetChannelBlock(0, static_cast<size_t>(numChannels));
+    oversampler->processSamplesDown(outputBlock);
+}
+
+void CEM3389Filter::processFilterBlock(juce::AudioBuffer<float>& buffer, bool lightweight)
+{
+    const int numChannels = juce::jmin(buffer.getNumChannels(), MAX_CHANNELS);
+    const int numSamples = buffer.getNumSamples();
+    
+    // Coefficients glide from where the last block ended to this block's target
+    const auto startCoeffs = coefficients;
+    updateAutoModulation(numSamples);
+    const auto endCoeffs = calculateCoefficients();
+    
+#if JUCE_USE_SIMD
+    // Snapshot parameters once per block
+    const float saturation = saturationAmount.load();
+    const int lanes = static_cast<int>(juce::dsp::SIMDRegister<float>::size());
+    
+    // Pack channels into SIMD lanes (stereo shares a single register)
+    for (int firstChannel = 0; firstChannel < numChannels; firstChannel += lanes)
+    {
+        processChannelGroup(buffer, firstChannel, juce::jmin(lanes, numChannels - firstChannel),
+                            startCoeffs, endCoeffs, saturation, lightweight);
+    }
+    
+    coefficients = endCoeffs;
+#else
+    juce::ignoreUnused(startCoeffs, lightweight);
+    coefficients = endCoeffs;
     
-    // Process each channel
-    for (int channel = 0; channel < numChannels && channel < MAX_CHANNELS; ++channel)
+    for (int channel = 0; channel < numChannels; ++channel)
     {
         auto* channelData = buffer.getWritePointer(channel);
         
@@ -72,6 +162,7 @@ void CEM3389Filter::processBlock(juce::AudioBuffer<float>& buffer)
             channelData[sample] = processSample(channelData[sample], channel);
         }
     }
+#endif
 }
 
 float CEM3389Filter::processSample(float input, int channel)
@@ -88,12 +179,10 @@ float CEM3389Filter::processSample(float input, int channel)
     // Stage 2: CEM3389 Filter Processing
     //==============================================================================
     
-    // Calculate dynamic resonance based on input level
-    float currentResonance = calculateNonLinearResonance(resonanceAmount.load(), processedInput);
-    
     // Apply biquad filter (CEM3389 lowpass characteristic)
-    float filteredOutput = b0 * processedInput + b1 * x1[channel] + b2 * x2[channel]
-                          - a1 * y1[channel] - a2 * y2[channel];
+    const auto& c = coefficients;
+    float filteredOutput = c.b0 * processedInput + c.b1 * x1[channel] + c.b2 * x2[channel]
+                          - c.a1 * y1[channel] - c.a2 * y2[channel];
     
     // Update delay lines
     x2[channel] = x1[channel];
@@ -187,6 +276,11 @@ void CEM3389Filter::updateFromPaintData(float pressure, float velocity, juce::Co
 //==============================================================================
 
 void CEM3389Filter::updateFilterCoefficients()
+{
+    coefficients = calculateCoefficients();
+}
+
+CEM3389Filter::BiquadCoefficients CEM3389Filter::calculateCoefficients() const
 {
     float freq = cutoffFreq.load();
     float q = resonanceAmount.load();
@@ -199,10 +293,10 @@ void CEM3389Filter::updateFilterCoefficients()
     }
     
     // Clamp frequency to valid range
-    freq = juce::jlimit(20.0f, static_cast<float>(currentSampleRate * 0.45), freq);
+    freq = juce::jlimit(20.0f, static_cast<float>(processingSampleRate * 0.45), freq);
     
     // Calculate biquad coefficients for CEM3389-style lowpass
-    float omega = 2.0f * juce::MathConstants<float>::pi * freq / static_cast<float>(currentSampleRate);
+    float omega = 2.0f * juce::MathConstants<float>::pi * freq / static_cast<float>(processingSampleRate);
     float cosOmega = std::cos(omega);
     float sinOmega = std::sin(omega);
     
@@ -212,13 +306,16 @@ void CEM3389Filter::updateFilterCoefficients()
     
     // Lowpass biquad coefficients
     float a0_temp = 1.0f + alpha;
-    a0 = 1.0f;
-    a1 = (-2.0f * cosOmega) / a0_temp;
-    a2 = (1.0f - alpha) / a0_temp;
     
-    b0 = ((1.0f - cosOmega) / 2.0f) / a0_temp;
-    b1 = (1.0f - cosOmega) / a0_temp;
-    b2 = ((1.0f - cosOmega) / 2.0f) / a0_temp;
+    BiquadCoefficients c;
+    c.a1 = (-2.0f * cosOmega) / a0_temp;
+    c.a2 = (1.0f - alpha) / a0_temp;
+    
+    c.b0 = ((1.0f - cosOmega) / 2.0f) / a0_temp;
+    c.b1 = (1.0f - cosOmega) / a0_temp;
+    c.b2 = ((1.0f - cosOmega) / 2.0f) / a0_temp;
+    
+    return c;
 }
 
 float CEM3389Filter::applySaturation(float input, float amount)
@@ -243,31 +340,21 @@ float CEM3389Filter::applyAnalogNoise(float input)
     return input + noise;
 }
 
-void CEM3389Filter::updateAutoModulation()
+void CEM3389Filter::updateAutoModulation(int numSamples)
 {
     if (!autoModulationEnabled) return;
     
-    // Update LFO phase for cutoff modulation
-    float phaseIncrement = modulationRate * 2.0f * juce::MathConstants<float>::pi / static_cast<float>(currentSampleRate);
-    modulationPhase += phaseIncrement;
+    // Advance LFO phase by the whole block so the rate is in real Hz
+    float phaseIncrement = modulationRate * 2.0f * juce::MathConstants<float>::pi / static_cast<float>(processingSampleRate);
+    modulationPhase += phaseIncrement * static_cast<float>(numSamples);
     
-    if (modulationPhase >= 2.0f * juce::MathConstants<float>::pi)
-        modulationPhase -= 2.0f * juce::MathConstants<float>::pi;
+    modulationPhase = std::fmod(modulationPhase, 2.0f * juce::MathConstants<float>::pi);
 }
 
 //==============================================================================
 // CEM3389-Specific Character
 //==============================================================================
 
-float CEM3389Filter::calculateNonLinearResonance(float baseResonance, float input)
-{
-    // CEM3389 resonance increases with input level (creates character)
-    float inputLevel = std::abs(input);
-    float nonLinearBoost = inputLevel * 0.2f;  // Subtle boost
-    
-    return juce::jlimit(0.0f, 1.0f, baseResonance + nonLinearBoost);
-}
-
 float CEM3389Filter::applyFilterCharacter(float filteredSample, float input)
 {
     // CEM3389 has distinctive output stage character
@@ -281,4 +368,195 @@ float CEM3389Filter::applyFilterCharacter(float filteredSample, float input)
     character = std::tanh(character * 0.9f) * 1.1f;
     
     return character;
-}
\ No newline at end of file
+}
+
+//==============================================================================
+// SIMD Block Path
+//==============================================================================
+
+#if JUCE_USE_SIMD
+
+namespace
+{
+    using FloatVec = juce::dsp::SIMDRegister<float>;
+    
+    // Odd polynomial fit of tanh on [-2.5, 2.5] (max error ~0.0025), clamped outside
+    inline FloatVec fastTanh(FloatVec x) noexcept
+    {
+        x = FloatVec::min(FloatVec::max(x, FloatVec::expand(-2.5f)), FloatVec::expand(2.5f));
+        const auto x2 = x * x;
+        
+        auto p = x2 * -0.00012011216f + 0.0024979785f;
+        p = p * x2 - 0.021295830f;
+        p = p * x2 + 0.10053100f;
+        p = p * x2 - 0.32004918f;
+        p = p * x2 + 1.0f;
+        
+        return x * p;
+    }
+    
+    // Odd polynomial fit of sin(pi * x) on [-1, 1] (max error ~0.0007); the phase is first
+    // wrapped into [-1, 1) so the result stays periodic (exact for |x| < 2048)
+    inline FloatVec fastSinPi(FloatVec x) noexcept
+    {
+        // round(x / 2) via an offset floor, since SIMDRegister only truncates towards zero
+        const auto cycles = FloatVec::truncate(x * 0.5f + 1024.5f) - 1024.0f;
+        x = x - cycles * 2.0f;
+        const auto x2 = x * x;
+        
+        auto p = x2 * -0.44615409f + 2.4476300f;
+        p = p * x2 - 5.1419970f;
+        p = p * x2 + 3.1398621f;
+        
+        return x * p;
+    }
+    
+    // Vectorised twin of applySaturation()
+    inline FloatVec saturate(FloatVec input, float amount) noexcept
+    {
+        if (amount <= 0.0f) return input;
+        
+        const float drive = (1.0f + amount * 3.0f) * 0.7f;
+        const auto saturated = fastTanh(input * drive) * 1.4f;
+        
+        return input + (saturated - input) * amount;
+    }
+    
+    // Vectorised twin of applyFilterCharacter()
+    inline FloatVec filterCharacter(FloatVec filtered) noexcept
+    {
+        const auto character = filtered + fastSinPi(filtered) * 0.05f;
+        return fastTanh(character * 0.9f) * 1.1f;
+    }
+    
+    // Cheap uniform noise in [-1, 1) from a 32-bit LCG (mantissa bit trick, no division)
+    inline float nextNoise(uint32_t& state) noexcept
+    {
+        state = state * 1664525u + 1013904223u;
+        
+        const uint32_t bits = (state >> 9) | 0x3f800000u;
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        
+        return value * 2.0f - 3.0f;
+    }
+}
+
+void CEM3389Filter::processChannelGroup(juce::AudioBuffer<float>& buffer, int firstChannel, int numGroupChannels,
+                                        const BiquadCoefficients& startCoeffs, const BiquadCoefficients& endCoeffs,
+                                        float saturation, bool lightweight)
+{
+    constexpr int maxLanes = MAX_CHANNELS;
+    const int lanes = static_cast<int>(FloatVec::size());
+    const int numSamples = buffer.getNumSamples();
+    
+    const float inputDrive = saturation * 0.5f;
+    const float outputDrive = saturation * 0.3f;
+    const float noiseLevel = analogNoise * 0.001f;
+    
+    // Interleaved scratch: one register's worth of lanes per sample
+    alignas(FloatVec::SIMDRegisterSize) float frames[COEFF_SUB_BLOCK * maxLanes] = {};
+    alignas(FloatVec::SIMDRegisterSize) float noise[COEFF_SUB_BLOCK * maxLanes] = {};
+    
+    // Load filter state into lanes (unused lanes stay silent)
+    auto x1v = FloatVec::expand(0.0f), x2v = FloatVec::expand(0.0f);
+    auto y1v = FloatVec::expand(0.0f), y2v = FloatVec::expand(0.0f);
+    
+    for (int lane = 0; lane < numGroupChannels; ++lane)
+    {
+        const int ch = firstChannel + lane;
+        x1v.set(static_cast<size_t>(lane), x1[ch]);
+        x2v.set(static_cast<size_t>(lane), x2[ch]);
+        y1v.set(static_cast<size_t>(lane), y1[ch]);
+        y2v.set(static_cast<size_t>(lane), y2[ch]);
+    }
+    
+    for (int start = 0; start < numSamples; start += COEFF_SUB_BLOCK)
+    {
+        const int count = juce::jmin(COEFF_SUB_BLOCK, numSamples - start);
+        
+        // Interpolate coefficients at sub-block rate
+        const float t = static_cast<float>(start + count) / static_cast<float>(numSamples);
+        const auto b0v = FloatVec::expand(startCoeffs.b0 + (endCoeffs.b0 - startCoeffs.b0) * t);
+        const auto b1v = FloatVec::expand(startCoeffs.b1 + (endCoeffs.b1 - startCoeffs.b1) * t);
+        const auto b2v = FloatVec::expand(startCoeffs.b2 + (endCoeffs.b2 - startCoeffs.b2) * t);
+        const auto a1v = FloatVec::expand(startCoeffs.a1 + (endCoeffs.a1 - startCoeffs.a1) * t);
+        const auto a2v = FloatVec::expand(startCoeffs.a2 + (endCoeffs.a2 - startCoeffs.a2) * t);
+        
+        // Gather channels and noise into interleaved frames
+        for (int lane = 0; lane < numGroupChannels; ++lane)
+        {
+            const auto* src = buffer.getReadPointer(firstChannel + lane, start);
+            auto& state = noiseState[firstChannel + lane];
+            
+            for (int i = 0; i < count; ++i)
+                frames[i * lanes + lane] = src[i];
+            
+            if (!lightweight)
+            {
+                for (int i = 0; i < count; ++i)
+                    noise[i * lanes + lane] = nextNoise(state) * noiseLevel;
+            }
+        }
+        
+        if (lightweight)
+        {
+            // Eco: biquad plus the output tanh only (no input stage, harmonics or noise)
+            for (int i = 0; i < count; ++i)
+            {
+                const auto input = FloatVec::fromRawArray(frames + i * lanes);
+                const auto filtered = b0v * input + b1v * x1v + b2v * x2v - a1v * y1v - a2v * y2v;
+                
+                x2v = x1v;
+                x1v = input;
+                y2v = y1v;
+                y1v = filtered;
+                
+                (fastTanh(filtered * 0.9f) * 1.1f).copyToRawArray(frames + i * lanes);
+            }
+        }
+        else
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                // Stage 1: Pre-filter saturation
+                const auto input = saturate(FloatVec::fromRawArray(frames + i * lanes), inputDrive);
+                
+                // Stage 2: CEM3389 biquad
+                const auto filtered = b0v * input + b1v * x1v + b2v * x2v - a1v * y1v - a2v * y2v;
+                
+                x2v = x1v;
+                x1v = input;
+                y2v = y1v;
+                y1v = filtered;
+                
+                // Stages 3 & 4: Output stage character, saturation and noise
+                const auto output = saturate(filterCharacter(filtered), outputDrive)
+                                  + FloatVec::fromRawArray(noise + i * lanes);
+                
+                output.copyToRawArray(frames + i * lanes);
+            }
+        }
+        
+        // Scatter frames back to the channels
+        for (int lane = 0; lane < numGroupChannels; ++lane)
+        {
+            auto* dest = buffer.getWritePointer(firstChannel + lane, start);
+            
+            for (int i = 0; i < count; ++i)
+                dest[i] = frames[i * lanes + lane];
+        }
+    }
+    
+    // Store filter state back for the next block / processSample()
+    for (int lane = 0; lane < numGroupChannels; ++lane)
+    {
+        const int ch = firstChannel + lane;
+        x1[ch] = x1v.get(static_cast<size_t>(lane));
+        x2[ch] = x2v.get(static_cast<size_t>(lane));
+        y1[ch] = y1v.get(static_cast<size_t>(lane));
+        y2[ch] = y2v.get(static_cast<size_t>(lane));
+    }
+}
+
+#endif // JUCE_USE_SIMD
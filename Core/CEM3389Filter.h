@@ -18,6 +18,7 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "ProcessingQuality.h"
 #include <cmath>
 
 /**
@@ -37,6 +38,7 @@ public:
     // Audio Processing
     
     void setSampleRate(double sampleRate);
+    void prepare(double sampleRate, int maxBlockSize, int numChannels);
     void reset();
     void processBlock(juce::AudioBuffer<float>& buffer);
     float processSample(float input, int channel = 0);
@@ -60,15 +62,34 @@ public:
     
     void updateFromPaintData(float pressure, float velocity, juce::Colour color);
     
+    //==============================================================================
+    // Quality Tier (Eco: lighter output stage, Render: 2x oversampled)
+    
+    void setProcessingQuality(ProcessingQuality quality) { processingQuality.store(quality); }
+    ProcessingQuality getProcessingQuality() const { return processingQuality.load(); }
+    
+    // Delay the tier adds to the output (the Render oversampler's filters)
+    int getLatencySamples(ProcessingQuality quality) const;
+    
 private:
     //==============================================================================
     // Filter State Variables
     
     double currentSampleRate = 44100.0;
+    double processingSampleRate = 44100.0;  // currentSampleRate x oversampling factor
+    
+    std::atomic<ProcessingQuality> processingQuality{ProcessingQuality::Live};
+    std::unique_ptr<juce::dsp::Oversampling<float>> oversampler;
+    int oversampledChannels = 0;
     
-    // Biquad filter coefficients
-    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;
-    float a0 = 1.0f, a1 = 0.0f, a2 = 0.0f;
+    // Biquad filter coefficients (normalised, a0 == 1)
+    struct BiquadCoefficients
+    {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;
+        float a1 = 0.0f, a2 = 0.0f;
+    };
+    
+    BiquadCoefficients coefficients;
     
     // Filter state (per channel)
     static constexpr int MAX_CHANNELS = 8;
@@ -98,6 +119,7 @@ private:
     float tubeWarmth = 0.15f;         // Subtle tube-style saturation
     float analogNoise = 0.02f;        // Very quiet analog noise
     juce::Random noiseGenerator;
+    uint32_t noiseState[MAX_CHANNELS] = {0};  // Per-lane LCG state for the block path
     
     //==============================================================================
     // Paint Integration State
@@ -110,14 +132,27 @@ private:
     // Internal Processing Methods
     
     void updateFilterCoefficients();
+    void processFilterBlock(juce::AudioBuffer<float>& buffer, bool lightweight);
+    BiquadCoefficients calculateCoefficients() const;
     float applySaturation(float input, float amount);
     float applyAnalogNoise(float input);
-    void updateAutoModulation();
+    void updateAutoModulation(int numSamples);
+    
+    //==============================================================================
+    // Block Path (channels packed into one SIMD register, coefficients
+    // interpolated every COEFF_SUB_BLOCK samples)
+    
+    static constexpr int COEFF_SUB_BLOCK = 16;
+    
+   #if JUCE_USE_SIMD
+    void processChannelGroup(juce::AudioBuffer<float>& buffer, int firstChannel, int numGroupChannels,
+                             const BiquadCoefficients& startCoeffs, const BiquadCoefficients& endCoeffs,
+                             float saturation, bool lightweight);
+   #endif
     
     //==============================================================================
     // CEM3389-Specific Character
     
-    float calculateNonLinearResonance(float baseResonance, float input);
     float applyFilterCharacter(float filteredSample, float input);
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CEM3389Filter)
@@ -6,10 +6,15 @@
 CanvasProcessor::CanvasProcessor()
 {
     // Pre-allocate the vector to its maximum size to avoid reallocations
-    oscillators.resize(maxPartials);
+    oscillators.resize(juce::jmax(maxPartials, MAX_PARTIAL_BANDS));
+
+    builderThread.startThread(juce::Thread::Priority::low);
 }
 
-CanvasProcessor::~CanvasProcessor() = default;
+CanvasProcessor::~CanvasProcessor()
+{
+    builderThread.stopThread(2000);
+}
 
 void CanvasProcessor::prepareToPlay(double sr, int samplesPerBlock)
 {
@@ -19,7 +24,8 @@ void CanvasProcessor::prepareToPlay(double sr, int samplesPerBlock)
 
     for (auto& osc : oscillators)
     {
-        osc.phase = 0.0f;
+        osc.setFrequency(osc.frequency, sampleRate);
+        osc.resetPhase();
         osc.amplitude = 0.0f;
         osc.targetAmplitude = 0.0f;
     }
@@ -27,7 +33,9 @@ void CanvasProcessor::prepareToPlay(double sr, int samplesPerBlock)
 
 void CanvasProcessor::processBlock(juce::AudioBuffer<float>& buffer)
 {
-    if (!isActive || !currentImage.isValid())
+    refreshPlaybackMatrix();
+
+    if (!isActive || playbackMatrix == nullptr || playbackMatrix->numColumns == 0)
     {
         buffer.clear();
         return;
@@ -36,9 +44,8 @@ void CanvasProcessor::processBlock(juce::AudioBuffer<float>& buffer)
     const int numSamples = buffer.getNumSamples();
     const int numChannels = buffer.getNumChannels();
 
-    // Update oscillator properties from the image column once per block
-    const int currentColumn = juce::jlimit(0, imageWidth - 1, static_cast<int>(playheadPos * imageWidth));
-    updateOscillatorsFromColumn(currentColumn);
+    // Update oscillator targets once per block, interpolating between the columns either side of the playhead
+    updateOscillatorsFromMatrix(playheadPos * static_cast<float>(playbackMatrix->numColumns - 1));
 
     // Get raw pointers to buffer channels for efficient writing
     auto* leftChannel = buffer.getWritePointer(0);
@@ -50,8 +57,10 @@ void CanvasProcessor::processBlock(juce::AudioBuffer<float>& buffer)
         float rightSample = 0.0f;
 
         // --- SINGLE-PASS RENDER LOOP ---
-        for (auto& osc : oscillators)
+        for (int i = 0; i < numActiveOscillators; ++i)
         {
+            auto& osc = oscillators[i];
+
             // Only process audible oscillators
             if (osc.targetAmplitude > 0.0001f || osc.amplitude > 0.0001f)
             {
@@ -71,7 +80,7 @@ void CanvasProcessor::processBlock(juce::AudioBuffer<float>& buffer)
                 }
 
                 // Advance phase for the next sample
-                osc.updatePhase(osc.frequency / sampleRate);
+                osc.advance();
             }
         }
 
@@ -86,66 +95,350 @@ void CanvasProcessor::processBlock(juce::AudioBuffer<float>& buffer)
             rightChannel[sample] = usePanning ? (rightSample * currentGain) : leftChannel[sample];
         }
     }
+
+    for (int i = 0; i < numActiveOscillators; ++i)
+        oscillators[i].normalise();
 }
 
 void CanvasProcessor::updateFromImage(const juce::Image& image)
 {
-    currentImage = image;
-    imageWidth = image.getWidth();
-    imageHeight = image.getHeight();
+    {
+        const juce::ScopedLock lock(matrixLock);
+        currentImage = image;
+        currentPlanes.reset();
+    }
 
-    // Reset all oscillators when a new image is loaded
-    for (auto& osc : oscillators)
+    // Oscillators are reset when the converted matrix reaches the audio thread
+    requestMatrixBuild(true);
+}
+
+void CanvasProcessor::updateFromPlanes(std::shared_ptr<const ImageImporter::Planes> planes)
+{
     {
-        osc.amplitude = 0.0f;
-        osc.targetAmplitude = 0.0f;
+        const juce::ScopedLock lock(matrixLock);
+        currentPlanes = std::move(planes);
+        currentImage = {};
     }
+
+    requestMatrixBuild(true);
 }
 
-void CanvasProcessor::updateOscillatorsFromColumn(int x)
+void CanvasProcessor::refreshPlaybackMatrix()
 {
-    if (!currentImage.isValid() || x < 0 || x >= imageWidth)
+    if (!matrixReady.load())
         return;
 
-    // Use jmax to prevent division by zero if image is tiny
-    const int step = juce::jmax(1, imageHeight / maxPartials);
-    int oscIndex = 0;
+    // Never wait on the builder - pick the matrix up next block if it's busy
+    const juce::ScopedTryLock lock(matrixLock);
+    if (!lock.isLocked())
+        return;
+
+    // The replaced matrix goes back to the builder thread to be freed
+    std::swap(playbackMatrix, pendingMatrix);
+    matrixReady.store(false);
+
+    // Partials the new layout dropped are still visited so they can fade out
+    const int previousRows = pendingMatrix != nullptr ? pendingMatrix->numRows : 0;
+    numActiveOscillators = juce::jmax(playbackMatrix->numRows, playbackMatrix->isNewImage ? 0 : previousRows);
+
+    const auto& matrix = *playbackMatrix;
+    for (int i = 0; i < static_cast<int>(oscillators.size()); ++i)
+    {
+        auto& osc = oscillators[i];
+
+        if (matrix.isNewImage)
+        {
+            osc.amplitude = 0.0f;
+            osc.targetAmplitude = 0.0f;
+        }
+
+        if (i < matrix.numRows)
+            osc.setFrequency(matrix.frequencies[i], sampleRate);
+        else
+            osc.targetAmplitude = 0.0f;
+    }
+}
+
+void CanvasProcessor::updateOscillatorsFromMatrix(float columnPosition)
+{
+    const auto& matrix = *playbackMatrix;
+
+    const int column0 = juce::jlimit(0, matrix.numColumns - 1, static_cast<int>(columnPosition));
+    const int column1 = juce::jmin(column0 + 1, matrix.numColumns - 1);
+    const float fraction = juce::jlimit(0.0f, 1.0f, columnPosition - static_cast<float>(column0));
+
+    const float* amplitudes0 = matrix.getAmplitudes(column0);
+    const float* amplitudes1 = matrix.getAmplitudes(column1);
+    const float* pans0 = matrix.getPans(column0);
+    const float* pans1 = matrix.getPans(column1);
+
+    for (int row = 0; row < matrix.numRows; ++row)
+    {
+        auto& osc = oscillators[row];
+        osc.targetAmplitude = amplitudes0[row] + (amplitudes1[row] - amplitudes0[row]) * fraction;
+        osc.pan = pans0[row] + (pans1[row] - pans0[row]) * fraction;
+    }
+}
+
+//==============================================================================
+// Background conversion
+
+void CanvasProcessor::requestMatrixBuild(bool isNewImage)
+{
+    {
+        const juce::ScopedLock lock(matrixLock);
+
+        // A queued image change must still reset the oscillators if a range change replaces it
+        const bool resetOscillators = isNewImage || (hasPendingRequest && pendingRequest.isNewImage);
+        pendingRequest = { currentImage, currentPlanes, minFreq, maxFreq, imageMapping, numPartialBands, resetOscillators };
+        hasPendingRequest = true;
+    }
+
+    builderThread.notify();
+}
+
+bool CanvasProcessor::processNextBuildRequest()
+{
+    BuildRequest request;
+    {
+        const juce::ScopedLock lock(matrixLock);
+        if (!hasPendingRequest)
+            return false;
+
+        request = pendingRequest;
+        hasPendingRequest = false;
+    }
+
+    auto matrix = buildMatrix(request);
+    if (matrix == nullptr)
+        return true;
+
+    std::unique_ptr<PartialMatrix> previous;
+    {
+        const juce::ScopedLock lock(matrixLock);
+
+        // An image change the audio thread never saw still needs its reset
+        if (matrixReady.load() && pendingMatrix != nullptr && pendingMatrix->isNewImage)
+            matrix->isNewImage = true;
+
+        previous = std::move(pendingMatrix);
+        pendingMatrix = std::move(matrix);
+        matrixReady.store(true);
+    }
+
+    return true;
+}
+
+std::vector<CanvasProcessor::RowBand> CanvasProcessor::createRowBands(const BuildRequest& request, int imageHeight) const
+{
+    std::vector<RowBand> bands;
+
+    if (request.mapping == ImageMapping::RowSampling)
+    {
+        // Use jmax to prevent division by zero if image is tiny
+        const int step = juce::jmax(1, imageHeight / maxPartials);
+        const int numRows = juce::jmin(maxPartials, (imageHeight + step - 1) / step);
+
+        for (int row = 0; row < numRows; ++row)
+        {
+            RowBand band;
+            band.samplePosition = static_cast<float>(row * step);
+            band.frequency = pixelYToFrequency(band.samplePosition, imageHeight, request.minFreq, request.maxFreq);
+            bands.push_back(band);
+        }
+
+        return bands;
+    }
+
+    // Rows are already log-spaced in frequency, so equal row spans are equal log bands.
+    // Each band's partial sits at its geometric centre frequency
+    const int numBands = juce::jlimit(1, MAX_PARTIAL_BANDS, request.numBands);
+    const float rowsPerBand = static_cast<float>(imageHeight) / static_cast<float>(numBands);
+
+    for (int i = 0; i < numBands; ++i)
+    {
+        RowBand band;
+        const float centre = (static_cast<float>(i) + 0.5f) * rowsPerBand;
+
+        // Bands narrower than a row interpolate instead of integrating
+        if (rowsPerBand >= 1.0f)
+        {
+            band.startRow = static_cast<float>(i) * rowsPerBand;
+            band.endRow = band.startRow + rowsPerBand;
+        }
+
+        band.samplePosition = juce::jmax(0.0f, centre - 0.5f);
+        band.frequency = pixelYToFrequency(centre, imageHeight, request.minFreq, request.maxFreq);
+        bands.push_back(band);
+    }
+
+    return bands;
+}
+
+std::unique_ptr<CanvasProcessor::PartialMatrix> CanvasProcessor::buildMatrix(const BuildRequest& request) const
+{
+    auto matrix = std::make_unique<PartialMatrix>();
+    matrix->isNewImage = request.isNewImage;
+
+    const auto& image = request.image;
+    const auto* planes = request.planes.get();
+    if (planes == nullptr && !image.isValid())
+        return matrix;
 
-    const bool isColor = currentImage.getFormat() != juce::Image::PixelFormat::SingleChannel;
+    const int width = planes != nullptr ? planes->numColumns : image.getWidth();
+    const int height = planes != nullptr ? planes->numRows : image.getHeight();
+    const auto bands = createRowBands(request, height);
+    const int numRows = static_cast<int>(bands.size());
 
+    matrix->numColumns = width;
+    matrix->numRows = numRows;
+    matrix->amplitudes.resize(static_cast<size_t>(width) * static_cast<size_t>(numRows));
+    matrix->pans.resize(matrix->amplitudes.size());
+    matrix->frequencies.resize(static_cast<size_t>(numRows));
 
-    for (int y = 0; y < imageHeight && oscIndex < maxPartials; y += step, ++oscIndex)
+    // Map Y-axis to frequency
+    for (int row = 0; row < numRows; ++row)
+        matrix->frequencies[row] = bands[row].frequency;
+
+    // Imported planes are read as they are; a plain image is decoded here
+    const bool isColor = planes == nullptr && image.getFormat() != juce::Image::PixelFormat::SingleChannel;
+    std::unique_ptr<juce::Image::BitmapData> pixels;
+    if (planes == nullptr)
+        pixels = std::make_unique<juce::Image::BitmapData>(image, juce::Image::BitmapData::readOnly);
+
+    // Each image column is decoded once, then reduced to the band layout
+    std::vector<float> decodedBrightness(planes == nullptr ? static_cast<size_t>(height) : 0);
+    std::vector<float> decodedHue(decodedBrightness.size(), 0.5f);
+
+    for (int x = 0; x < width; ++x)
     {
-        auto pixel = currentImage.getPixelAt(x, y);
-        auto& osc = oscillators[oscIndex];
+        if (builderThread.threadShouldExit())
+            return nullptr;
+
+        const float* brightness = decodedBrightness.data();
+        const float* hue = decodedHue.data();
 
-        // Map Y-axis to frequency
-        osc.frequency = pixelYToFrequency(y);
+        if (planes != nullptr)
+        {
+            brightness = planes->getBrightness(x);
+            hue = planes->getHue(x);
+        }
+        else
+        {
+            for (int y = 0; y < height; ++y)
+            {
+                const auto pixel = pixels->getPixelColour(x, y);
+                decodedBrightness[y] = pixel.getBrightness();
 
-        // Map brightness to target amplitude
-        osc.targetAmplitude = pixel.getBrightness();
+                // Hue only means something if the image is in color
+                if (isColor)
+                    decodedHue[y] = pixel.getHue();
+            }
+        }
+
+        float* amplitudes = matrix->amplitudes.data() + static_cast<size_t>(x) * static_cast<size_t>(numRows);
+        float* pans = matrix->pans.data() + static_cast<size_t>(x) * static_cast<size_t>(numRows);
+
+        for (int row = 0; row < numRows; ++row)
+        {
+            const auto& band = bands[row];
+
+            if (band.endRow > band.startRow)
+            {
+                // Power-average the covered rows (partial rows weighted by coverage),
+                // pan follows the brightness-weighted hue
+                float energy = 0.0f, coverage = 0.0f, panSum = 0.0f, panWeight = 0.0f;
+                const int lastRow = juce::jmin(height, static_cast<int>(std::ceil(band.endRow)));
 
-        // Map hue to pan only if the image is in color
-        osc.pan = isColor ? pixel.getHue() : 0.5f;
+                for (int y = static_cast<int>(band.startRow); y < lastRow; ++y)
+                {
+                    const float weight = juce::jmin(band.endRow, static_cast<float>(y + 1))
+                                       - juce::jmax(band.startRow, static_cast<float>(y));
+                    energy += weight * brightness[y] * brightness[y];
+                    coverage += weight;
+                    panSum += weight * brightness[y] * hue[y];
+                    panWeight += weight * brightness[y];
+                }
+
+                amplitudes[row] = coverage > 0.0f ? std::sqrt(energy / coverage) : 0.0f;
+                pans[row] = panWeight > 0.0f ? panSum / panWeight : 0.5f;
+            }
+            else
+            {
+                const int y0 = juce::jmin(height - 1, static_cast<int>(band.samplePosition));
+                const int y1 = juce::jmin(height - 1, y0 + 1);
+                const float fraction = band.samplePosition - static_cast<float>(y0);
+
+                amplitudes[row] = brightness[y0] + (brightness[y1] - brightness[y0]) * fraction;
+                pans[row] = hue[y0] + (hue[y1] - hue[y0]) * fraction;
+            }
+        }
     }
+
+    return matrix;
 }
 
-float CanvasProcessor::pixelYToFrequency(int y) const
+float CanvasProcessor::pixelYToFrequency(float y, int imageHeight, float minHz, float maxHz)
 {
     // Logarithmic mapping of pixel Y to frequency for a more musical result
     // Invert Y so that top of image is high frequency
-    const float normalisedY = 1.0f - (static_cast<float>(y) / static_cast<float>(imageHeight));
+    const float normalisedY = 1.0f - (y / static_cast<float>(imageHeight));
 
     // Convert linear (0-1) to logarithmic frequency scale
-    const float logMin = std::log(minFreq);
-    const float logMax = std::log(maxFreq);
+    const float logMin = std::log(minHz);
+    const float logMax = std::log(maxHz);
     return std::exp(logMin + normalisedY * (logMax - logMin));
 }
 
+void CanvasProcessor::MatrixBuilderThread::run()
+{
+    while (!threadShouldExit())
+    {
+        if (processor.processNextBuildRequest())
+            continue;
+
+        // Free the matrix the audio thread swapped out; poll until it has done so
+        bool awaitingSwap = false;
+        {
+            const juce::ScopedLock lock(processor.matrixLock);
+            if (processor.matrixReady.load())
+                awaitingSwap = true;
+            else
+                processor.pendingMatrix.reset();
+        }
+
+        wait(awaitingSwap ? 20 : -1);
+    }
+}
+
 void CanvasProcessor::setFrequencyRange(float minHz, float maxHz)
 {
     minFreq = juce::jlimit(20.0f, 20000.0f, minHz);
     maxFreq = juce::jlimit(minFreq, 22000.0f, maxHz);
+
+    // Only the frequency table changes, but the matrix is rebuilt as one unit
+    requestMatrixBuild(false);
+}
+
+void CanvasProcessor::setImageMapping(ImageMapping newMapping)
+{
+    if (newMapping == imageMapping)
+        return;
+
+    imageMapping = newMapping;
+    requestMatrixBuild(false);
+}
+
+void CanvasProcessor::setNumPartialBands(int numBands)
+{
+    numBands = juce::jlimit(1, MAX_PARTIAL_BANDS, numBands);
+    if (numBands == numPartialBands)
+        return;
+
+    numPartialBands = numBands;
+
+    if (imageMapping == ImageMapping::BandIntegration)
+        requestMatrixBuild(false);
 }
 
 void CanvasProcessor::setPlayheadPosition(float normalisedPosition)
@@ -1,9 +1,22 @@
     #pragma once
     #include <JuceHeader.h>
+    #include "ImageImporter.h"
+    #include <atomic>
+    #include <memory>
+    #include <vector>
 
     class CanvasProcessor
     {
     public:
+        // How image rows become partials
+        enum class ImageMapping
+        {
+            RowSampling,        // One partial per sampled row (every imageHeight / maxPartials rows)
+            BandIntegration     // Every row contributes to one of a set of log-spaced bands
+        };
+
+        static constexpr int MAX_PARTIAL_BANDS = 1024;
+
         CanvasProcessor();
         ~CanvasProcessor();
 
@@ -11,6 +24,12 @@
         void processBlock(juce::AudioBuffer<float>& buffer);
         void updateFromImage(const juce::Image& image);
 
+        // Already-converted planes from ImageImporter; skips the per-pixel decode
+        void updateFromPlanes(std::shared_ptr<const ImageImporter::Planes> planes);
+
+        // Audio thread: true once an image has been converted, even before it is swapped in
+        bool hasImage() const { return playbackMatrix != nullptr || matrixReady.load(); }
+
         // --- Control Methods ---
         void setActive(bool shouldBeActive) { isActive = shouldBeActive; }
         void setPlayheadPosition(float normalisedPosition);
@@ -18,43 +37,121 @@
         void setMasterGain(float gain) { masterGain.setTargetValue(gain); }
         void setAmplitudeScale(float scale) { amplitudeScale = scale; }
         void setUsePanning(bool shouldUsePanning) { usePanning = shouldUsePanning; }
+        void setImageMapping(ImageMapping newMapping);
+        void setNumPartialBands(int numBands);
 
     private:
-        // Nested struct for a single sine wave partial
+        // Image converted once, off the audio thread, into what the oscillators read:
+        // column-major amplitude and pan rows plus one frequency per row
+        struct PartialMatrix
+        {
+            int numColumns = 0;
+            int numRows = 0;
+            std::vector<float> amplitudes;   // [column * numRows + row]
+            std::vector<float> pans;         // [column * numRows + row]
+            std::vector<float> frequencies;  // [row]
+            bool isNewImage = true;          // Oscillators restart from silence when swapped in
+
+            const float* getAmplitudes(int column) const { return amplitudes.data() + (size_t)column * (size_t)numRows; }
+            const float* getPans(int column) const { return pans.data() + (size_t)column * (size_t)numRows; }
+        };
+
+        struct BuildRequest
+        {
+            juce::Image image;
+            std::shared_ptr<const ImageImporter::Planes> planes;   // Used instead of image when set
+            float minFreq = 20.0f;
+            float maxFreq = 20000.0f;
+            ImageMapping mapping = ImageMapping::RowSampling;
+            int numBands = 512;
+            bool isNewImage = true;
+        };
+
+        // Image rows feeding one partial, laid out once per build. An empty span
+        // samples the image at samplePosition (interpolating between rows)
+        struct RowBand
+        {
+            float startRow = 0.0f;
+            float endRow = 0.0f;
+            float samplePosition = 0.0f;
+            float frequency = 0.0f;
+        };
+
+        // Nested struct for a single sine wave partial. The sine comes from a rotating
+        // (sin, cos) pair, so a sample costs four multiplies instead of a std::sin call
         struct Partial
         {
             float frequency = 0.0f;
-            float phase = 0.0f;
             float amplitude = 0.0f;
             float targetAmplitude = 0.0f;
             float pan = 0.5f; // 0.0 = left, 0.5 = center, 1.0 = right
 
-            float getSample() const
+            float sinValue = 0.0f;
+            float cosValue = 1.0f;
+            float stepSin = 0.0f;   // Rotation per sample, set with the frequency
+            float stepCos = 1.0f;
+
+            void setFrequency(float newFrequency, float sampleRate)
+            {
+                frequency = newFrequency;
+                const float radiansPerSample = juce::MathConstants<float>::twoPi * frequency / sampleRate;
+                stepSin = std::sin(radiansPerSample);
+                stepCos = std::cos(radiansPerSample);
+            }
+
+            void resetPhase()
+            {
+                sinValue = 0.0f;
+                cosValue = 1.0f;
+            }
+
+            float getSample() const { return sinValue; }
+
+            void advance()
             {
-                return std::sin(phase * juce::MathConstants<float>::twoPi);
+                const float nextSin = sinValue * stepCos + cosValue * stepSin;
+                cosValue = cosValue * stepCos - sinValue * stepSin;
+                sinValue = nextSin;
             }
 
-            void updatePhase(float phaseIncrement)
+            // Rounding walks the pair off the unit circle; pulled back once per block
+            void normalise()
             {
-                phase += phaseIncrement;
-                if (phase >= 1.0f)
-                    phase -= 1.0f;
+                const float gain = 1.0f / std::sqrt(sinValue * sinValue + cosValue * cosValue);
+                sinValue *= gain;
+                cosValue *= gain;
             }
         };
 
         // Main DSP methods
-        void updateOscillatorsFromColumn(int x);
-        float pixelYToFrequency(int y) const;
+        void updateOscillatorsFromMatrix(float columnPosition);
+        void refreshPlaybackMatrix();
+
+        // Background conversion
+        void requestMatrixBuild(bool isNewImage);
+        bool processNextBuildRequest();
+        std::unique_ptr<PartialMatrix> buildMatrix(const BuildRequest& request) const;
+        std::vector<RowBand> createRowBands(const BuildRequest& request, int imageHeight) const;
+        static float pixelYToFrequency(float y, int imageHeight, float minHz, float maxHz);
 
         // Member Variables
         juce::Image currentImage;
+        std::shared_ptr<const ImageImporter::Planes> currentPlanes;
         std::vector<Partial> oscillators;
 
+        // Matrix hand-off: the builder fills pendingMatrix under matrixLock; the audio
+        // thread swaps it in with a try-lock and the builder frees what comes back
+        juce::CriticalSection matrixLock;
+        BuildRequest pendingRequest;
+        bool hasPendingRequest = false;
+        std::unique_ptr<PartialMatrix> pendingMatrix;
+        std::unique_ptr<PartialMatrix> playbackMatrix;
+        int numActiveOscillators = 0;
+        std::atomic<bool> matrixReady{ false };
+
         // Parameters
         float sampleRate = 44100.0f;
         float playheadPos = 0.0f;
-        int imageWidth = 0;
-        int imageHeight = 0;
 
         bool isActive = false;
         bool usePanning = true;
@@ -64,6 +161,22 @@
         float minFreq = 20.0f;
         float maxFreq = 20000.0f;
         float amplitudeScale = 1.0f; // Final scaling factor for amplitude
+        ImageMapping imageMapping = ImageMapping::RowSampling;
+        int numPartialBands = 512;
 
         juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> masterGain;
+
+        class MatrixBuilderThread : public juce::Thread
+        {
+        public:
+            explicit MatrixBuilderThread(CanvasProcessor& owner)
+                : juce::Thread("CanvasProcessor Matrix Builder"), processor(owner) {}
+
+            void run() override;
+
+        private:
+            CanvasProcessor& processor;
+        };
+
+        MatrixBuilderThread builderThread{ *this };
     };  
\ No newline at end of file
@@ -82,7 +82,8 @@ enum class RecordingCommandID
     StopRecording,
     ExportToFile,
     SetRecordingFormat,
-    SetRecordingDirectory
+    SetRecordingDirectory,
+    ExportToFiles           // stringParam = base path, intParam = AudioRecorder format bit mask
 };
 
 // FIFO message object ---------------------------------------------------------
@@ -6,9 +6,14 @@ ForgeProcessor::ForgeProcessor()
 {
     formatManager.registerBasicFormats();
     // voices[] already default-constructed in std::array – no push_back / clear
+
+    overviewThread.startThread(juce::Thread::Priority::low);
 }
 
-ForgeProcessor::~ForgeProcessor() = default;
+ForgeProcessor::~ForgeProcessor()
+{
+    overviewThread.stopThread(2000);
+}
 
 //------------------------------------------------------------------------------
 void ForgeProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
@@ -36,11 +41,85 @@ void ForgeProcessor::loadSampleIntoSlot(int slotIdx, const juce::File& file)
         juce::AudioBuffer<float> tmp((int)r->numChannels,
             (int)r->lengthInSamples);
         r->read(&tmp, 0, tmp.getNumSamples(), 0, true, true);
+        requestWaveformOverview(slotIdx, tmp, r->sampleRate);
         voices[(size_t)slotIdx].setSample(std::move(tmp), 120.0);
         delete r;
     }
 }
 
+//------------------------------------------------------------------------------
+std::shared_ptr<const WaveformOverview> ForgeProcessor::getWaveformOverview(int slotIdx) const
+{
+    if (slotIdx < 0 || slotIdx >= (int)overviews.size())
+        return nullptr;
+
+    const juce::ScopedLock lock(overviewLock);
+
+    // the stored overview no longer matches the voice's sample after a newer load
+    if (overviewBuiltGenerations[(size_t)slotIdx] != overviewGenerations[(size_t)slotIdx].load())
+        return nullptr;
+
+    return overviews[(size_t)slotIdx];
+}
+
+// Called from the command path on the audio thread: wait-free apart from the
+// copy of the samples, which is no worse than the decode that precedes it
+void ForgeProcessor::requestWaveformOverview(int slotIdx, const juce::AudioBuffer<float>& sample,
+                                             double sampleRate)
+{
+    const auto generation = overviewGenerations[(size_t)slotIdx].fetch_add(1) + 1;
+
+    // Queue full - the slot shows no overview rather than blocking the caller
+    if (overviewFifo.getFreeSpace() == 0)
+        return;
+
+    int start1, size1, start2, size2;
+    overviewFifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    auto& job = overviewJobs[(size_t)(size1 > 0 ? start1 : start2)];
+    job.slotIdx = slotIdx;
+    job.generation = generation;
+    job.sampleRate = sampleRate;
+    job.source = std::make_unique<juce::AudioBuffer<float>>(sample);
+
+    overviewFifo.finishedWrite(1);
+    overviewThread.notify();
+}
+
+bool ForgeProcessor::processNextOverviewJob()
+{
+    if (overviewFifo.getNumReady() == 0)
+        return false;
+
+    int start1, size1, start2, size2;
+    overviewFifo.prepareToRead(1, start1, size1, start2, size2);
+
+    // Take ownership so the samples are freed here, never on the loading thread
+    auto job = std::move(overviewJobs[(size_t)(size1 > 0 ? start1 : start2)]);
+    overviewFifo.finishedRead(1);
+
+    const auto slot = (size_t)job.slotIdx;
+    if (job.generation != overviewGenerations[slot].load())
+        return true;                            // superseded by a later load
+
+    auto overview = WaveformOverview::createFromBuffer(*job.source, job.sampleRate);
+
+    const juce::ScopedLock lock(overviewLock);
+    overviews[slot] = std::move(overview);
+    overviewBuiltGenerations[slot] = job.generation;
+
+    return true;
+}
+
+void ForgeProcessor::OverviewThread::run()
+{
+    while (!threadShouldExit())
+    {
+        if (!processor.processNextOverviewJob())
+            wait(-1);
+    }
+}
+
 //------------------------------------------------------------------------------
 ForgeVoice& ForgeProcessor::getVoice(int index)
 {
@@ -1,7 +1,10 @@
 ﻿#pragma once
 #include <JuceHeader.h>
 #include <array>
+#include <atomic>
+#include <memory>
 #include "ForgeVoice.h"
+#include "WaveformOverview.h"
 #include "Core/Commands.h"
 
 //==============================================================================
@@ -21,10 +24,55 @@ public:
     ForgeVoice& getVoice(int index);
     void        setHostBPM(double bpm);
 
+    // display summary of the slot's sample, or nullptr while it is being built
+    std::shared_ptr<const WaveformOverview> getWaveformOverview(int slotIdx) const;
+
 private:
     std::array<ForgeVoice, 8> voices;           // fixed-size, copy-safe
     juce::AudioFormatManager  formatManager;
     float                     hostBPM = 120.0f;
 
+    //==============================================================================
+    // Waveform overviews
+    //
+    // Each load hands a copy of the decoded sample to a background thread through
+    // a single-producer ring, so the loading thread never blocks or re-reads the
+    // file. A newer load for the same slot bumps its generation, which hides the
+    // old overview at once and makes the thread discard stale jobs.
+
+    struct OverviewJob
+    {
+        int          slotIdx = -1;
+        juce::uint32 generation = 0;
+        double       sampleRate = 44100.0;
+        std::unique_ptr<juce::AudioBuffer<float>> source;
+    };
+
+    static constexpr int OVERVIEW_QUEUE_SIZE = 32;
+
+    juce::AbstractFifo overviewFifo{ OVERVIEW_QUEUE_SIZE };
+    std::array<OverviewJob, OVERVIEW_QUEUE_SIZE> overviewJobs;
+    std::array<std::atomic<juce::uint32>, 8> overviewGenerations{};
+
+    juce::CriticalSection overviewLock;         // guards overviews between the builder and readers
+    std::array<std::shared_ptr<const WaveformOverview>, 8> overviews;
+    std::array<juce::uint32, 8> overviewBuiltGenerations{};
+
+    void requestWaveformOverview(int slotIdx, const juce::AudioBuffer<float>& sample, double sampleRate);
+    bool processNextOverviewJob();
+
+    class OverviewThread : public juce::Thread
+    {
+    public:
+        explicit OverviewThread(ForgeProcessor& owner)
+            : juce::Thread("Forge Waveform Overview"), processor(owner) {}
+        void run() override;
+
+    private:
+        ForgeProcessor& processor;
+    };
+
+    OverviewThread overviewThread{ *this };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ForgeProcessor)
 };
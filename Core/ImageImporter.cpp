@@ -0,0 +1,167 @@
+#include "ImageImporter.h"
+#include <cmath>
+
+//==============================================================================
+// Message Thread
+
+void ImageImporter::startImport(const juce::File& file, int targetColumns, int targetRows)
+{
+    Job job;
+    job.file = file;
+    job.columns = juce::jmax(1, targetColumns);
+    job.rows = juce::jmax(1, targetRows);
+    importJob.start(job);
+}
+
+void ImageImporter::cancel()
+{
+    importJob.cancel();
+}
+
+//==============================================================================
+// Import Thread
+
+std::shared_ptr<ImageImporter::Result> ImageImporter::importImage(const Job& job)
+{
+    const auto source = juce::ImageFileFormat::loadFrom(job.file);
+    if (!source.isValid() || importJob.isCancelled(job))
+        return nullptr;
+    
+    // Decoding gives no progress of its own; count it as the first tenth
+    constexpr float decodeShare = 0.1f;
+    importJob.setProgress(decodeShare);
+    
+    auto result = std::make_shared<Result>();
+    result->sourceFile = job.file;
+    result->image = juce::Image(juce::Image::ARGB, job.columns, job.rows, false, juce::SoftwareImageType());
+    
+    auto planes = std::make_shared<Planes>();
+    planes->numColumns = job.columns;
+    planes->numRows = job.rows;
+    planes->hasColour = source.getFormat() != juce::Image::SingleChannel;
+    planes->brightness.resize((size_t)job.columns * (size_t)job.rows);
+    planes->hue.resize(planes->brightness.size(), 0.5f);
+    
+    const auto columnFootprints = createFootprints(source.getWidth(), job.columns);
+    const auto rowFootprints = createFootprints(source.getHeight(), job.rows);
+    
+    {
+        const juce::Image::BitmapData sourcePixels(source, juce::Image::BitmapData::readOnly);
+        juce::Image::BitmapData destinationPixels(result->image, juce::Image::BitmapData::writeOnly);
+        
+        // Stripes write disjoint rows of the image and planes, so they need no locking
+        const int numStripes = (job.rows + ROWS_PER_STRIPE - 1) / ROWS_PER_STRIPE;
+        std::atomic<int> stripesLeft{numStripes};
+        juce::WaitableEvent stripesDone;
+        
+        for (int stripe = 0; stripe < numStripes; ++stripe)
+        {
+            importJob.getPool().addJob([&, stripe]
+            {
+                const int firstRow = stripe * ROWS_PER_STRIPE;
+                resampleStripe(sourcePixels, destinationPixels, *planes, columnFootprints, rowFootprints,
+                               firstRow, juce::jmin(job.rows, firstRow + ROWS_PER_STRIPE), job);
+                
+                const int left = --stripesLeft;
+                if (!importJob.isCancelled(job))
+                    importJob.setProgress(decodeShare + (1.0f - decodeShare) * (float)(numStripes - left) / (float)numStripes);
+                
+                if (left == 0)
+                    stripesDone.signal();
+            });
+        }
+        
+        stripesDone.wait(-1);
+    }
+    
+    if (importJob.isCancelled(job))
+        return nullptr;
+    
+    result->planes = std::move(planes);
+    return result;
+}
+
+//==============================================================================
+// Resampling
+
+std::vector<ImageImporter::Footprint> ImageImporter::createFootprints(int sourceSize, int targetSize)
+{
+    std::vector<Footprint> footprints((size_t)targetSize);
+    const float scale = (float)sourceSize / (float)targetSize;
+    
+    for (int i = 0; i < targetSize; ++i)
+    {
+        auto& footprint = footprints[(size_t)i];
+        
+        if (scale >= 1.0f)
+        {
+            // Downsampling: average everything the target pixel covers
+            footprint.start = (float)i * scale;
+            footprint.end = juce::jmin((float)sourceSize, footprint.start + scale);
+        }
+        else
+        {
+            // Upsampling: a one-pixel box around the sample point blends the two nearest pixels
+            const float centre = ((float)i + 0.5f) * scale;
+            footprint.start = juce::jlimit(0.0f, (float)sourceSize - 1.0f, centre - 0.5f);
+            footprint.end = footprint.start + 1.0f;
+        }
+    }
+    
+    return footprints;
+}
+
+void ImageImporter::resampleStripe(const juce::Image::BitmapData& source, juce::Image::BitmapData& destination,
+                                   Planes& planes, const std::vector<Footprint>& columnFootprints,
+                                   const std::vector<Footprint>& rowFootprints, int firstRow, int endRow,
+                                   const Job& job) const
+{
+    const int numColumns = planes.numColumns;
+    const int numRows = planes.numRows;
+    
+    for (int row = firstRow; row < endRow; ++row)
+    {
+        if (importJob.isCancelled(job))
+            return;
+        
+        const auto& rowSpan = rowFootprints[(size_t)row];
+        const int firstSourceRow = (int)rowSpan.start;
+        const int endSourceRow = juce::jmin(source.height, (int)std::ceil(rowSpan.end));
+        
+        for (int column = 0; column < numColumns; ++column)
+        {
+            const auto& columnSpan = columnFootprints[(size_t)column];
+            const int firstSourceColumn = (int)columnSpan.start;
+            const int endSourceColumn = juce::jmin(source.width, (int)std::ceil(columnSpan.end));
+            
+            float red = 0.0f, green = 0.0f, blue = 0.0f, alpha = 0.0f, totalWeight = 0.0f;
+            
+            for (int y = firstSourceRow; y < endSourceRow; ++y)
+            {
+                const float rowWeight = juce::jmin(rowSpan.end, (float)(y + 1)) - juce::jmax(rowSpan.start, (float)y);
+                
+                for (int x = firstSourceColumn; x < endSourceColumn; ++x)
+                {
+                    const float weight = rowWeight * (juce::jmin(columnSpan.end, (float)(x + 1))
+                                                      - juce::jmax(columnSpan.start, (float)x));
+                    const auto pixel = source.getPixelColour(x, y);
+                    
+                    red += weight * pixel.getFloatRed();
+                    green += weight * pixel.getFloatGreen();
+                    blue += weight * pixel.getFloatBlue();
+                    alpha += weight * pixel.getFloatAlpha();
+                    totalWeight += weight;
+                }
+            }
+            
+            const float scale = totalWeight > 0.0f ? 1.0f / totalWeight : 0.0f;
+            const auto colour = juce::Colour::fromFloatRGBA(red * scale, green * scale, blue * scale, alpha * scale);
+            destination.setPixelColour(column, row, colour);
+            
+            const size_t index = (size_t)column * (size_t)numRows + (size_t)row;
+            planes.brightness[index] = colour.getBrightness();
+            if (planes.hasColour)
+                planes.hue[index] = colour.getHue();
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "BackgroundJob.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * ImageImporter - Background image import for the canvas
+ *
+ * Decodes an image file on a worker thread, resamples it to the canvas
+ * time x frequency grid with an area (box) filter, split into row stripes
+ * that run in parallel, and converts the result to float brightness/hue
+ * planes that the synthesis engines read directly.
+ *
+ * The message thread starts imports, polls progress and picks up the
+ * finished result; a new import or cancel() abandons the running one.
+ */
+class ImageImporter
+{
+public:
+    // Column-major float planes: one column per time step, one row per frequency row
+    struct Planes
+    {
+        int numColumns = 0;
+        int numRows = 0;
+        bool hasColour = true;
+        std::vector<float> brightness;   // [column * numRows + row]
+        std::vector<float> hue;          // [column * numRows + row]
+        
+        const float* getBrightness(int column) const { return brightness.data() + (size_t)column * (size_t)numRows; }
+        const float* getHue(int column) const { return hue.data() + (size_t)column * (size_t)numRows; }
+    };
+    
+    struct Result
+    {
+        juce::File sourceFile;
+        juce::Image image;                       // Resampled image, for display
+        std::shared_ptr<const Planes> planes;
+    };
+    
+    //==============================================================================
+    // Message thread
+    
+    void startImport(const juce::File& file, int targetColumns, int targetRows);
+    void cancel();
+    
+    bool isImporting() const { return importJob.isBusy(); }
+    float getProgress() const { return importJob.getProgress(); }
+    
+    // Finished import, handed over once; nullptr until then
+    std::shared_ptr<const Result> takeResult() { return importJob.takeResult(); }
+
+private:
+    static constexpr int ROWS_PER_STRIPE = 16;
+    
+    struct Job
+    {
+        juce::File file;
+        int columns = 0;
+        int rows = 0;
+        juce::uint32 generation = 0;
+    };
+    
+    // Source span covered by one target pixel along an axis
+    struct Footprint
+    {
+        float start = 0.0f;
+        float end = 0.0f;
+    };
+    
+    std::shared_ptr<Result> importImage(const Job& job);
+    void resampleStripe(const juce::Image::BitmapData& source, juce::Image::BitmapData& destination,
+                        Planes& planes, const std::vector<Footprint>& columnFootprints,
+                        const std::vector<Footprint>& rowFootprints, int firstRow, int endRow,
+                        const Job& job) const;
+    
+    static std::vector<Footprint> createFootprints(int sourceSize, int targetSize);
+    
+    BackgroundJob<Job, Result> importJob{ "Image Import", [this](const Job& job) { return importImage(job); } };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ImageImporter)
+};
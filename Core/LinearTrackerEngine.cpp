@@ -1,6 +1,7 @@
 #include "LinearTrackerEngine.h"
 #include <cmath>
 #include <algorithm>
+#include <limits>
 
 //==============================================================================
 LinearTrackerEngine::LinearTrackerEngine()
@@ -17,12 +18,30 @@ LinearTrackerEngine::LinearTrackerEngine()
     patterns[0].clear();
     patterns[0].name = "Pattern 01";
     
+    for (auto& pan : trackPan)
+    {
+        pan.store(0.0f);
+    }
+    
+    // Playback copy never reallocates on the audio thread
+    compiledEvents.reserve(MAX_TRACKS * MAX_PATTERN_LENGTH);
+    playbackEvents.reserve(MAX_TRACKS * MAX_PATTERN_LENGTH);
+    
     // Setup default timing
     calculateTiming();
+    
+    // Stand-in for slots whose first sample is still decoding
+    auto silence = std::make_shared<SampleData>();
+    silence->buffer.setSize(1, 1);
+    silence->buffer.clear();
+    silentSample = std::move(silence);
+    
+    loaderThread.startThread(juce::Thread::Priority::low);
 }
 
 LinearTrackerEngine::~LinearTrackerEngine()
 {
+    loaderThread.stopThread(2000);
     releaseResources();
 }
 
@@ -40,73 +59,227 @@ void LinearTrackerEngine::prepareToPlay(double sampleRate_, int samplesPerBlock_
         voice.isActive = false;
     }
     
+    mixBuffer.setSize(2, samplesPerBlock, false, true, false);
+    voiceScratch.assign(static_cast<size_t>(samplesPerBlock), 0.0f);
+    envelopeScratch.assign(static_cast<size_t>(samplesPerBlock), 0.0f);
+    triggerFifo.reset();
+    allNotesOffRequested.store(false);
+    
+    // Retime the event list and take it before the first block
+    juce::ScopedLock lock(patternLock);
     calculateTiming();
+    
+    playbackEvents = compiledEvents;
+    playbackPatternLength = compiledPatternLength;
+    playbackPatternRows = compiledPatternRows;
+    compiledEventsChanged.store(false);
+    pendingSeekRow.store(0);
 }
 
 void LinearTrackerEngine::processBlock(juce::AudioBuffer<float>& buffer)
 {
     auto startTime = juce::Time::getMillisecondCounter();
     
-    if (!isPlaybackActive.load())
+    // Bracket the block so the loader knows when retired samples are unreachable
+    struct AudioBlockScope
     {
-        buffer.clear();
-        return;
-    }
+        AudioBlockScope(LinearTrackerEngine& e) : engine(e)
+        {
+            engine.audioBlockActive.store(true);
+            engine.audioEpoch.fetch_add(1);
+        }
+        ~AudioBlockScope() { engine.audioBlockActive.store(false); }
+        LinearTrackerEngine& engine;
+    } blockScope(*this);
     
     const int numSamples = buffer.getNumSamples();
     buffer.clear();
     
-    // Process each sample
-    for (int sample = 0; sample < numSamples; ++sample)
+    refreshPlaybackEvents();
+    
+    if (allNotesOffRequested.exchange(false))
     {
-        // Check if we need to trigger new notes
-        if (samplePosition >= nextRowPosition)
+        for (auto& voice : voices)
         {
-            processRowTriggers();
-            advancePlayback(1);
+            voice.stopNote();
         }
-        else
+    }
+    
+    // Only grows if the host breaks its samplesPerBlock promise
+    if (numSamples > mixBuffer.getNumSamples())
+        mixBuffer.setSize(2, numSamples, false, false, true);
+    
+    mixBuffer.clear();
+    processQueuedTriggers();
+    
+    if (!isPlaybackActive.load() || playbackPatternLength <= 0)
+    {
+        // Queued/releasing voices keep sounding while the transport is stopped
+        renderVoices(0, numSamples);
+        writeMixToOutput(buffer, numSamples);
+        return;
+    }
+    
+    const int seekRow = pendingSeekRow.exchange(-1);
+    if (seekRow >= 0)
+    {
+        patternSamplePosition = (playbackPatternLength * juce::jlimit(0, playbackPatternRows - 1, seekRow)) / playbackPatternRows;
+        nextEventIndex = findEventIndexAt(patternSamplePosition);
+    }
+    
+    // Split the block at event boundaries: trigger at the exact offset, then render the span up to the next event
+    int position = 0;
+    while (position < numSamples)
+    {
+        while (nextEventIndex < playbackEvents.size() &&
+               playbackEvents[nextEventIndex].sampleTime <= patternSamplePosition)
         {
-            samplePosition += 1.0;
+            const auto& event = playbackEvents[nextEventIndex++];
+            triggerNote(event.track, event.cell);
         }
         
-        // Process all active voices
-        float mixedOutput = 0.0f;
-        {
-            juce::ScopedLock lock(voiceLock);
-            
-            for (auto& voice : voices)
-            {
-                if (voice.isActive)
-                {
-                    const auto& instrument = instruments[voice.instrumentIndex];
-                    float voiceSample = voice.renderNextSample(instrument);
-                    mixedOutput += voiceSample;
-                    
-                    // Update visual feedback
-                    if (voice.trackIndex >= 0 && voice.trackIndex < MAX_TRACKS)
-                    {
-                        // Track activity for visualization
-                        const float absValue = std::abs(voiceSample);
-                        // Visual feedback would be updated here
-                    }
-                }
-            }
-        }
+        const juce::int64 nextBoundary = nextEventIndex < playbackEvents.size()
+                                           ? playbackEvents[nextEventIndex].sampleTime
+                                           : playbackPatternLength;
+        const int spanLength = static_cast<int>(juce::jmin(static_cast<juce::int64>(numSamples - position),
+                                                           nextBoundary - patternSamplePosition));
         
-        // Apply to all channels
-        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        renderVoices(position, spanLength);
+        
+        position += spanLength;
+        patternSamplePosition += spanLength;
+        
+        if (patternSamplePosition >= playbackPatternLength)
         {
-            buffer.setSample(channel, sample, mixedOutput * 0.5f); // Simple attenuation
+            patternSamplePosition = 0;
+            nextEventIndex = 0;
         }
     }
     
+    currentRow.store(static_cast<int>((patternSamplePosition * playbackPatternRows) / playbackPatternLength));
+    
+    writeMixToOutput(buffer, numSamples);
+    
     // Update performance metrics
     auto endTime = juce::Time::getMillisecondCounter();
     auto processingTime = endTime - startTime;
     cpuUsage.store(static_cast<float>(processingTime) / (numSamples / sampleRate * 1000.0f));
 }
 
+void LinearTrackerEngine::renderVoices(int startSample, int numSamples)
+{
+    const int scratchSize = static_cast<int>(voiceScratch.size());
+    if (numSamples <= 0 || scratchSize == 0) return;
+    
+    // The host may hand us more than samplesPerBlock - render in scratch-sized chunks
+    for (int chunkStart = 0; chunkStart < numSamples; chunkStart += scratchSize)
+    {
+        const int chunkLength = juce::jmin(scratchSize, numSamples - chunkStart);
+        const int mixStart = startSample + chunkStart;
+        float* left = mixBuffer.getWritePointer(0, mixStart);
+        float* right = mixBuffer.getWritePointer(1, mixStart);
+        
+        for (auto& voice : voices)
+        {
+            if (!voice.isActive) continue;
+            
+            if (voice.instrumentIndex < 0 || voice.instrumentIndex >= MAX_INSTRUMENTS)
+            {
+                voice.isActive = false;
+                continue;
+            }
+            
+            const auto& instrument = instruments[static_cast<size_t>(voice.instrumentIndex)];
+            const int rendered = voice.renderSpan(instrument, instrument.sample.load(std::memory_order_acquire), sampleRate,
+                                                  voiceScratch.data(), envelopeScratch.data(), chunkLength);
+            
+            if (rendered > 0)
+            {
+                juce::FloatVectorOperations::addWithMultiply(left, voiceScratch.data(), voice.gainLeft, rendered);
+                juce::FloatVectorOperations::addWithMultiply(right, voiceScratch.data(), voice.gainRight, rendered);
+            }
+        }
+    }
+}
+
+void LinearTrackerEngine::writeMixToOutput(juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    const int numChannels = buffer.getNumChannels();
+    if (numChannels == 0 || numSamples > mixBuffer.getNumSamples()) return;
+    
+    const float masterGain = 0.5f; // Simple attenuation
+    
+    // Mono outputs, and any channel past the stereo pair, get the mono fold-down
+    // (every channel used to carry the same mono mix)
+    const int firstMonoChannel = numChannels == 1 ? 0 : 2;
+    
+    if (numChannels >= 2)
+    {
+        buffer.copyFrom(0, 0, mixBuffer, 0, 0, numSamples);
+        buffer.copyFrom(1, 0, mixBuffer, 1, 0, numSamples);
+        buffer.applyGain(0, 0, numSamples, masterGain);
+        buffer.applyGain(1, 0, numSamples, masterGain);
+    }
+    
+    for (int channel = firstMonoChannel; channel < numChannels; ++channel)
+    {
+        buffer.copyFrom(channel, 0, mixBuffer, 0, 0, numSamples);
+        buffer.addFrom(channel, 0, mixBuffer, 1, 0, numSamples);
+        buffer.applyGain(channel, 0, numSamples, masterGain * 0.5f);
+    }
+}
+
+void LinearTrackerEngine::processQueuedTriggers()
+{
+    const int numReady = triggerFifo.getNumReady();
+    if (numReady == 0) return;
+    
+    int start1, size1, start2, size2;
+    triggerFifo.prepareToRead(numReady, start1, size1, start2, size2);
+    
+    for (int i = 0; i < size1; ++i)
+        triggerNote(triggerQueue[static_cast<size_t>(start1 + i)].trackIndex, triggerQueue[static_cast<size_t>(start1 + i)].cell);
+    
+    for (int i = 0; i < size2; ++i)
+        triggerNote(triggerQueue[static_cast<size_t>(start2 + i)].trackIndex, triggerQueue[static_cast<size_t>(start2 + i)].cell);
+    
+    triggerFifo.finishedRead(size1 + size2);
+}
+
+bool LinearTrackerEngine::queueNoteTrigger(int trackIndex, const TrackerCell& cell)
+{
+    if (trackIndex < 0 || trackIndex >= MAX_TRACKS || cell.isEmpty()) return false;
+    
+    int start1, size1, start2, size2;
+    triggerFifo.prepareToWrite(1, start1, size1, start2, size2);
+    
+    if (size1 + size2 == 0) return false; // Queue full - drop rather than block
+    
+    auto& slot = triggerQueue[static_cast<size_t>(size1 > 0 ? start1 : start2)];
+    slot.trackIndex = trackIndex;
+    slot.cell = cell;
+    
+    triggerFifo.finishedWrite(1);
+    return true;
+}
+
+void LinearTrackerEngine::setTrackPan(int trackIndex, float pan)
+{
+    if (trackIndex >= 0 && trackIndex < MAX_TRACKS)
+    {
+        trackPan[static_cast<size_t>(trackIndex)].store(juce::jlimit(-1.0f, 1.0f, pan));
+    }
+}
+
+float LinearTrackerEngine::getTrackPan(int trackIndex) const
+{
+    if (trackIndex >= 0 && trackIndex < MAX_TRACKS)
+    {
+        return trackPan[static_cast<size_t>(trackIndex)].load();
+    }
+    return 0.0f;
+}
+
 void LinearTrackerEngine::releaseResources()
 {
     stopPlayback();
@@ -115,25 +288,225 @@ void LinearTrackerEngine::releaseResources()
     {
         voice.isActive = false;
     }
-    
-    for (auto& instrument : instruments)
-    {
-        instrument.sampleBuffer.reset();
-    }
 }
 
 //==============================================================================
 // Pattern Management
 
-void LinearTrackerEngine::TrackerPattern::clear()
+namespace
 {
-    for (int track = 0; track < MAX_TRACKS; ++track)
+    int countBits(juce::uint64 bits)
     {
-        for (int row = 0; row < MAX_PATTERN_LENGTH; ++row)
+        int count = 0;
+        for (; bits != 0; ++count)
+            bits &= bits - 1;
+        return count;
+    }
+    
+    int lowestSetBit(juce::uint64 bits)
+    {
+        int index = 0;
+        while ((bits & 1) == 0)
         {
-            cells[track][row].clear();
+            bits >>= 1;
+            ++index;
         }
+        return index;
     }
+    
+    juce::uint64 rowMask(int numRows)
+    {
+        return numRows >= 64 ? ~juce::uint64(0) : ((juce::uint64(1) << numRows) - 1);
+    }
+    
+    constexpr int PATTERN_STREAM_VERSION = 1;
+}
+
+// Packed cell layout: [0-7] note + 1, [8-15] instrument + 1, [16-23] volume, [24-31] effect, [32-47] effect param
+LinearTrackerEngine::TrackerPattern::PackedCell LinearTrackerEngine::TrackerPattern::packCell(const TrackerCell& cell)
+{
+    auto field = [] (int value, int maxValue) { return static_cast<PackedCell>(juce::jlimit(0, maxValue, value)); };
+    
+    return field(cell.note + 1, 0xFF)
+         | (field(cell.instrument + 1, 0xFF) << 8)
+         | (field(cell.volume, 0xFF) << 16)
+         | (field(cell.effect, 0xFF) << 24)
+         | (field(cell.effectParam, 0xFFFF) << 32);
+}
+
+void LinearTrackerEngine::TrackerPattern::unpackCell(PackedCell packed, TrackerCell& cell)
+{
+    cell.note = static_cast<int>(packed & 0xFF) - 1;
+    cell.instrument = static_cast<int>((packed >> 8) & 0xFF) - 1;
+    cell.volume = static_cast<int>((packed >> 16) & 0xFF);
+    cell.effect = static_cast<int>((packed >> 24) & 0xFF);
+    cell.effectParam = static_cast<int>((packed >> 32) & 0xFFFF);
+}
+
+int LinearTrackerEngine::TrackerPattern::slotForRow(juce::uint64 occupancy, int row)
+{
+    return countBits(occupancy & rowMask(row));
+}
+
+bool LinearTrackerEngine::TrackerPattern::hasDefaultPaint(const TrackerCell& cell)
+{
+    return cell.paintPressure == 1.0f && cell.paintColor == juce::Colours::white && cell.paintVelocity == 0.0f;
+}
+
+LinearTrackerEngine::TrackerPattern::Storage& LinearTrackerEngine::TrackerPattern::editStorage()
+{
+    // Detach from any pattern we share with before writing
+    if (storage == nullptr)
+        storage = std::make_shared<Storage>();
+    else if (storage.use_count() > 1)
+        storage = std::make_shared<Storage>(*storage);
+    
+    return const_cast<Storage&>(*storage);
+}
+
+bool LinearTrackerEngine::TrackerPattern::hasCell(int track, int row) const
+{
+    if (storage == nullptr || track < 0 || track >= MAX_TRACKS || row < 0 || row >= MAX_PATTERN_LENGTH)
+        return false;
+    
+    return (storage->tracks[static_cast<size_t>(track)].occupancy >> row) & 1;
+}
+
+LinearTrackerEngine::TrackerCell LinearTrackerEngine::TrackerPattern::getCell(int track, int row) const
+{
+    TrackerCell cell;
+    if (!hasCell(track, row)) return cell;
+    
+    const auto& trackData = storage->tracks[static_cast<size_t>(track)];
+    unpackCell(trackData.cells[static_cast<size_t>(slotForRow(trackData.occupancy, row))], cell);
+    
+    const auto key = static_cast<juce::uint16>(track * MAX_PATTERN_LENGTH + row);
+    auto paint = std::lower_bound(storage->paint.begin(), storage->paint.end(), key,
+                                  [] (const PaintData& p, juce::uint16 k) { return p.key < k; });
+    
+    if (paint != storage->paint.end() && paint->key == key)
+    {
+        cell.paintPressure = paint->pressure;
+        cell.paintColor = paint->colour;
+        cell.paintVelocity = paint->velocity;
+    }
+    
+    return cell;
+}
+
+void LinearTrackerEngine::TrackerPattern::setCell(int track, int row, const TrackerCell& cell)
+{
+    if (track < 0 || track >= MAX_TRACKS || row < 0 || row >= MAX_PATTERN_LENGTH) return;
+    
+    if (cell.isEmpty())
+    {
+        clearCell(track, row);
+        return;
+    }
+    
+    auto& data = editStorage();
+    auto& trackData = data.tracks[static_cast<size_t>(track)];
+    const auto bit = juce::uint64(1) << row;
+    const auto slot = trackData.cells.begin() + slotForRow(trackData.occupancy, row);
+    
+    if ((trackData.occupancy & bit) != 0)
+    {
+        *slot = packCell(cell);
+    }
+    else
+    {
+        trackData.cells.insert(slot, packCell(cell));
+        trackData.occupancy |= bit;
+        ++data.numCells;
+    }
+    
+    const auto key = static_cast<juce::uint16>(track * MAX_PATTERN_LENGTH + row);
+    auto paint = std::lower_bound(data.paint.begin(), data.paint.end(), key,
+                                  [] (const PaintData& p, juce::uint16 k) { return p.key < k; });
+    const bool hasEntry = paint != data.paint.end() && paint->key == key;
+    
+    if (hasDefaultPaint(cell))
+    {
+        if (hasEntry)
+            data.paint.erase(paint);
+    }
+    else
+    {
+        PaintData entry { key, cell.paintPressure, cell.paintColor, cell.paintVelocity };
+        
+        if (hasEntry)
+            *paint = entry;
+        else
+            data.paint.insert(paint, entry);
+    }
+}
+
+void LinearTrackerEngine::TrackerPattern::clearCell(int track, int row)
+{
+    if (!hasCell(track, row)) return;
+    
+    auto& data = editStorage();
+    auto& trackData = data.tracks[static_cast<size_t>(track)];
+    
+    trackData.cells.erase(trackData.cells.begin() + slotForRow(trackData.occupancy, row));
+    trackData.occupancy &= ~(juce::uint64(1) << row);
+    --data.numCells;
+    
+    const auto key = static_cast<juce::uint16>(track * MAX_PATTERN_LENGTH + row);
+    auto paint = std::lower_bound(data.paint.begin(), data.paint.end(), key,
+                                  [] (const PaintData& p, juce::uint16 k) { return p.key < k; });
+    
+    if (paint != data.paint.end() && paint->key == key)
+        data.paint.erase(paint);
+}
+
+juce::uint64 LinearTrackerEngine::TrackerPattern::getTrackOccupancy(int track) const
+{
+    if (storage == nullptr || track < 0 || track >= MAX_TRACKS) return 0;
+    return storage->tracks[static_cast<size_t>(track)].occupancy;
+}
+
+juce::uint64 LinearTrackerEngine::TrackerPattern::getOccupiedRows() const
+{
+    juce::uint64 rows = 0;
+    if (storage != nullptr)
+    {
+        for (const auto& trackData : storage->tracks)
+            rows |= trackData.occupancy;
+    }
+    return rows;
+}
+
+int LinearTrackerEngine::TrackerPattern::getNumCells() const
+{
+    return storage != nullptr ? storage->numCells : 0;
+}
+
+void LinearTrackerEngine::TrackerPattern::clear()
+{
+    // Dropping the reference is enough - a shared copy keeps its own data
+    storage.reset();
+}
+
+void LinearTrackerEngine::TrackerPattern::clearTrack(int track)
+{
+    if (getTrackOccupancy(track) == 0) return;
+    
+    auto& data = editStorage();
+    auto& trackData = data.tracks[static_cast<size_t>(track)];
+    
+    data.numCells -= countBits(trackData.occupancy);
+    trackData.occupancy = 0;
+    trackData.cells.clear();
+    trackData.cells.shrink_to_fit();
+    
+    const auto firstKey = static_cast<juce::uint16>(track * MAX_PATTERN_LENGTH);
+    data.paint.erase(std::remove_if(data.paint.begin(), data.paint.end(),
+                                    [firstKey] (const PaintData& p) { return p.key >= firstKey && p.key < firstKey + MAX_PATTERN_LENGTH; }),
+                     data.paint.end());
+    
+    if (data.numCells == 0)
+        storage.reset();
 }
 
 void LinearTrackerEngine::TrackerPattern::resizePattern(int newLength)
@@ -141,11 +514,173 @@ void LinearTrackerEngine::TrackerPattern::resizePattern(int newLength)
     length = juce::jlimit(1, MAX_PATTERN_LENGTH, newLength);
 }
 
+void LinearTrackerEngine::TrackerPattern::writeToStream(juce::OutputStream& output) const
+{
+    output.writeString(name);
+    output.writeInt(length);
+    output.writeFloat(tempo);
+    output.writeInt(rowsPerBeat);
+    output.writeInt(getNumCells());
+    
+    if (storage == nullptr) return;
+    
+    for (int track = 0; track < MAX_TRACKS; ++track)
+    {
+        const auto& trackData = storage->tracks[static_cast<size_t>(track)];
+        if (trackData.occupancy == 0) continue;
+        
+        output.writeByte(static_cast<char>(track));
+        output.writeInt64(static_cast<juce::int64>(trackData.occupancy));
+        
+        for (auto packed : trackData.cells)
+            output.writeInt64(static_cast<juce::int64>(packed));
+    }
+    
+    output.writeInt(static_cast<int>(storage->paint.size()));
+    for (const auto& paint : storage->paint)
+    {
+        output.writeShort(static_cast<short>(paint.key));
+        output.writeFloat(paint.pressure);
+        output.writeInt(static_cast<int>(paint.colour.getARGB()));
+        output.writeFloat(paint.velocity);
+    }
+}
+
+bool LinearTrackerEngine::TrackerPattern::readFromStream(juce::InputStream& input)
+{
+    storage.reset();
+    
+    name = input.readString();
+    length = juce::jlimit(1, MAX_PATTERN_LENGTH, input.readInt());
+    tempo = input.readFloat();
+    rowsPerBeat = juce::jmax(1, input.readInt());
+    
+    const int numCells = input.readInt();
+    if (numCells <= 0) return numCells == 0;
+    if (numCells > MAX_TRACKS * MAX_PATTERN_LENGTH) return false;
+    
+    auto data = std::make_shared<Storage>();
+    int previousTrack = -1;
+    
+    // Tracks are written once each, in ascending order; anything else is corrupt
+    while (data->numCells < numCells)
+    {
+        const int track = static_cast<int>(input.readByte());
+        if (track <= previousTrack || track >= MAX_TRACKS || input.isExhausted()) return false;
+        previousTrack = track;
+        
+        auto& trackData = data->tracks[static_cast<size_t>(track)];
+        trackData.occupancy = static_cast<juce::uint64>(input.readInt64()) & rowMask(MAX_PATTERN_LENGTH);
+        if (trackData.occupancy == 0) return false;
+        
+        trackData.cells.resize(static_cast<size_t>(countBits(trackData.occupancy)));
+        
+        for (auto& packed : trackData.cells)
+            packed = static_cast<PackedCell>(input.readInt64());
+        
+        data->numCells += static_cast<int>(trackData.cells.size());
+    }
+    
+    if (data->numCells != numCells) return false;
+    
+    const int numPaint = input.readInt();
+    if (numPaint < 0 || numPaint > numCells) return false;
+    
+    // getCell() binary-searches the side-table, so keys must be unique, sorted and
+    // refer to an occupied cell
+    data->paint.resize(static_cast<size_t>(numPaint));
+    int previousKey = -1;
+    
+    for (auto& paint : data->paint)
+    {
+        paint.key = static_cast<juce::uint16>(input.readShort());
+        if (paint.key <= previousKey || paint.key >= MAX_TRACKS * MAX_PATTERN_LENGTH) return false;
+        previousKey = paint.key;
+        
+        const int track = paint.key / MAX_PATTERN_LENGTH;
+        const int row = paint.key % MAX_PATTERN_LENGTH;
+        if (((data->tracks[static_cast<size_t>(track)].occupancy >> row) & 1) == 0) return false;
+        
+        paint.pressure = input.readFloat();
+        paint.colour = juce::Colour(static_cast<juce::uint32>(input.readInt()));
+        paint.velocity = input.readFloat();
+    }
+    
+    storage = std::move(data);
+    return true;
+}
+
+void LinearTrackerEngine::savePatterns(juce::OutputStream& output) const
+{
+    juce::ScopedLock lock(patternLock);
+    
+    output.writeInt(PATTERN_STREAM_VERSION);
+    
+    int numUsed = 0;
+    for (const auto& pattern : patterns)
+    {
+        if (!pattern.isEmpty())
+            ++numUsed;
+    }
+    
+    output.writeInt(numUsed);
+    
+    for (int i = 0; i < MAX_PATTERNS; ++i)
+    {
+        if (patterns[static_cast<size_t>(i)].isEmpty()) continue;
+        
+        output.writeShort(static_cast<short>(i));
+        patterns[static_cast<size_t>(i)].writeToStream(output);
+    }
+}
+
+bool LinearTrackerEngine::loadPatterns(juce::InputStream& input)
+{
+    if (input.readInt() != PATTERN_STREAM_VERSION) return false;
+    
+    const int numUsed = input.readInt();
+    if (numUsed < 0 || numUsed > MAX_PATTERNS) return false;
+    
+    // Parsed into a separate set and swapped in only once all of it is valid, so a
+    // truncated or corrupt stream leaves the current patterns untouched
+    auto loaded = std::make_unique<std::array<TrackerPattern, MAX_PATTERNS>>();
+    
+    for (int i = 0; i < MAX_PATTERNS; ++i)
+        (*loaded)[static_cast<size_t>(i)].name = "Pattern " + juce::String(i + 1).paddedLeft('0', 2);
+    
+    // Indices are written in ascending order, each once
+    int previousIndex = -1;
+    for (int n = 0; n < numUsed; ++n)
+    {
+        const int index = static_cast<int>(input.readShort());
+        if (index <= previousIndex || index >= MAX_PATTERNS
+            || !(*loaded)[static_cast<size_t>(index)].readFromStream(input))
+            return false;
+        
+        previousIndex = index;
+    }
+    
+    {
+        juce::ScopedLock lock(patternLock);
+        patterns.swap(*loaded);
+        
+        markRowDirty(currentPatternIndex.load(), -1);
+        calculateTiming();
+        updateAllTrackConflicts();
+    }
+    
+    // The replaced patterns are freed here, outside the lock
+    return true;
+}
+
 void LinearTrackerEngine::setCurrentPattern(int patternIndex)
 {
     if (patternIndex >= 0 && patternIndex < MAX_PATTERNS)
     {
+        juce::ScopedLock lock(patternLock);
         currentPatternIndex.store(patternIndex);
+        calculateTiming();
+        updateAllTrackConflicts();
     }
 }
 
@@ -155,8 +690,14 @@ void LinearTrackerEngine::copyPattern(int sourceIndex, int destIndex)
         destIndex >= 0 && destIndex < MAX_PATTERNS)
     {
         juce::ScopedLock lock(patternLock);
-        patterns[destIndex] = patterns[sourceIndex];
+        patterns[destIndex] = patterns[sourceIndex]; // Shares cell storage until either side is edited
         patterns[destIndex].name = "Pattern " + juce::String(destIndex + 1).paddedLeft('0', 2);
+        
+        markRowDirty(destIndex, -1);
+        recompileDirtyRows();
+        
+        if (destIndex == currentPatternIndex.load())
+            updateAllTrackConflicts();
     }
 }
 
@@ -166,6 +707,12 @@ void LinearTrackerEngine::clearPattern(int patternIndex)
     {
         juce::ScopedLock lock(patternLock);
         patterns[patternIndex].clear();
+        
+        markRowDirty(patternIndex, -1);
+        recompileDirtyRows();
+        
+        if (patternIndex == currentPatternIndex.load())
+            updateAllTrackConflicts();
     }
 }
 
@@ -177,13 +724,47 @@ void LinearTrackerEngine::clearTrack(int patternIndex, int trackIndex)
         juce::ScopedLock lock(patternLock);
         auto& pattern = patterns[patternIndex];
         
-        for (int row = 0; row < pattern.length; ++row)
+        for (auto rows = pattern.getTrackOccupancy(trackIndex) & rowMask(pattern.length); rows != 0; rows &= rows - 1)
         {
-            pattern.cells[trackIndex][row].clear();
+            const int row = lowestSetBit(rows);
+            pattern.clearCell(trackIndex, row);
+            markRowDirty(patternIndex, row);
         }
+        
+        recompileDirtyRows();
+        
+        if (patternIndex == currentPatternIndex.load())
+            updateTrackConflicts(trackIndex);
     }
 }
 
+void LinearTrackerEngine::setCell(int patternIndex, int trackIndex, int row, const TrackerCell& cell)
+{
+    if (patternIndex < 0 || patternIndex >= MAX_PATTERNS ||
+        trackIndex < 0 || trackIndex >= MAX_TRACKS ||
+        row < 0 || row >= MAX_PATTERN_LENGTH)
+        return;
+    
+    juce::ScopedLock lock(patternLock);
+    patterns[patternIndex].setCell(trackIndex, row, cell);
+    
+    markRowDirty(patternIndex, row);
+    recompileDirtyRows();
+    
+    if (patternIndex == currentPatternIndex.load())
+        updateTrackConflicts(trackIndex);
+}
+
+void LinearTrackerEngine::notifyCellsChanged(int patternIndex, int row)
+{
+    juce::ScopedLock lock(patternLock);
+    markRowDirty(patternIndex, row);
+    recompileDirtyRows();
+    
+    if (patternIndex == currentPatternIndex.load())
+        updateAllTrackConflicts();
+}
+
 //==============================================================================
 // Linear Drumming Frequency Assignment
 
@@ -191,6 +772,7 @@ void LinearTrackerEngine::setTrackFrequencyRange(int trackIndex, DrumType drumTy
 {
     if (trackIndex < 0 || trackIndex >= MAX_TRACKS) return;
     
+    juce::ScopedLock lock(patternLock);
     FrequencyRange& range = trackFrequencyRanges[trackIndex];
     range.drumType = drumType;
     
@@ -301,23 +883,29 @@ void LinearTrackerEngine::setTrackFrequencyRange(int trackIndex, DrumType drumTy
             range.trackName = "Percussion";
             break;
     }
+    
+    updateTrackConflicts(trackIndex);
 }
 
 void LinearTrackerEngine::setCustomFrequencyRange(int trackIndex, float lowHz, float highHz)
 {
     if (trackIndex < 0 || trackIndex >= MAX_TRACKS) return;
     
+    juce::ScopedLock lock(patternLock);
     FrequencyRange& range = trackFrequencyRanges[trackIndex];
     range.lowFreq = lowHz;
     range.highFreq = highHz;
     range.centerFreq = (lowHz + highHz) * 0.5f;
     range.trackName = "Custom " + juce::String(trackIndex + 1);
+    
+    updateTrackConflicts(trackIndex);
 }
 
 LinearTrackerEngine::FrequencyRange LinearTrackerEngine::getTrackFrequencyRange(int trackIndex) const
 {
     if (trackIndex >= 0 && trackIndex < MAX_TRACKS)
     {
+        juce::ScopedLock lock(patternLock);
         return trackFrequencyRanges[trackIndex];
     }
     return FrequencyRange{};
@@ -352,27 +940,18 @@ bool LinearTrackerEngine::FrequencyRange::doesOverlap(const FrequencyRange& othe
 
 bool LinearTrackerEngine::checkForFrequencyConflicts() const
 {
-    for (int i = 0; i < MAX_TRACKS - 1; ++i)
-    {
-        for (int j = i + 1; j < MAX_TRACKS; ++j)
-        {
-            if (trackFrequencyRanges[i].doesOverlap(trackFrequencyRanges[j]))
-            {
-                return true;
-            }
-        }
-    }
-    return false;
+    // Maintained incrementally - no pair sweep needed
+    return getConflictAnalysis()->hasFrequencyMasking;
 }
 
 void LinearTrackerEngine::resolveFrequencyConflicts()
 {
-    // Simple conflict resolution: spread overlapping ranges
+    // Simple conflict resolution: spread overlapping ranges (the matrix follows each move)
     for (int i = 0; i < MAX_TRACKS - 1; ++i)
     {
         for (int j = i + 1; j < MAX_TRACKS; ++j)
         {
-            if (trackFrequencyRanges[i].doesOverlap(trackFrequencyRanges[j]))
+            if (detectFrequencyMasking(i, j))
             {
                 separateConflictingTracks(i, j);
             }
@@ -388,6 +967,7 @@ void LinearTrackerEngine::beginPaintStroke(float x, float y, float pressure, juc
     currentPaintStroke = std::make_unique<PaintStroke>();
     currentPaintStroke->trackIndex = canvasYToTrack(y);
     currentPaintStroke->startRow = canvasXToRow(x);
+    currentPaintStroke->endRow = currentPaintStroke->startRow;
     currentPaintStroke->points.push_back({x, y});
     currentPaintStroke->pressure = pressure;
     currentPaintStroke->color = color;
@@ -465,8 +1045,15 @@ void LinearTrackerEngine::convertPaintToPattern(const PaintStroke& stroke)
 {
     juce::ScopedLock lock(patternLock);
     
-    auto& pattern = patterns[currentPatternIndex.load()];
-    generateNotesFromStroke(stroke, pattern);
+    const int patternIndex = currentPatternIndex.load();
+    generateNotesFromStroke(stroke, patterns[patternIndex]);
+    
+    for (int row = juce::jmax(0, stroke.startRow); row <= juce::jmin(MAX_PATTERN_LENGTH - 1, stroke.endRow); ++row)
+    {
+        markRowDirty(patternIndex, row);
+    }
+    recompileDirtyRows();
+    updateTrackConflicts(stroke.trackIndex);
 }
 
 void LinearTrackerEngine::generateNotesFromStroke(const PaintStroke& stroke, TrackerPattern& pattern)
@@ -488,7 +1075,7 @@ void LinearTrackerEngine::generateNotesFromStroke(const PaintStroke& stroke, Tra
         const int row = startRow + (i * strokeLength) / noteCount;
         if (row >= 0 && row < pattern.length)
         {
-            TrackerCell& cell = pattern.cells[stroke.trackIndex][row];
+            TrackerCell cell = pattern.getCell(stroke.trackIndex, row);
             
             // Set note based on drum type
             cell.note = 60; // Middle C by default
@@ -506,6 +1093,8 @@ void LinearTrackerEngine::generateNotesFromStroke(const PaintStroke& stroke, Tra
                 const float avgSpacing = stroke.points.back().getDistanceFrom(stroke.points.front()) / stroke.points.size();
                 cell.paintVelocity = juce::jlimit(0.0f, 1.0f, avgSpacing / 10.0f);
             }
+            
+            pattern.setCell(stroke.trackIndex, row, cell);
         }
     }
 }
@@ -515,23 +1104,18 @@ void LinearTrackerEngine::generateNotesFromStroke(const PaintStroke& stroke, Tra
 
 void LinearTrackerEngine::startPlayback()
 {
+    pendingSeekRow.store(0);
     isPlaybackActive.store(true);
-    samplePosition = 0.0;
-    nextRowPosition = 0.0;
 }
 
 void LinearTrackerEngine::stopPlayback()
 {
     isPlaybackActive.store(false);
     currentRow.store(0);
-    samplePosition = 0.0;
+    pendingSeekRow.store(0);
     
-    // Stop all voices
-    juce::ScopedLock lock(voiceLock);
-    for (auto& voice : voices)
-    {
-        voice.stopNote();
-    }
+    // Voices belong to the audio thread - ask it to release them
+    allNotesOffRequested.store(true);
 }
 
 void LinearTrackerEngine::pausePlayback()
@@ -541,61 +1125,187 @@ void LinearTrackerEngine::pausePlayback()
 
 void LinearTrackerEngine::setPlaybackPosition(int row)
 {
-    currentRow.store(juce::jlimit(0, getCurrentPattern().length - 1, row));
-    samplePosition = currentRow.load() * samplesPerRow;
-    nextRowPosition = samplePosition;
+    const int clampedRow = juce::jlimit(0, getCurrentPattern().length - 1, row);
+    currentRow.store(clampedRow);
+    pendingSeekRow.store(clampedRow);
 }
 
 void LinearTrackerEngine::setTempo(float bpm)
 {
     currentTempo.store(juce::jlimit(60.0f, 200.0f, bpm));
+    
+    juce::ScopedLock lock(patternLock);
     calculateTiming();
 }
 
+void LinearTrackerEngine::setSwing(float newSwingAmount)
+{
+    swingAmount.store(juce::jlimit(0.0f, 1.0f, newSwingAmount));
+    
+    juce::ScopedLock lock(patternLock);
+    retimeCompiledEvents();
+}
+
 void LinearTrackerEngine::calculateTiming()
 {
     const float tempo = currentTempo.load();
     const double beatsPerSecond = tempo / 60.0;
     const double rowsPerSecond = beatsPerSecond * getCurrentPattern().rowsPerBeat;
     samplesPerRow = sampleRate / rowsPerSecond;
+    
+    markRowDirty(currentPatternIndex.load(), -1);
+    recompileDirtyRows();
 }
 
-void LinearTrackerEngine::advancePlayback(int numSamples)
+//==============================================================================
+// Compiled Event List
+
+juce::int64 LinearTrackerEngine::rowToSampleTime(int row, double rowSamples) const
 {
-    const int row = currentRow.load();
-    const int nextRow = (row + 1) % getCurrentPattern().length;
+    // Odd rows are pushed late by up to half a row
+    double rowPosition = static_cast<double>(row);
+    if ((row & 1) != 0)
+    {
+        rowPosition += swingAmount.load() * 0.5;
+    }
     
-    currentRow.store(nextRow);
-    nextRowPosition = (nextRow + 1) * samplesPerRow;
+    return static_cast<juce::int64>(std::llround(rowPosition * rowSamples));
 }
 
-void LinearTrackerEngine::processRowTriggers()
+void LinearTrackerEngine::markRowDirty(int patternIndex, int row)
 {
-    juce::ScopedLock lock(patternLock);
+    // Only the playing pattern is compiled
+    if (patternIndex != currentPatternIndex.load()) return;
     
+    if (row < 0 || row >= MAX_PATTERN_LENGTH)
+    {
+        allRowsDirty = true;
+    }
+    else
+    {
+        dirtyRows[static_cast<size_t>(row)] = true;
+    }
+}
+
+void LinearTrackerEngine::recompileDirtyRows()
+{
+    // Caller holds patternLock
     const auto& pattern = getCurrentPattern();
-    const int row = currentRow.load();
+    const int length = juce::jlimit(1, MAX_PATTERN_LENGTH, pattern.length);
     
-    if (row < 0 || row >= pattern.length) return;
+    auto appendRow = [this, &pattern] (std::vector<TrackerEvent>& events, int row)
+    {
+        for (int track = 0; track < MAX_TRACKS; ++track)
+        {
+            if (pattern.hasCell(track, row))
+            {
+                events.push_back({ rowToSampleTime(row, samplesPerRow), row, track, pattern.getCell(track, row) });
+            }
+        }
+    };
     
-    // Process all tracks for current row
-    for (int track = 0; track < MAX_TRACKS; ++track)
+    const auto newPatternLength = static_cast<juce::int64>(std::llround(length * samplesPerRow));
+    
+    if (allRowsDirty || length != compiledPatternRows || newPatternLength != compiledPatternLength)
     {
-        const TrackerCell& cell = pattern.cells[track][row];
-        
-        if (!cell.isEmpty())
+        compiledEvents.clear();
+        for (auto rows = pattern.getOccupiedRows() & rowMask(length); rows != 0; rows &= rows - 1)
         {
-            triggerNote(track, cell);
+            appendRow(compiledEvents, lowestSetBit(rows));
         }
+        
+        compiledPatternRows = length;
+        compiledPatternLength = newPatternLength;
+        allRowsDirty = false;
+        dirtyRows.fill(false);
+        compiledEventsChanged.store(true);
+        return;
+    }
+    
+    bool anyChanged = false;
+    std::vector<TrackerEvent> rowEvents;
+    rowEvents.reserve(MAX_TRACKS);
+    
+    for (int row = 0; row < length; ++row)
+    {
+        if (!dirtyRows[static_cast<size_t>(row)]) continue;
+        
+        // Replace just this row's slice of the (row, track) ordered list
+        auto rowBegin = std::lower_bound(compiledEvents.begin(), compiledEvents.end(), row,
+                                         [] (const TrackerEvent& e, int r) { return e.row < r; });
+        auto rowEnd = std::upper_bound(rowBegin, compiledEvents.end(), row,
+                                       [] (int r, const TrackerEvent& e) { return r < e.row; });
+        
+        rowEvents.clear();
+        appendRow(rowEvents, row);
+        
+        auto insertAt = compiledEvents.erase(rowBegin, rowEnd);
+        compiledEvents.insert(insertAt, rowEvents.begin(), rowEvents.end());
+        anyChanged = true;
+    }
+    
+    dirtyRows.fill(false);
+    
+    if (anyChanged)
+    {
+        compiledEventsChanged.store(true);
+    }
+}
+
+void LinearTrackerEngine::retimeCompiledEvents()
+{
+    // Caller holds patternLock - cells are unchanged, only their sample times move
+    for (auto& event : compiledEvents)
+    {
+        event.sampleTime = rowToSampleTime(event.row, samplesPerRow);
+    }
+    
+    compiledEventsChanged.store(true);
+}
+
+void LinearTrackerEngine::refreshPlaybackEvents()
+{
+    if (!compiledEventsChanged.load()) return;
+    
+    // Never wait on the editor - pick the new list up next block if it's busy
+    juce::ScopedTryLock lock(patternLock);
+    if (!lock.isLocked()) return;
+    
+    const juce::int64 previousLength = playbackPatternLength;
+    
+    playbackEvents = compiledEvents; // Capacity is reserved, so this only copies
+    playbackPatternLength = compiledPatternLength;
+    playbackPatternRows = compiledPatternRows;
+    compiledEventsChanged.store(false);
+    
+    // Keep the musical position when the tempo changed underneath us
+    if (previousLength > 0 && previousLength != playbackPatternLength)
+    {
+        patternSamplePosition = (patternSamplePosition * playbackPatternLength) / previousLength;
+    }
+    
+    if (patternSamplePosition >= playbackPatternLength)
+    {
+        patternSamplePosition = 0;
     }
+    
+    nextEventIndex = findEventIndexAt(patternSamplePosition);
+}
+
+size_t LinearTrackerEngine::findEventIndexAt(juce::int64 samplePosition) const
+{
+    auto it = std::lower_bound(playbackEvents.begin(), playbackEvents.end(), samplePosition,
+                               [] (const TrackerEvent& e, juce::int64 time) { return e.sampleTime < time; });
+    return static_cast<size_t>(std::distance(playbackEvents.begin(), it));
 }
 
 //==============================================================================
 // Voice Management
 
-LinearTrackerEngine::TrackerVoice* LinearTrackerEngine::findFreeVoice()
+template <size_t NumVoices>
+LinearTrackerEngine::TrackerVoice* LinearTrackerEngine::findFreeVoice(std::array<TrackerVoice, NumVoices>& pool)
 {
-    for (auto& voice : voices)
+    for (auto& voice : pool)
     {
         if (!voice.isActive)
         {
@@ -604,8 +1314,8 @@ LinearTrackerEngine::TrackerVoice* LinearTrackerEngine::findFreeVoice()
     }
     
     // No free voice, steal oldest
-    TrackerVoice* oldest = &voices[0];
-    for (auto& voice : voices)
+    TrackerVoice* oldest = &pool[0];
+    for (auto& voice : pool)
     {
         if (voice.envelopeLevel < oldest->envelopeLevel)
         {
@@ -618,15 +1328,30 @@ LinearTrackerEngine::TrackerVoice* LinearTrackerEngine::findFreeVoice()
 
 void LinearTrackerEngine::triggerNote(int trackIndex, const TrackerCell& cell)
 {
-    juce::ScopedLock lock(voiceLock);
+    if (cell.instrument < 0 || cell.instrument >= MAX_INSTRUMENTS) return;
+    
+    const auto* sample = instruments[static_cast<size_t>(cell.instrument)].sample.load(std::memory_order_acquire);
+    if (sample == nullptr) return;
     
-    TrackerVoice* voice = findFreeVoice();
-    if (voice && cell.instrument >= 0 && cell.instrument < MAX_INSTRUMENTS)
+    if (TrackerVoice* voice = findFreeVoice(voices))
     {
-        voice->startNote(trackIndex, cell.instrument, cell.note, cell.volume / 64.0f);
+        const float pan = (trackIndex >= 0 && trackIndex < MAX_TRACKS) ? trackPan[static_cast<size_t>(trackIndex)].load() : 0.0f;
+        startVoice(*voice, trackIndex, cell, *sample, sampleRate, pan);
     }
 }
 
+void LinearTrackerEngine::startVoice(TrackerVoice& voice, int trackIndex, const TrackerCell& cell,
+                                     const SampleData& sample, double renderSampleRate, float pan) const
+{
+    voice.startNote(trackIndex, cell.instrument, cell.note, cell.volume / 64.0f);
+    voice.pitchRatio *= sample.sourceSampleRate / renderSampleRate;
+    
+    // Constant-power pan, normalised so a centred track keeps unity gain
+    const float angle = (pan + 1.0f) * juce::MathConstants<float>::pi * 0.25f;
+    voice.gainLeft = std::cos(angle) * juce::MathConstants<float>::sqrt2;
+    voice.gainRight = std::sin(angle) * juce::MathConstants<float>::sqrt2;
+}
+
 void LinearTrackerEngine::TrackerVoice::startNote(int track, int instrument, int note, float vel)
 {
     trackIndex = track;
@@ -651,115 +1376,302 @@ void LinearTrackerEngine::TrackerVoice::stopNote()
     }
 }
 
-float LinearTrackerEngine::TrackerVoice::processEnvelope(float attack, float decay, float sustain, float release)
+int LinearTrackerEngine::TrackerVoice::renderEnvelope(const TrackerInstrument& instrument, double sampleRate,
+                                                      float* envelope, int numSamples)
 {
-    switch (envStage)
+    // The envelope is piecewise linear, so each stage is written as one ramp instead of stepping per sample
+    const float samplesPerSecond = static_cast<float>(sampleRate);
+    const float sustain = instrument.sustain;
+    
+    auto rampLength = [] (float distance, float step)
     {
-        case EnvStage::Attack:
-            envelopeLevel += 1.0f / (attack * 44100.0f);
-            if (envelopeLevel >= 1.0f)
+        return step > 0.0f ? juce::jmax(1, static_cast<int>(std::ceil(distance / step))) : std::numeric_limits<int>::max();
+    };
+    
+    auto writeRamp = [&envelope] (int offset, int count, float start, float step)
+    {
+        for (int i = 0; i < count; ++i)
+            envelope[offset + i] = start + step * static_cast<float>(i + 1);
+    };
+    
+    int written = 0;
+    while (written < numSamples)
+    {
+        const int remaining = numSamples - written;
+        
+        switch (envStage)
+        {
+            case EnvStage::Attack:
             {
-                envelopeLevel = 1.0f;
-                envStage = EnvStage::Decay;
+                const float step = 1.0f / (juce::jmax(0.0001f, instrument.attack) * samplesPerSecond);
+                const int toTarget = rampLength(1.0f - envelopeLevel, step);
+                const int count = juce::jmin(remaining, toTarget);
+                writeRamp(written, count, envelopeLevel, step);
+                written += count;
+                
+                if (count == toTarget)
+                {
+                    envelopeLevel = 1.0f;
+                    envelope[written - 1] = 1.0f;
+                    envStage = EnvStage::Decay;
+                }
+                else
+                {
+                    envelopeLevel += step * static_cast<float>(count);
+                }
+                break;
             }
-            break;
-            
-        case EnvStage::Decay:
-            envelopeLevel -= (1.0f - sustain) / (decay * 44100.0f);
-            if (envelopeLevel <= sustain)
+                
+            case EnvStage::Decay:
             {
-                envelopeLevel = sustain;
-                envStage = EnvStage::Sustain;
+                const float step = (1.0f - sustain) / (juce::jmax(0.0001f, instrument.decay) * samplesPerSecond);
+                const int toTarget = rampLength(envelopeLevel - sustain, step);
+                const int count = juce::jmin(remaining, toTarget);
+                writeRamp(written, count, envelopeLevel, -step);
+                written += count;
+                
+                if (count == toTarget || step <= 0.0f)
+                {
+                    envelopeLevel = sustain;
+                    envelope[written - 1] = sustain;
+                    envStage = EnvStage::Sustain;
+                }
+                else
+                {
+                    envelopeLevel -= step * static_cast<float>(count);
+                }
+                break;
             }
-            break;
-            
-        case EnvStage::Sustain:
-            envelopeLevel = sustain;
-            break;
-            
-        case EnvStage::Release:
-            envelopeLevel -= sustain / (release * 44100.0f);
-            if (envelopeLevel <= 0.0f)
+                
+            case EnvStage::Sustain:
+                envelopeLevel = sustain;
+                std::fill(envelope + written, envelope + numSamples, sustain);
+                written = numSamples;
+                break;
+                
+            case EnvStage::Release:
             {
-                envelopeLevel = 0.0f;
-                envStage = EnvStage::Idle;
-                isActive = false;
+                const float step = juce::jmax(sustain, 0.001f) / (juce::jmax(0.0001f, instrument.release) * samplesPerSecond);
+                const int toTarget = rampLength(envelopeLevel, step);
+                const int count = juce::jmin(remaining, toTarget);
+                writeRamp(written, count, envelopeLevel, -step);
+                written += count;
+                
+                if (count == toTarget)
+                {
+                    envelopeLevel = 0.0f;
+                    envelope[written - 1] = 0.0f;
+                    envStage = EnvStage::Idle;
+                    isActive = false;
+                    return written;
+                }
+                
+                envelopeLevel -= step * static_cast<float>(count);
+                break;
             }
-            break;
-            
-        case EnvStage::Idle:
-            isActive = false;
-            break;
+                
+            case EnvStage::Idle:
+                isActive = false;
+                return written;
+        }
+    }
+    
+    return written;
+}
+
+int LinearTrackerEngine::TrackerVoice::renderSpan(const TrackerInstrument& instrument, const SampleData* sample, double sampleRate,
+                                                  float* output, float* envelope, int numSamples)
+{
+    if (!isActive || sample == nullptr)
+    {
+        isActive = false;
+        return 0;
+    }
+    
+    // Linear interpolation straight from the sample data, stopping where the sample runs out
+    const auto& buffer = sample->buffer;
+    const float* source = buffer.getReadPointer(0);
+    const double lastIndex = static_cast<double>(buffer.getNumSamples() - 1);
+    
+    int rendered = 0;
+    for (; rendered < numSamples && samplePosition < lastIndex; ++rendered)
+    {
+        const int index = static_cast<int>(samplePosition);
+        const float fraction = static_cast<float>(samplePosition - index);
+        output[rendered] = source[index] + fraction * (source[index + 1] - source[index]);
+        samplePosition += pitchRatio;
+    }
+    
+    const bool sampleFinished = rendered < numSamples;
+    
+    const int enveloped = renderEnvelope(instrument, sampleRate, envelope, rendered);
+    rendered = juce::jmin(rendered, enveloped);
+    
+    juce::FloatVectorOperations::multiply(output, envelope, rendered);
+    juce::FloatVectorOperations::multiply(output, volume, rendered);
+    
+    if (sampleFinished)
+    {
+        isActive = false;
     }
     
-    return envelopeLevel;
+    return rendered;
+}
+
+//==============================================================================
+// Instrument Management
+
+void LinearTrackerEngine::loadInstrument(int instrumentIndex, const juce::File& sampleFile)
+{
+    if (instrumentIndex < 0 || instrumentIndex >= MAX_INSTRUMENTS) return;
+    
+    {
+        juce::ScopedLock lock(loaderLock);
+        pendingLoads.push_back({ instrumentIndex, sampleFile });
+        loadsInFlight[static_cast<size_t>(instrumentIndex)].fetch_add(1);
+        
+        // Let notes on a brand-new slot trigger (silently) right away
+        if (instrumentSamples[static_cast<size_t>(instrumentIndex)] == nullptr)
+            publishInstrumentSample(instrumentIndex, silentSample);
+    }
+    
+    {
+        juce::ScopedLock lock(patternLock);
+        instruments[static_cast<size_t>(instrumentIndex)].name = sampleFile.getFileNameWithoutExtension();
+    }
+    
+    loaderThread.notify();
+}
+
+bool LinearTrackerEngine::isInstrumentLoading(int instrumentIndex) const
+{
+    if (instrumentIndex < 0 || instrumentIndex >= MAX_INSTRUMENTS) return false;
+    return loadsInFlight[static_cast<size_t>(instrumentIndex)].load() > 0;
+}
+
+juce::String LinearTrackerEngine::getSampleCacheKey(const juce::File& file)
+{
+    // Same path, size and timestamp = same audio
+    return file.getFullPathName() + "|" + juce::String(file.getSize())
+         + "|" + juce::String(file.getLastModificationTime().toMilliseconds());
+}
+
+std::shared_ptr<const LinearTrackerEngine::SampleData> LinearTrackerEngine::decodeSample(const juce::File& file)
+{
+    auto reader = std::unique_ptr<juce::AudioFormatReader>(formatManager.createReaderFor(file));
+    if (reader == nullptr || reader->lengthInSamples <= 0) return nullptr;
+    
+    auto data = std::make_shared<SampleData>();
+    const int numSamples = static_cast<int>(reader->lengthInSamples);
+    
+    data->buffer.setSize(1, numSamples); // Mono for now
+    reader->read(&data->buffer, 0, numSamples, 0, true, false);
+    data->sourceSampleRate = reader->sampleRate;
+    
+    // Measured once here so conflict weighting never touches sample data again
+    computeSampleSpectrum(*data);
+    
+    return data;
+}
+
+void LinearTrackerEngine::publishInstrumentSample(int instrumentIndex, std::shared_ptr<const SampleData> data)
+{
+    juce::ScopedLock lock(loaderLock);
+    
+    auto& owner = instrumentSamples[static_cast<size_t>(instrumentIndex)];
+    auto previous = std::move(owner);
+    
+    owner = std::move(data);
+    instruments[static_cast<size_t>(instrumentIndex)].sample.store(owner.get(), std::memory_order_release);
+    
+    // The audio thread may still be inside a block holding the old pointer
+    if (previous != nullptr)
+        retiredSamples.push_back({ std::move(previous), audioEpoch.load() });
 }
 
-float LinearTrackerEngine::TrackerVoice::renderNextSample(const TrackerInstrument& instrument)
+void LinearTrackerEngine::reclaimRetiredSamples()
 {
-    if (!isActive || !instrument.sampleBuffer) return 0.0f;
+    juce::ScopedLock lock(loaderLock);
+    
+    const bool blockRunning = audioBlockActive.load();
+    const auto epoch = audioEpoch.load();
     
-    // Get sample with interpolation
-    const auto& buffer = *instrument.sampleBuffer;
-    const int bufferLength = buffer.getNumSamples();
+    retiredSamples.erase(std::remove_if(retiredSamples.begin(), retiredSamples.end(),
+                                        [blockRunning, epoch] (const RetiredSample& retired)
+                                        {
+                                            return !blockRunning || retired.audioEpoch != epoch;
+                                        }),
+                         retiredSamples.end());
     
-    if (samplePosition >= bufferLength)
+    for (auto it = sampleCache.begin(); it != sampleCache.end();)
+        it = it->second.expired() ? sampleCache.erase(it) : std::next(it);
+}
+
+bool LinearTrackerEngine::processNextLoadRequest()
+{
+    LoadRequest request;
+    std::shared_ptr<const SampleData> data;
+    const juce::String cacheKey = [&]
     {
-        isActive = false;
-        return 0.0f;
-    }
+        juce::ScopedLock lock(loaderLock);
+        if (pendingLoads.empty()) return juce::String();
+        
+        request = pendingLoads.front();
+        pendingLoads.erase(pendingLoads.begin());
+        
+        const auto key = getSampleCacheKey(request.file);
+        auto cached = sampleCache.find(key);
+        if (cached != sampleCache.end())
+            data = cached->second.lock();
+        
+        return key;
+    }();
     
-    // Linear interpolation
-    const int index = static_cast<int>(samplePosition);
-    const float fraction = static_cast<float>(samplePosition - index);
+    if (request.instrumentIndex < 0) return false;
     
-    float sample = 0.0f;
-    if (index < bufferLength - 1)
+    if (data == nullptr)
     {
-        const float sample1 = buffer.getSample(0, index);
-        const float sample2 = buffer.getSample(0, index + 1);
-        sample = sample1 * (1.0f - fraction) + sample2 * fraction;
+        data = decodeSample(request.file);
+        
+        if (data != nullptr)
+        {
+            juce::ScopedLock lock(loaderLock);
+            sampleCache[cacheKey] = data;
+        }
     }
-    else if (index < bufferLength)
+    
+    const bool success = data != nullptr;
+    if (success)
     {
-        sample = buffer.getSample(0, index);
+        publishInstrumentSample(request.instrumentIndex, std::move(data));
+        updateAllTrackConflicts();
     }
     
-    // Apply envelope
-    const float envLevel = processEnvelope(instrument.attack, instrument.decay, 
-                                         instrument.sustain, instrument.release);
+    loadsInFlight[static_cast<size_t>(request.instrumentIndex)].fetch_sub(1);
     
-    // Advance sample position
-    samplePosition += pitchRatio;
+    if (onInstrumentLoaded)
+        onInstrumentLoaded(request.instrumentIndex, success);
     
-    return sample * envLevel * volume;
+    return true;
 }
 
-//==============================================================================
-// Instrument Management
-
-void LinearTrackerEngine::loadInstrument(int instrumentIndex, const juce::File& sampleFile)
+void LinearTrackerEngine::InstrumentLoaderThread::run()
 {
-    if (instrumentIndex < 0 || instrumentIndex >= MAX_INSTRUMENTS) return;
-    
-    auto reader = std::unique_ptr<juce::AudioFormatReader>(formatManager.createReaderFor(sampleFile));
-    
-    if (reader != nullptr)
+    while (!threadShouldExit())
     {
-        auto& instrument = instruments[instrumentIndex];
-        
-        instrument.sampleBuffer = std::make_unique<juce::AudioBuffer<float>>(
-            1, // Mono for now
-            static_cast<int>(reader->lengthInSamples)
-        );
+        if (engine.processNextLoadRequest())
+            continue;
         
-        reader->read(instrument.sampleBuffer.get(), 0, static_cast<int>(reader->lengthInSamples), 0, true, false);
+        engine.reclaimRetiredSamples();
         
-        instrument.sourceSampleRate = reader->sampleRate;
-        instrument.name = sampleFile.getFileNameWithoutExtension();
+        // Poll while retired samples wait on the audio thread, otherwise sleep until a load arrives
+        bool hasRetired = false;
+        {
+            juce::ScopedLock lock(engine.loaderLock);
+            hasRetired = !engine.retiredSamples.empty();
+        }
         
-        // Set frequency range based on track assignment
-        // This would be enhanced with automatic frequency detection
+        wait(hasRetired ? 20 : -1);
     }
 }
 
@@ -771,7 +1683,7 @@ bool LinearTrackerEngine::detectFrequencyMasking(int track1, int track2) const
     if (track1 < 0 || track1 >= MAX_TRACKS || track2 < 0 || track2 >= MAX_TRACKS)
         return false;
     
-    return trackFrequencyRanges[track1].doesOverlap(trackFrequencyRanges[track2]);
+    return maskingMatrix[static_cast<size_t>(track1)][static_cast<size_t>(track2)] > MASKING_THRESHOLD;
 }
 
 float LinearTrackerEngine::calculateFrequencyOverlap(const FrequencyRange& range1, const FrequencyRange& range2) const
@@ -816,51 +1728,220 @@ void LinearTrackerEngine::separateConflictingTracks(int track1, int track2)
         range1.highFreq = range1.lowFreq + width;
         range1.centerFreq = (range1.lowFreq + range1.highFreq) * 0.5f;
     }
+    
+    updateTrackConflicts(track1, false);
+    updateTrackConflicts(track2);
 }
 
 //==============================================================================
-// Analysis Methods
+// Incremental Conflict Analysis
 
-LinearTrackerEngine::ConflictAnalysis LinearTrackerEngine::analyzePattern(int patternIndex) const
+namespace
 {
-    ConflictAnalysis analysis;
+    const float conflictMinFrequency = 20.0f;
+    const float conflictFrequencySpan = 1000.0f; // 20 Hz * 1000 = 20 kHz
     
-    if (patternIndex < 0 || patternIndex >= MAX_PATTERNS)
-        return analysis;
+    float conflictBandPosition(float frequency)
+    {
+        return std::log(juce::jmax(1.0f, frequency) / conflictMinFrequency) / std::log(conflictFrequencySpan)
+                 * LinearTrackerEngine::CONFLICT_SPECTRUM_BANDS;
+    }
+}
+
+void LinearTrackerEngine::computeSampleSpectrum(SampleData& sample)
+{
+    sample.hasSpectrum = false;
+    sample.spectrum.fill(0.0f);
     
-    const auto& pattern = patterns[patternIndex];
+    if (sample.buffer.getNumSamples() == 0) return;
     
-    // Check for frequency conflicts
-    for (int i = 0; i < MAX_TRACKS - 1; ++i)
+    constexpr int fftOrder = 11;
+    constexpr int fftSize = 1 << fftOrder;
+    constexpr int maxFrames = 32; // Drum hits are short - the first ~1.5 s says enough
+    
+    juce::dsp::FFT fft(fftOrder);
+    juce::dsp::WindowingFunction<float> window(fftSize, juce::dsp::WindowingFunction<float>::hann, false);
+    std::vector<float> fftData(2 * fftSize);
+    
+    const float* source = sample.buffer.getReadPointer(0);
+    const int numSamples = sample.buffer.getNumSamples();
+    const int numFrames = juce::jmin(maxFrames, (numSamples + fftSize - 1) / fftSize);
+    const float binWidth = static_cast<float>(sample.sourceSampleRate) / fftSize;
+    
+    for (int frame = 0; frame < numFrames; ++frame)
     {
-        for (int j = i + 1; j < MAX_TRACKS; ++j)
+        const int start = frame * fftSize;
+        const int count = juce::jmin(fftSize, numSamples - start);
+        
+        std::fill(fftData.begin(), fftData.end(), 0.0f);
+        std::copy(source + start, source + start + count, fftData.begin());
+        window.multiplyWithWindowingTable(fftData.data(), fftSize);
+        fft.performFrequencyOnlyForwardTransform(fftData.data());
+        
+        for (int bin = 1; bin < fftSize / 2; ++bin)
         {
-            if (detectFrequencyMasking(i, j))
-            {
-                analysis.hasFrequencyMasking = true;
-                analysis.conflictingTracks.push_back({i, j});
-            }
+            const int band = static_cast<int>(conflictBandPosition(bin * binWidth));
+            if (band >= 0 && band < CONFLICT_SPECTRUM_BANDS)
+                sample.spectrum[static_cast<size_t>(band)] += fftData[static_cast<size_t>(bin)] * fftData[static_cast<size_t>(bin)];
         }
     }
     
-    // Calculate pattern complexity
-    int totalNotes = 0;
+    float total = 0.0f;
+    for (auto energy : sample.spectrum)
+        total += energy;
+    
+    if (total <= 0.0f) return;
+    
+    for (auto& energy : sample.spectrum)
+        energy /= total;
+    
+    sample.hasSpectrum = true;
+}
+
+void LinearTrackerEngine::updateTrackConflicts(int trackIndex, bool publish)
+{
+    if (trackIndex < 0 || trackIndex >= MAX_TRACKS) return;
+    
+    juce::ScopedLock lock(patternLock);
+    juce::ScopedLock samplesLock(loaderLock);  // Keeps the instruments' sample data alive while we read it
+    
+    // Energy of what the track actually plays, weighted by how often each instrument appears
+    std::array<float, CONFLICT_SPECTRUM_BANDS> energy{};
+    const auto& pattern = getCurrentPattern();
+    int numNotes = 0;
+    
+    for (auto rows = pattern.getTrackOccupancy(trackIndex) & rowMask(pattern.length); rows != 0; rows &= rows - 1)
+    {
+        const int instrumentIndex = pattern.getCell(trackIndex, lowestSetBit(rows)).instrument;
+        const SampleData* sample = (instrumentIndex >= 0 && instrumentIndex < MAX_INSTRUMENTS)
+                                     ? instrumentSamples[static_cast<size_t>(instrumentIndex)].get() : nullptr;
+        const bool measured = sample != nullptr && sample->hasSpectrum;
+        
+        for (int band = 0; band < CONFLICT_SPECTRUM_BANDS; ++band)
+        {
+            energy[static_cast<size_t>(band)] += measured ? sample->spectrum[static_cast<size_t>(band)]
+                                                          : 1.0f / CONFLICT_SPECTRUM_BANDS;
+        }
+        ++numNotes;
+    }
+    
+    // No notes yet - judge the track by its range alone
+    if (numNotes == 0)
+        energy.fill(1.0f / CONFLICT_SPECTRUM_BANDS);
+    
+    // Window by the fraction of each log band that falls inside the track's range
+    const auto& range = trackFrequencyRanges[static_cast<size_t>(trackIndex)];
+    const float low = conflictBandPosition(range.lowFreq);
+    const float high = conflictBandPosition(range.highFreq);
+    auto& profile = trackSpectralProfiles[static_cast<size_t>(trackIndex)];
+    
+    for (int band = 0; band < CONFLICT_SPECTRUM_BANDS; ++band)
+    {
+        const float inside = juce::jlimit(0.0f, 1.0f, juce::jmin(high, band + 1.0f) - juce::jmax(low, static_cast<float>(band)));
+        profile[static_cast<size_t>(band)] = energy[static_cast<size_t>(band)] * inside;
+    }
+    
+    // Refresh this track's row and column: shared energy relative to the quieter track
+    float profileTotal = 0.0f;
+    for (auto value : profile)
+        profileTotal += value;
+    
+    for (int other = 0; other < MAX_TRACKS; ++other)
+    {
+        if (other == trackIndex) continue;
+        
+        const auto& otherProfile = trackSpectralProfiles[static_cast<size_t>(other)];
+        float shared = 0.0f, otherTotal = 0.0f;
+        
+        for (int band = 0; band < CONFLICT_SPECTRUM_BANDS; ++band)
+        {
+            shared += juce::jmin(profile[static_cast<size_t>(band)], otherProfile[static_cast<size_t>(band)]);
+            otherTotal += otherProfile[static_cast<size_t>(band)];
+        }
+        
+        const float denominator = juce::jmin(profileTotal, otherTotal);
+        const float score = denominator > 1.0e-9f ? juce::jlimit(0.0f, 1.0f, shared / denominator) : 0.0f;
+        
+        maskingMatrix[static_cast<size_t>(trackIndex)][static_cast<size_t>(other)] = score;
+        maskingMatrix[static_cast<size_t>(other)][static_cast<size_t>(trackIndex)] = score;
+    }
+    
+    if (publish)
+        publishConflictAnalysis();
+}
+
+void LinearTrackerEngine::updateAllTrackConflicts()
+{
+    juce::ScopedLock lock(patternLock);
+    
     for (int track = 0; track < MAX_TRACKS; ++track)
+        updateTrackConflicts(track, false);
+    
+    publishConflictAnalysis();
+}
+
+LinearTrackerEngine::ConflictAnalysis LinearTrackerEngine::buildConflictAnalysis(const TrackerPattern& pattern) const
+{
+    ConflictAnalysis analysis;
+    analysis.maskingMatrix = maskingMatrix;
+    
+    const auto lengthMask = rowMask(pattern.length);
+    int totalNotes = 0;
+    
+    for (int i = 0; i < MAX_TRACKS; ++i)
     {
-        for (int row = 0; row < pattern.length; ++row)
+        const auto rowsI = pattern.getTrackOccupancy(i) & lengthMask;
+        totalNotes += countBits(rowsI);
+        
+        for (int j = i + 1; j < MAX_TRACKS; ++j)
         {
-            if (!pattern.cells[track][row].isEmpty())
+            const int shared = countBits(rowsI & pattern.getTrackOccupancy(j) & lengthMask);
+            analysis.sharedRows[static_cast<size_t>(i)][static_cast<size_t>(j)] = shared;
+            analysis.sharedRows[static_cast<size_t>(j)][static_cast<size_t>(i)] = shared;
+            
+            if (maskingMatrix[static_cast<size_t>(i)][static_cast<size_t>(j)] > MASKING_THRESHOLD)
             {
-                totalNotes++;
+                analysis.hasFrequencyMasking = true;
+                analysis.conflictingTracks.push_back({i, j});
+                
+                if (shared > 0)
+                    analysis.hasTimingConflicts = true;
             }
         }
     }
     
     analysis.overallComplexity = static_cast<float>(totalNotes) / (MAX_TRACKS * pattern.length);
-    
     return analysis;
 }
 
+void LinearTrackerEngine::publishConflictAnalysis()
+{
+    auto snapshot = std::make_shared<const ConflictAnalysis>(buildConflictAnalysis(getCurrentPattern()));
+    std::atomic_store(&publishedConflicts, std::move(snapshot));
+    conflictVersion.fetch_add(1);
+}
+
+std::shared_ptr<const LinearTrackerEngine::ConflictAnalysis> LinearTrackerEngine::getConflictAnalysis() const
+{
+    auto snapshot = std::atomic_load(&publishedConflicts);
+    return snapshot != nullptr ? snapshot : std::make_shared<const ConflictAnalysis>();
+}
+
+//==============================================================================
+// Analysis Methods
+
+LinearTrackerEngine::ConflictAnalysis LinearTrackerEngine::analyzePattern(int patternIndex) const
+{
+    if (patternIndex < 0 || patternIndex >= MAX_PATTERNS)
+        return ConflictAnalysis{};
+    
+    if (patternIndex == currentPatternIndex.load())
+        return *getConflictAnalysis();
+    
+    juce::ScopedLock lock(patternLock);
+    return buildConflictAnalysis(patterns[static_cast<size_t>(patternIndex)]);
+}
+
 void LinearTrackerEngine::optimizeForLinearDrumming(int patternIndex)
 {
     if (patternIndex < 0 || patternIndex >= MAX_PATTERNS) return;
@@ -872,4 +1953,327 @@ void LinearTrackerEngine::optimizeForLinearDrumming(int patternIndex)
     // - Redistributing notes to avoid timing conflicts
     // - Adjusting velocities based on frequency masking
     // - Suggesting alternative arrangements
-}
\ No newline at end of file
+}
+//==============================================================================
+// Offline Rendering
+
+struct LinearTrackerEngine::RenderSnapshot
+{
+    // Owning snapshot, so a load finishing mid-render can't pull data out from under us
+    std::array<std::shared_ptr<const SampleData>, MAX_INSTRUMENTS> samples;
+    
+    // Taken under patternLock before any job is queued; the pool threads read only this
+    std::array<TrackerInstrument, MAX_INSTRUMENTS> instruments;
+    std::array<float, MAX_TRACKS> trackPans{};
+    std::array<juce::String, MAX_TRACKS> trackNames;
+};
+
+struct LinearTrackerEngine::StemRenderState
+{
+    static constexpr int VOICES_PER_TRACK = 8;
+    
+    int trackIndex = 0;
+    std::vector<TrackerEvent> events;   // Absolute song time, sorted
+    size_t nextEvent = 0;
+    
+    std::array<TrackerVoice, VOICES_PER_TRACK> voices;
+    juce::AudioBuffer<float> output;
+    std::vector<float> voiceScratch;
+    std::vector<float> envelopeScratch;
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+    bool writeFailed = false;
+    
+    bool hasActiveVoices() const
+    {
+        return std::any_of(voices.begin(), voices.end(), [] (const TrackerVoice& v) { return v.isActive; });
+    }
+    
+    // Same scheduling as processBlock: split at events, trigger at the exact offset, render spans
+    void renderChunk(const LinearTrackerEngine& engine, const RenderSnapshot& snapshot,
+                     juce::int64 chunkStart, int numSamples, double renderSampleRate, float gain)
+    {
+        const auto& samples = snapshot.samples;
+        
+        output.clear();
+        
+        int position = 0;
+        while (position < numSamples)
+        {
+            const juce::int64 now = chunkStart + position;
+            
+            while (nextEvent < events.size() && events[nextEvent].sampleTime <= now)
+            {
+                const auto& event = events[nextEvent++];
+                engine.startVoice(*findFreeVoice(voices), trackIndex, event.cell,
+                                  *samples[static_cast<size_t>(event.cell.instrument)], renderSampleRate,
+                                  snapshot.trackPans[static_cast<size_t>(trackIndex)]);
+            }
+            
+            const juce::int64 nextBoundary = nextEvent < events.size() ? events[nextEvent].sampleTime : chunkStart + numSamples;
+            const int spanLength = static_cast<int>(juce::jmin(static_cast<juce::int64>(numSamples - position), nextBoundary - now));
+            
+            for (auto& voice : voices)
+            {
+                if (!voice.isActive) continue;
+                
+                const int rendered = voice.renderSpan(snapshot.instruments[static_cast<size_t>(voice.instrumentIndex)],
+                                                      samples[static_cast<size_t>(voice.instrumentIndex)].get(), renderSampleRate,
+                                                      voiceScratch.data(), envelopeScratch.data(), spanLength);
+                
+                if (rendered > 0)
+                {
+                    juce::FloatVectorOperations::addWithMultiply(output.getWritePointer(0, position), voiceScratch.data(), voice.gainLeft, rendered);
+                    juce::FloatVectorOperations::addWithMultiply(output.getWritePointer(1, position), voiceScratch.data(), voice.gainRight, rendered);
+                }
+            }
+            
+            position += spanLength;
+        }
+        
+        output.applyGain(0, numSamples, gain);
+        
+        if (writer != nullptr && !writer->writeFromAudioSampleBuffer(output, 0, numSamples))
+            writeFailed = true;
+    }
+};
+
+namespace
+{
+    std::unique_ptr<juce::AudioFormatWriter> createOfflineWriter(const juce::File& file, double sampleRate, int bitsPerSample)
+    {
+        // FileOutputStream appends, so start from an empty file
+        if (file.existsAsFile() && !file.deleteFile())
+            return nullptr;
+        
+        auto fileStream = file.createOutputStream();
+        if (!fileStream)
+            return nullptr;
+        
+        juce::WavAudioFormat wavFormat;
+        std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(fileStream.get(), sampleRate, 2,
+                                                                                  bitsPerSample, {}, 0));
+        if (writer != nullptr)
+            fileStream.release(); // Owned by the writer now
+        
+        return writer;
+    }
+}
+
+LinearTrackerEngine::OfflineRenderResult LinearTrackerEngine::renderOffline(const OfflineRenderSettings& settings,
+                                                                            std::function<void(float)> progressCallback)
+{
+    OfflineRenderResult result;
+    
+    if (settings.sampleRate <= 0.0 || (!settings.writeMix && !settings.writeStems))
+    {
+        result.errorMessage = "Nothing to render";
+        return result;
+    }
+    
+    if (!settings.outputDirectory.createDirectory())
+    {
+        result.errorMessage = "Could not create " + settings.outputDirectory.getFullPathName();
+        return result;
+    }
+    
+    auto snapshot = std::make_unique<RenderSnapshot>();
+    auto& samples = snapshot->samples;
+    {
+        juce::ScopedLock lock(loaderLock);
+        samples = instrumentSamples;
+    }
+    
+    // Snapshot the song - pattern copies share their cell storage, so this is cheap -
+    // and everything else the pool threads read, so edits during the render can't race them
+    std::vector<TrackerPattern> song;
+    {
+        juce::ScopedLock lock(patternLock);
+        
+        for (size_t i = 0; i < snapshot->instruments.size(); ++i)
+            snapshot->instruments[i].copyParametersFrom(instruments[i]);
+        
+        for (size_t track = 0; track < static_cast<size_t>(MAX_TRACKS); ++track)
+        {
+            snapshot->trackPans[track] = trackPan[track].load();
+            snapshot->trackNames[track] = trackFrequencyRanges[track].trackName;
+        }
+        
+        if (settings.patternOrder.empty())
+        {
+            song.push_back(getCurrentPattern());
+        }
+        else
+        {
+            for (int index : settings.patternOrder)
+            {
+                if (index >= 0 && index < MAX_PATTERNS)
+                    song.push_back(patterns[static_cast<size_t>(index)]);
+            }
+        }
+    }
+    
+    // Compile every track's events in song time, using the live tempo and swing
+    std::vector<std::unique_ptr<StemRenderState>> stems;
+    juce::int64 songLength = 0;
+    
+    for (int track = 0; track < MAX_TRACKS; ++track)
+    {
+        auto state = std::make_unique<StemRenderState>();
+        state->trackIndex = track;
+        
+        juce::int64 patternStart = 0;
+        for (const auto& pattern : song)
+        {
+            const double rowSamples = settings.sampleRate / (currentTempo.load() / 60.0 * juce::jmax(1, pattern.rowsPerBeat));
+            const int length = juce::jlimit(1, MAX_PATTERN_LENGTH, pattern.length);
+            
+            for (auto rows = pattern.getTrackOccupancy(track) & rowMask(length); rows != 0; rows &= rows - 1)
+            {
+                const int row = lowestSetBit(rows);
+                const auto cell = pattern.getCell(track, row);
+                
+                if (cell.instrument >= 0 && cell.instrument < MAX_INSTRUMENTS &&
+                    samples[static_cast<size_t>(cell.instrument)] != nullptr)
+                {
+                    state->events.push_back({ patternStart + rowToSampleTime(row, rowSamples), row, track, cell });
+                }
+            }
+            
+            patternStart += static_cast<juce::int64>(std::llround(length * rowSamples));
+        }
+        
+        songLength = juce::jmax(songLength, patternStart);
+        
+        if (!state->events.empty())
+            stems.push_back(std::move(state));
+    }
+    
+    if (stems.empty())
+    {
+        result.errorMessage = "The selected patterns contain no playable notes";
+        return result;
+    }
+    
+    constexpr int CHUNK_SIZE = 8192;
+    
+    std::unique_ptr<juce::AudioFormatWriter> mixWriter;
+    juce::AudioBuffer<float> mixBuffer;
+    
+    // A cancelled or failed render leaves nothing behind: close every writer, then delete its file
+    const auto fail = [&result, &stems, &mixWriter] (const juce::String& message)
+    {
+        for (auto& stem : stems)
+            stem->writer.reset();
+        
+        mixWriter.reset();
+        
+        for (const auto& file : result.writtenFiles)
+            file.deleteFile();
+        
+        result.writtenFiles.clear();
+        result.errorMessage = message;
+        return result;
+    };
+    
+    for (auto& stem : stems)
+    {
+        stem->output.setSize(2, CHUNK_SIZE);
+        stem->voiceScratch.resize(CHUNK_SIZE);
+        stem->envelopeScratch.resize(CHUNK_SIZE);
+        
+        if (settings.writeStems)
+        {
+            const auto& trackName = snapshot->trackNames[static_cast<size_t>(stem->trackIndex)];
+            const auto file = settings.outputDirectory.getChildFile(
+                juce::File::createLegalFileName(settings.baseName + "_" + juce::String(stem->trackIndex + 1).paddedLeft('0', 2)
+                                                + "_" + trackName + ".wav"));
+            
+            stem->writer = createOfflineWriter(file, settings.sampleRate, settings.bitsPerSample);
+            if (stem->writer == nullptr)
+                return fail("Could not write " + file.getFullPathName());
+            
+            result.writtenFiles.push_back(file);
+        }
+    }
+    
+    if (settings.writeMix)
+    {
+        const auto file = settings.outputDirectory.getChildFile(juce::File::createLegalFileName(settings.baseName + "_Mix.wav"));
+        mixWriter = createOfflineWriter(file, settings.sampleRate, settings.bitsPerSample);
+        
+        if (mixWriter == nullptr)
+            return fail("Could not write " + file.getFullPathName());
+        
+        mixBuffer.setSize(2, CHUNK_SIZE);
+        result.writtenFiles.push_back(file);
+    }
+    
+    const int numThreads = settings.numThreads > 0 ? settings.numThreads : juce::SystemStats::getNumCpus();
+    juce::ThreadPool pool(juce::jmin(numThreads, static_cast<int>(stems.size())));
+    
+    const auto tailLength = static_cast<juce::int64>(settings.tailSeconds * settings.sampleRate);
+    const juce::int64 maxLength = songLength + tailLength;
+    const float masterGain = 0.5f; // Same attenuation as the live mix, so the stems sum to the mix
+    
+    juce::int64 position = 0;
+    while (position < maxLength)
+    {
+        // Stop once the song is over and every release has finished
+        if (position >= songLength &&
+            std::none_of(stems.begin(), stems.end(), [] (const auto& stem) { return stem->hasActiveVoices(); }))
+            break;
+        
+        if (juce::Thread::currentThreadShouldExit())
+            return fail("Render cancelled");
+        
+        const int chunkLength = static_cast<int>(juce::jmin(static_cast<juce::int64>(CHUNK_SIZE), maxLength - position));
+        
+        // Each track renders (and streams its stem) on a pool thread; the chunk is the sync point
+        std::atomic<int> remaining { static_cast<int>(stems.size()) };
+        juce::WaitableEvent chunkDone;
+        
+        for (auto& stem : stems)
+        {
+            auto* state = stem.get();
+            const auto* renderSnapshot = snapshot.get();
+            pool.addJob([this, state, renderSnapshot, position, chunkLength, masterGain, &settings, &remaining, &chunkDone]
+            {
+                state->renderChunk(*this, *renderSnapshot, position, chunkLength, settings.sampleRate, masterGain);
+                
+                if (--remaining == 0)
+                    chunkDone.signal();
+            });
+        }
+        
+        chunkDone.wait();
+        
+        if (mixWriter != nullptr)
+        {
+            // Summed in track order so the mix is bit-identical run to run
+            mixBuffer.clear();
+            for (const auto& stem : stems)
+            {
+                mixBuffer.addFrom(0, 0, stem->output, 0, 0, chunkLength);
+                mixBuffer.addFrom(1, 0, stem->output, 1, 0, chunkLength);
+            }
+            
+            if (!mixWriter->writeFromAudioSampleBuffer(mixBuffer, 0, chunkLength))
+                return fail("Error writing the mix file");
+        }
+        
+        if (std::any_of(stems.begin(), stems.end(), [] (const auto& stem) { return stem->writeFailed; }))
+            return fail("Error writing a stem file");
+        
+        position += chunkLength;
+        
+        if (progressCallback)
+            progressCallback(static_cast<float>(position) / static_cast<float>(maxLength));
+    }
+    
+    if (progressCallback)
+        progressCallback(1.0f);
+    
+    result.numSamples = position;
+    result.success = true;
+    return result;
+}
@@ -4,6 +4,8 @@
 #include <atomic>
 #include <array>
 #include <vector>
+#include <functional>
+#include <map>
 
 /**
  * Linear Tracker Engine - Revolutionary New Sequencing Concept
@@ -56,16 +58,71 @@ public:
         void clear() { *this = TrackerCell{}; }
     };
     
+    /**
+     * Sparse pattern storage. Cells are bit-packed into 64-bit words and stored
+     * per track only for occupied rows; a 64-bit occupancy mask per track maps a
+     * row to its slot (popcount of the lower bits). Paint metadata that differs
+     * from the defaults lives in a small sorted side-table. Copies share storage
+     * until one of them is edited (copy-on-write), and empty patterns own nothing.
+     */
     struct TrackerPattern
     {
-        TrackerCell cells[MAX_TRACKS][MAX_PATTERN_LENGTH];
         juce::String name = "Pattern";
         int length = 64;         // Actual pattern length
         float tempo = 120.0f;    // BPM for this pattern
         int rowsPerBeat = 4;     // Subdivision
         
+        TrackerCell getCell(int track, int row) const;
+        void setCell(int track, int row, const TrackerCell& cell);
+        void clearCell(int track, int row);
+        bool hasCell(int track, int row) const;
+        
+        // Occupancy - bit n set means row n holds a note
+        juce::uint64 getTrackOccupancy(int track) const;
+        juce::uint64 getOccupiedRows() const;
+        int getNumCells() const;
+        bool isEmpty() const { return getNumCells() == 0; }
+        
         void clear();
+        void clearTrack(int track);
         void resizePattern(int newLength);
+        
+        // Only occupied cells are written, so cost scales with content
+        void writeToStream(juce::OutputStream& output) const;
+        bool readFromStream(juce::InputStream& input);
+        
+    private:
+        using PackedCell = juce::uint64;
+        
+        struct PaintData
+        {
+            juce::uint16 key = 0;    // track * MAX_PATTERN_LENGTH + row
+            float pressure = 1.0f;
+            juce::Colour colour = juce::Colours::white;
+            float velocity = 0.0f;
+        };
+        
+        struct TrackData
+        {
+            juce::uint64 occupancy = 0;
+            std::vector<PackedCell> cells;  // One entry per set occupancy bit, in row order
+        };
+        
+        struct Storage
+        {
+            std::array<TrackData, MAX_TRACKS> tracks;
+            std::vector<PaintData> paint;   // Sorted by key
+            int numCells = 0;
+        };
+        
+        std::shared_ptr<const Storage> storage;
+        
+        Storage& editStorage();
+        
+        static PackedCell packCell(const TrackerCell& cell);
+        static void unpackCell(PackedCell packed, TrackerCell& cell);
+        static int slotForRow(juce::uint64 occupancy, int row);
+        static bool hasDefaultPaint(const TrackerCell& cell);
     };
     
     //==============================================================================
@@ -93,16 +150,19 @@ public:
     
     struct FrequencyRange
     {
-        float lowFreq;
-        float highFreq;
-        float centerFreq;
-        DrumType drumType;
+        float lowFreq = 20.0f;
+        float highFreq = 20000.0f;
+        float centerFreq = 10010.0f;
+        DrumType drumType = DrumType::Percussion1;
         juce::Colour trackColor;
         juce::String trackName;
         
         bool doesOverlap(const FrequencyRange& other) const;
     };
     
+    static constexpr int CONFLICT_SPECTRUM_BANDS = 32;   // Log-spaced, 20 Hz - 20 kHz
+    static constexpr float MASKING_THRESHOLD = 0.1f;     // Weighted overlap that counts as masking
+    
     // Get/set frequency assignments for tracks
     void setTrackFrequencyRange(int trackIndex, DrumType drumType);
     void setCustomFrequencyRange(int trackIndex, float lowHz, float highHz);
@@ -156,6 +216,16 @@ public:
     void clearPattern(int patternIndex);
     void clearTrack(int patternIndex, int trackIndex);
     
+    // Cell editing - keeps the compiled event list in sync
+    void setCell(int patternIndex, int trackIndex, int row, const TrackerCell& cell);
+    
+    // Call after editing cells through getCurrentPattern() directly (row -1 = whole pattern)
+    void notifyCellsChanged(int patternIndex, int row = -1);
+    
+    // Pattern persistence - empty patterns are skipped
+    void savePatterns(juce::OutputStream& output) const;
+    bool loadPatterns(juce::InputStream& input);
+    
     // Pattern sequencing
     void setPatternSequence(const std::vector<int>& sequence);
     void playPatternSequence(bool shouldPlay) { isSequencePlaying.store(shouldPlay); }
@@ -174,14 +244,55 @@ public:
     int getCurrentRow() const { return currentRow.load(); }
     float getTempo() const { return currentTempo.load(); }
     
+    //==============================================================================
+    // Offline Rendering (pattern/song bounce, faster than real time)
+    
+    struct OfflineRenderSettings
+    {
+        juce::File outputDirectory;
+        juce::String baseName = "Tracker";
+        double sampleRate = 48000.0;
+        int bitsPerSample = 24;
+        std::vector<int> patternOrder;   // Empty = current pattern only
+        bool writeMix = true;
+        bool writeStems = true;          // One stereo file per track that has notes
+        double tailSeconds = 2.0;        // Upper bound for release tails after the last row
+        int numThreads = 0;              // 0 = one per CPU core
+    };
+    
+    struct OfflineRenderResult
+    {
+        bool success = false;
+        juce::String errorMessage;
+        std::vector<juce::File> writtenFiles;
+        juce::int64 numSamples = 0;
+    };
+    
+    // Blocking - run it from a background thread; it stops early if that thread is asked to exit.
+    // Tracks render in parallel with their own voices, so the output does not depend on scheduling.
+    OfflineRenderResult renderOffline(const OfflineRenderSettings& settings,
+                                      std::function<void(float)> progressCallback = nullptr);
+    
     //==============================================================================
     // Instrument/Sample Assignment
     
+    // Decoded sample, immutable once published and shared by every instrument loading the same file
+    struct SampleData
+    {
+        juce::AudioBuffer<float> buffer;
+        double sourceSampleRate = 44100.0;
+        
+        // Normalised band energies, measured once at load time for conflict weighting
+        std::array<float, CONFLICT_SPECTRUM_BANDS> spectrum{};
+        bool hasSpectrum = false;
+    };
+    
     struct TrackerInstrument
     {
         juce::String name;
-        std::unique_ptr<juce::AudioBuffer<float>> sampleBuffer;
-        double sourceSampleRate = 44100.0;
+        
+        // Swapped atomically by the loader; the engine keeps the owning reference
+        std::atomic<const SampleData*> sample{nullptr};
         
         // Tracker-style parameters
         int volume = 64;         // 0-64
@@ -197,12 +308,40 @@ public:
         float decay = 0.1f;
         float sustain = 0.8f;
         float release = 0.2f;
+        
+        // Everything except the sample pointer, which has its own owning snapshot
+        void copyParametersFrom(const TrackerInstrument& other)
+        {
+            name = other.name;
+            volume = other.volume;
+            fineTune = other.fineTune;
+            relativeNote = other.relativeNote;
+            frequencyRange = other.frequencyRange;
+            useFrequencyIsolation = other.useFrequencyIsolation;
+            attack = other.attack;
+            decay = other.decay;
+            sustain = other.sustain;
+            release = other.release;
+        }
     };
     
+    // Queues a background decode and returns immediately. An empty slot plays silence until the
+    // sample arrives; a loaded slot keeps its current sound. Files already in memory are shared.
     void loadInstrument(int instrumentIndex, const juce::File& sampleFile);
+    bool isInstrumentLoading(int instrumentIndex) const;
+    
+    // Called on the loader thread when a load finishes
+    std::function<void(int instrumentIndex, bool success)> onInstrumentLoaded;
     void setInstrumentParameters(int instrumentIndex, const TrackerInstrument& params);
     TrackerInstrument& getInstrument(int instrumentIndex);
     
+    // Live note input (pads, paint preview) - queued lock-free and played on the next block
+    bool queueNoteTrigger(int trackIndex, const TrackerCell& cell);
+    
+    // Track panning (-1 = left, 0 = centre, 1 = right)
+    void setTrackPan(int trackIndex, float pan);
+    float getTrackPan(int trackIndex) const;
+    
     //==============================================================================
     // Tracker Effects (Classic + Modern)
     
@@ -260,12 +399,21 @@ public:
     struct ConflictAnalysis
     {
         bool hasFrequencyMasking = false;
-        bool hasTimingConflicts = false;
+        bool hasTimingConflicts = false;   // Masking tracks that also share rows
         std::vector<std::pair<int, int>> conflictingTracks;
         float overallComplexity = 0.0f; // 0.0-1.0
+        
+        // Spectral-energy-weighted overlap (0-1) and number of rows both tracks play on
+        std::array<std::array<float, MAX_TRACKS>, MAX_TRACKS> maskingMatrix{};
+        std::array<std::array<int, MAX_TRACKS>, MAX_TRACKS> sharedRows{};
     };
     
     ConflictAnalysis analyzePattern(int patternIndex) const;
+    
+    // Latest analysis of the current pattern, kept up to date as cells and ranges change.
+    // Lock-free to read from any thread; poll the version to spot updates.
+    std::shared_ptr<const ConflictAnalysis> getConflictAnalysis() const;
+    int getConflictAnalysisVersion() const { return conflictVersion.load(); }
     void optimizeForLinearDrumming(int patternIndex);
     
     // Smart quantization with musical intelligence
@@ -298,12 +446,44 @@ private:
     
     // Timing calculation
     double samplesPerRow = 0.0;
-    double samplePosition = 0.0;
-    double nextRowPosition = 0.0;
     
     void calculateTiming();
-    void advancePlayback(int numSamples);
-    void processRowTriggers();
+    
+    //==============================================================================
+    // Compiled Event List (pattern cells -> sorted triggers in sample time)
+    
+    struct TrackerEvent
+    {
+        juce::int64 sampleTime = 0;  // Offset from pattern start
+        int row = 0;
+        int track = 0;
+        TrackerCell cell;
+    };
+    
+    // Message-thread side, sorted by (row, track) - rows are rebuilt individually
+    std::vector<TrackerEvent> compiledEvents;
+    std::array<bool, MAX_PATTERN_LENGTH> dirtyRows{};
+    bool allRowsDirty = true;
+    juce::int64 compiledPatternLength = 0;
+    int compiledPatternRows = 0;
+    std::atomic<bool> compiledEventsChanged{false};
+    
+    // Audio-thread copy (capacity reserved up front, so refreshing never allocates)
+    std::vector<TrackerEvent> playbackEvents;
+    juce::int64 playbackPatternLength = 0;
+    int playbackPatternRows = 1;
+    juce::int64 patternSamplePosition = 0;
+    size_t nextEventIndex = 0;
+    std::atomic<int> pendingSeekRow{0};  // Transport requests, consumed by the audio thread
+    
+    juce::int64 rowToSampleTime(int row, double rowSamples) const;
+    void markRowDirty(int patternIndex, int row);
+    void recompileDirtyRows();
+    void retimeCompiledEvents();
+    void refreshPlaybackEvents();
+    size_t findEventIndexAt(juce::int64 samplePosition) const;
+    void renderVoices(int startSample, int numSamples);
+    void writeMixToOutput(juce::AudioBuffer<float>& buffer, int numSamples);
     
     //==============================================================================
     // Voice Management (for polyphonic instruments)
@@ -329,17 +509,50 @@ private:
         float slideTarget = 0.0f;
         float currentPitch = 0.0f;
         
+        // Constant-power pan gains, latched at trigger time
+        float gainLeft = 1.0f;
+        float gainRight = 1.0f;
+        
         void startNote(int track, int instrument, int note, float vel);
         void stopNote();
-        float processEnvelope(float attack, float decay, float sustain, float release);
-        float renderNextSample(const TrackerInstrument& instrument);
+        int renderEnvelope(const TrackerInstrument& instrument, double sampleRate, float* envelope, int numSamples);
+        int renderSpan(const TrackerInstrument& instrument, const SampleData* sample, double sampleRate,
+                       float* output, float* envelope, int numSamples);
     };
     
     static constexpr int MAX_VOICES = 32;
     std::array<TrackerVoice, MAX_VOICES> voices;
     
-    TrackerVoice* findFreeVoice();
+    // Voices are owned by the audio thread - everything else talks to them through the queue below
+    template <size_t NumVoices>
+    static TrackerVoice* findFreeVoice(std::array<TrackerVoice, NumVoices>& pool);
     void triggerNote(int trackIndex, const TrackerCell& cell);
+    void startVoice(TrackerVoice& voice, int trackIndex, const TrackerCell& cell,
+                    const SampleData& sample, double renderSampleRate, float pan) const;
+    
+    struct NoteTrigger
+    {
+        int trackIndex = 0;
+        TrackerCell cell;
+    };
+    
+    static constexpr int TRIGGER_QUEUE_SIZE = 256;
+    juce::AbstractFifo triggerFifo{TRIGGER_QUEUE_SIZE};
+    std::array<NoteTrigger, TRIGGER_QUEUE_SIZE> triggerQueue;
+    std::atomic<bool> allNotesOffRequested{false};
+    
+    void processQueuedTriggers();
+    
+    // Stereo accumulator and per-voice scratch, sized in prepareToPlay
+    juce::AudioBuffer<float> mixBuffer;
+    std::vector<float> voiceScratch;
+    std::vector<float> envelopeScratch;
+    
+    std::array<std::atomic<float>, MAX_TRACKS> trackPan{};
+    
+    // Per-track state for offline rendering and the settings it renders with (defined in the .cpp)
+    struct StemRenderState;
+    struct RenderSnapshot;
     
     //==============================================================================
     // Instrument Storage
@@ -347,6 +560,56 @@ private:
     static constexpr int MAX_INSTRUMENTS = 64;
     std::array<TrackerInstrument, MAX_INSTRUMENTS> instruments;
     
+    //==============================================================================
+    // Background Instrument Loading
+    //
+    // The loader decodes off the message and audio threads, then swaps the slot's raw
+    // pointer. The replaced sample is retired and only released once the audio thread
+    // has left any block that could still be reading it.
+    
+    struct LoadRequest
+    {
+        int instrumentIndex = -1;
+        juce::File file;
+    };
+    
+    struct RetiredSample
+    {
+        std::shared_ptr<const SampleData> data;
+        juce::uint32 audioEpoch = 0;
+    };
+    
+    juce::CriticalSection loaderLock;   // Guards everything in this section
+    std::vector<LoadRequest> pendingLoads;
+    std::array<std::shared_ptr<const SampleData>, MAX_INSTRUMENTS> instrumentSamples;
+    std::map<juce::String, std::weak_ptr<const SampleData>> sampleCache;
+    std::vector<RetiredSample> retiredSamples;
+    std::array<std::atomic<int>, MAX_INSTRUMENTS> loadsInFlight{};
+    
+    std::shared_ptr<const SampleData> silentSample;
+    
+    // Block bracketing for reclamation: a sample retired at epoch E is unreachable
+    // once the epoch has moved on or no block is running
+    std::atomic<juce::uint32> audioEpoch{0};
+    std::atomic<bool> audioBlockActive{false};
+    
+    class InstrumentLoaderThread : public juce::Thread
+    {
+    public:
+        InstrumentLoaderThread(LinearTrackerEngine& owner)
+            : Thread("Tracker Instrument Loader"), engine(owner) {}
+        void run() override;
+        
+    private:
+        LinearTrackerEngine& engine;
+    };
+    
+    std::shared_ptr<const SampleData> decodeSample(const juce::File& file);
+    void publishInstrumentSample(int instrumentIndex, std::shared_ptr<const SampleData> data);
+    void reclaimRetiredSamples();
+    bool processNextLoadRequest();
+    static juce::String getSampleCacheKey(const juce::File& file);
+    
     //==============================================================================
     // Canvas & Paint State
     
@@ -371,6 +634,24 @@ private:
     float calculateFrequencyOverlap(const FrequencyRange& range1, const FrequencyRange& range2) const;
     void separateConflictingTracks(int track1, int track2);
     
+    //==============================================================================
+    // Incremental Conflict Analysis
+    //
+    // Each track keeps a spectral profile (its range window times the energy of the
+    // instruments it plays). An edit only rebuilds that track's profile and its
+    // row/column of the masking matrix, then publishes a fresh snapshot.
+    
+    std::array<std::array<float, CONFLICT_SPECTRUM_BANDS>, MAX_TRACKS> trackSpectralProfiles{};
+    std::array<std::array<float, MAX_TRACKS>, MAX_TRACKS> maskingMatrix{};
+    std::shared_ptr<const ConflictAnalysis> publishedConflicts;
+    std::atomic<int> conflictVersion{0};
+    
+    void updateTrackConflicts(int trackIndex, bool publish = true);
+    void updateAllTrackConflicts();
+    void publishConflictAnalysis();
+    ConflictAnalysis buildConflictAnalysis(const TrackerPattern& pattern) const;
+    static void computeSampleSpectrum(SampleData& sample);
+    
     //==============================================================================
     // Quantization Engine
     
@@ -385,12 +666,14 @@ private:
     // Performance & Threading
     
     juce::CriticalSection patternLock;
-    juce::CriticalSection voiceLock;
     juce::AudioFormatManager formatManager;
     
     // Performance monitoring
     std::atomic<float> cpuUsage{0.0f};
     juce::Time lastProcessTime;
     
+    // Declared last so it stops before anything it touches is destroyed
+    InstrumentLoaderThread loaderThread{*this};
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LinearTrackerEngine)
 };
\ No newline at end of file
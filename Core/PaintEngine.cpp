@@ -7,9 +7,7 @@
 
 PaintEngine::PaintEngine()
 {
-    // RELIABILITY FIX: Initialize double-buffered oscillator pools
-    oscillatorPools[0].resize(MAX_OSCILLATORS);
-    oscillatorPools[1].resize(MAX_OSCILLATORS);
+    oscillators.resize(MAX_OSCILLATORS);
     
     // PHASE 1 OPTIMIZATION: Initialize enhanced oscillator states
     oscillatorStates.resize(MAX_OSCILLATORS);
@@ -20,6 +18,10 @@ PaintEngine::PaintEngine()
         freeOscillatorIndices.push_back(i);
     }
     
+    canvasRegions.reserve(RESERVED_REGIONS);
+    strokesByStart.reserve(RESERVED_PLAYBACK_STROKES);
+    soundingStrokes.reserve(2 * MAX_OSCILLATORS); // A stolen voice's stroke lingers for a block
+    
     // Set default canvas bounds for typical musical range
     setFrequencyRange(20.0f, 20000.0f);
     setCanvasRegion(-100.0f, 100.0f, -50.0f, 50.0f);
@@ -46,23 +48,23 @@ void PaintEngine::prepareToPlay(double sr, int samplesPerBlock_)
     masterGain.reset(sampleRate, 0.01); // 10ms smoothing
     masterGain.setCurrentAndTargetValue(0.7f);
     
-    // RELIABILITY FIX: Reset both oscillator pools
-    for (auto& pool : oscillatorPools)
+    for (auto& osc : oscillators)
     {
-        for (auto& osc : pool)
-        {
-            osc = Oscillator{}; // Reset to default state
-        }
+        osc = Oscillator{}; // Reset to default state
     }
     activeOscillators.store(0);
     
     DBG("PaintEngine prepared: " << sampleRate << "Hz, " << samplesPerBlock_ << " samples");
 }
 
-void PaintEngine::processBlock(juce::AudioBuffer<float>& buffer)
+void PaintEngine::processBlock(juce::AudioBuffer<float>& buffer, const PenEvent* penEvents, int numPenEvents)
 {
+    adoptPendingStrokes();
+    
     if (!isActive.load())
     {
+        // Keep recording strokes even while silent
+        applyPenEvents(penEvents, numPenEvents);
         buffer.clear();
         return;
     }
@@ -79,17 +81,19 @@ void PaintEngine::processBlock(juce::AudioBuffer<float>& buffer)
     auto* leftChannel = buffer.getWritePointer(0);
     auto* rightChannel = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
     
-    // RELIABILITY FIX: Lock-free buffer swap check (audio thread only)
-    swapBuffersIfPending();
-    
     // Update canvas oscillators based on current playhead position
     updateCanvasOscillators();
     
-    // RELIABILITY FIX: Use lock-free front buffer instead of mutex
-    auto& currentOscillatorPool = getFrontBuffer();
+    int nextPenEvent = 0;
     
     for (int sample = 0; sample < numSamples; ++sample)
     {
+        // Apply pen input at the sample it was captured
+        while (nextPenEvent < numPenEvents && penEvents[nextPenEvent].sampleOffset <= sample)
+        {
+            applyPenEvent(penEvents[nextPenEvent++]);
+        }
+        
         float leftSample = 0.0f;
         float rightSample = 0.0f;
         
@@ -99,7 +103,7 @@ void PaintEngine::processBlock(juce::AudioBuffer<float>& buffer)
         for (int i = 0; i < MAX_OSCILLATORS; ++i)
         {
             auto& oscState = oscillatorStates[i];
-            auto& osc = currentOscillatorPool[i];
+            auto& osc = oscillators[i];
             
             if (oscState.isActive())
             {
@@ -159,6 +163,12 @@ void PaintEngine::processBlock(juce::AudioBuffer<float>& buffer)
         }
     }
     
+    // Events placed past the end of the block
+    if (nextPenEvent < numPenEvents)
+    {
+        applyPenEvents(penEvents + nextPenEvent, numPenEvents - nextPenEvent);
+    }
+    
     // Update performance metrics
     const auto endTime = juce::Time::getMillisecondCounterHiRes();
     const float processingTime = static_cast<float>(endTime - startTime);
@@ -177,15 +187,12 @@ void PaintEngine::releaseResources()
 {
     // RELIABILITY FIX: No mutex needed with lock-free design
     currentStroke.reset();
+    clearPlaybackIndex();
     canvasRegions.clear();
     
-    // Reset both oscillator pools
-    for (auto& pool : oscillatorPools)
+    for (auto& osc : oscillators)
     {
-        for (auto& osc : pool)
-        {
-            osc = Oscillator{};
-        }
+        osc = Oscillator{};
     }
     
     activeOscillators.store(0);
@@ -195,6 +202,11 @@ void PaintEngine::releaseResources()
 // Stroke Interaction API
 
 void PaintEngine::beginStroke(Point position, float pressure, juce::Colour color)
+{
+    beginStroke(StrokePoint(position, pressure, color));
+}
+
+void PaintEngine::beginStroke(const StrokePoint& point)
 {
     if (currentStroke != nullptr)
     {
@@ -203,29 +215,123 @@ void PaintEngine::beginStroke(Point position, float pressure, juce::Colour color
     }
     
     currentStroke = std::make_unique<Stroke>(nextStrokeId++);
-    
-    StrokePoint point(position, pressure, color);
     currentStroke->addPoint(point);
     
-    DBG("Stroke started at (" << position.x << ", " << position.y << ") pressure=" << pressure);
+    DBG("Stroke started at (" << point.position.x << ", " << point.position.y << ") pressure=" << point.pressure);
 }
 
 void PaintEngine::updateStroke(Point position, float pressure)
+{
+    addStrokePoint(StrokePoint(position, pressure, juce::Colours::white));
+}
+
+void PaintEngine::addStrokePoint(const StrokePoint& point)
 {
     if (currentStroke == nullptr)
     {
         // Auto-start stroke if none active
-        beginStroke(position, pressure);
+        beginStroke(point);
         return;
     }
     
-    StrokePoint point(position, pressure, juce::Colours::white);
     currentStroke->addPoint(point);
     
     // PHASE 1 OPTIMIZATION: Use incremental updates instead of full recalculation
     updateOscillatorsIncremental(point);
 }
 
+void PaintEngine::applyPenEvents(const PenEvent* penEvents, int numPenEvents)
+{
+    for (int i = 0; i < numPenEvents; ++i)
+    {
+        applyPenEvent(penEvents[i]);
+    }
+}
+
+void PaintEngine::applyPenEvent(const PenEvent& event)
+{
+    switch (event.type)
+    {
+    case PenEvent::Type::Begin:
+        beginStroke(event.point);
+        break;
+    case PenEvent::Type::Move:
+        addStrokePoint(event.point);
+        break;
+    case PenEvent::Type::End:
+        endStroke();
+        break;
+    case PenEvent::Type::Clear:
+        clearCanvas();
+        break;
+    }
+}
+
+void PaintEngine::addStrokes(const std::vector<std::vector<StrokePoint>>& strokes)
+{
+    // Built, finalised and grouped into regions by their first point (as endStroke()
+    // files them) here, so the audio thread only has to link the regions in
+    RegionMap staged;
+    
+    for (const auto& points : strokes)
+    {
+        if (points.empty())
+            continue;
+        
+        auto stroke = std::make_shared<Stroke>(nextStrokeId++);
+        for (const auto& point : points)
+            stroke->addPoint(point);
+        
+        stroke->finalize();
+        
+        const auto& first = stroke->getPoints().front();
+        const auto cell = getRegionCoordinates(first.position.x, first.position.y);
+        auto& region = staged[getRegionKey(cell.x, cell.y)];
+        if (region == nullptr)
+            region = std::make_unique<CanvasRegion>(cell.x, cell.y);
+        
+        region->addStroke(std::move(stroke));
+    }
+    
+    // Nodes the audio thread has finished with are freed on leaving this function
+    std::vector<RegionMap::node_type> spent;
+    
+    const juce::ScopedLock lock(pendingStrokeLock);
+    spent.swap(retiredRegions);
+    
+    while (!staged.empty())
+        pendingRegions.push_back(staged.extract(staged.begin()));
+    
+    hasPendingStrokes.store(!pendingRegions.empty());
+}
+
+void PaintEngine::adoptPendingStrokes()
+{
+    if (!hasPendingStrokes.load())
+        return;
+    
+    // Never wait on the message thread - pick the strokes up next block if it's busy
+    const juce::ScopedTryLock lock(pendingStrokeLock);
+    if (!lock.isLocked())
+        return;
+    
+    // Moving nodes and region pointers only: nothing is allocated or freed here
+    for (auto& node : pendingRegions)
+    {
+        node.mapped()->forEachStroke([this](Stroke& stroke) { indexStroke(stroke); });
+        
+        const auto existing = canvasRegions.find(node.key());
+        if (existing == canvasRegions.end())
+            canvasRegions.insert(std::move(node));
+        else
+            existing->second->chain(std::move(node.mapped()));
+    }
+    
+    // retiredRegions is always empty here; the spent nodes go back to the message thread
+    retiredRegions.swap(pendingRegions);
+    hasPendingStrokes.store(false);
+}
+
 void PaintEngine::endStroke()
 {
     if (currentStroke == nullptr)
@@ -242,6 +348,7 @@ void PaintEngine::endStroke()
             auto* region = getOrCreateRegion(point.position.x, point.position.y);
             if (region != nullptr)
             {
+                indexStroke(*currentStroke);
                 region->addStroke(std::move(currentStroke));
                 break; // Only add to first region for now
             }
@@ -271,23 +378,24 @@ void PaintEngine::setCanvasRegion(float leftX, float rightX, float bottomY, floa
 
 void PaintEngine::clearCanvas()
 {
-    // RELIABILITY FIX: Use lock-free buffer swap for clearing
-    auto& backBuffer = getBackBuffer();
+    // Let oscillators held by playing strokes fade out rather than stick
+    for (auto* stroke : soundingStrokes)
+    {
+        if (ownsPlaybackOscillator(*stroke))
+            releaseOscillator(stroke->getPlaybackOscillator());
+    }
     
     currentStroke.reset();
+    clearPlaybackIndex();
     canvasRegions.clear();
     
-    // Reset all oscillators in back buffer
-    for (auto& osc : backBuffer)
+    for (auto& osc : oscillators)
     {
         osc.reset();
     }
     
     activeOscillators.store(0);
     
-    // Request buffer swap to apply changes
-    requestBufferSwap();
-    
     DBG("Canvas cleared");
 }
 
@@ -372,34 +480,121 @@ void PaintEngine::updateCanvasOscillators()
     // Update oscillators based on current playhead position and active strokes
     const float currentTime = canvasXToTime(playheadPosition * (canvasRight - canvasLeft) + canvasLeft);
     
-    // RELIABILITY FIX: Use lock-free front buffer
-    auto& currentOscillatorPool = getFrontBuffer();
-    
-    // Process current stroke if active
+    // Process current stroke if active; stored strokes are finalised and only
+    // sound through playStoredStrokes()
     if (currentStroke != nullptr)
     {
-        currentStroke->updateOscillators(currentTime, currentOscillatorPool);
+        currentStroke->updateOscillators(currentTime, oscillators);
     }
     
-    // Process stored canvas regions
-    for (auto& [key, region] : canvasRegions)
+    playStoredStrokes(currentTime);
+}
+
+void PaintEngine::playStoredStrokes(float currentTime)
+{
+    // Each finished stroke under the playhead holds one oscillator, which
+    // follows the stroke's pitch and pressure and is released as it ends
+    const float playheadX = timeToCanvasX(currentTime);
+    
+    for (size_t i = 0; i < soundingStrokes.size();)
     {
-        if (region != nullptr && !region->isEmpty())
+        auto& stroke = *soundingStrokes[i];
+        
+        if (stroke.spansX(playheadX) && playStroke(stroke, playheadX))
         {
-            region->updateOscillators(currentTime, currentOscillatorPool);
+            ++i;
+            continue;
         }
+        
+        if (ownsPlaybackOscillator(stroke))
+            releaseOscillator(stroke.getPlaybackOscillator());
+        
+        stroke.setPlaybackOscillator(-1);
+        soundingStrokes[i] = soundingStrokes.back();
+        soundingStrokes.pop_back();
+    }
+    
+    // Moving forward, only strokes starting since the last block can have been
+    // reached. A jump back, or a stroke filed or refused a voice behind the
+    // playhead, needs every stroke starting before it looked at again
+    const auto startsAfter = [](float x, const Stroke* stroke) { return x < stroke->getStartX(); };
+    auto first = strokesByStart.begin();
+    
+    if (!rescanPlayback && playheadX >= lastPlayheadX)
+        first = std::upper_bound(strokesByStart.begin(), strokesByStart.end(), lastPlayheadX, startsAfter);
+    
+    const auto last = std::upper_bound(first, strokesByStart.end(), playheadX, startsAfter);
+    
+    rescanPlayback = false;
+    lastPlayheadX = playheadX;
+    
+    for (; first != last; ++first)
+    {
+        auto& stroke = **first;
+        
+        if (stroke.getPlaybackOscillator() < 0 && stroke.spansX(playheadX) && playStroke(stroke, playheadX))
+            soundingStrokes.push_back(&stroke);
     }
 }
 
+bool PaintEngine::playStroke(Stroke& stroke, float playheadX)
+{
+    const auto params = strokePointToAudioParams(stroke.getPointAtX(playheadX));
+    
+    // Once stolen for other material the oscillator is left alone, never shared
+    if (ownsPlaybackOscillator(stroke))
+    {
+        retargetOscillator(stroke.getPlaybackOscillator(), params);
+        return true;
+    }
+    
+    const int newIndex = allocateOscillator();
+    if (newIndex < 0)
+    {
+        stroke.setPlaybackOscillator(-1);
+        rescanPlayback = true; // Try again next block
+        return false;
+    }
+    
+    activateOscillator(newIndex, params);
+    stroke.setPlaybackOscillator(newIndex, oscillatorStates[newIndex].generation);
+    return true;
+}
+
+void PaintEngine::indexStroke(Stroke& stroke)
+{
+    // Within the reserved capacity this only moves pointers
+    const auto position = std::upper_bound(strokesByStart.begin(), strokesByStart.end(), stroke.getStartX(),
+                                           [](float x, const Stroke* other) { return x < other->getStartX(); });
+    strokesByStart.insert(position, &stroke);
+    
+    if (stroke.getStartX() <= lastPlayheadX)
+        rescanPlayback = true;
+}
+
+void PaintEngine::clearPlaybackIndex()
+{
+    strokesByStart.clear();
+    soundingStrokes.clear();
+    rescanPlayback = true;
+}
+
 juce::int64 PaintEngine::getRegionKey(int regionX, int regionY) const
 {
     return (static_cast<juce::int64>(regionX) << 32) | static_cast<juce::int64>(regionY);
 }
 
+juce::Point<int> PaintEngine::getRegionCoordinates(float canvasX, float canvasY) const
+{
+    return { static_cast<int>(std::floor(canvasX / CanvasRegion::REGION_SIZE)),
+             static_cast<int>(std::floor(canvasY / CanvasRegion::REGION_SIZE)) };
+}
+
 PaintEngine::CanvasRegion* PaintEngine::getOrCreateRegion(float canvasX, float canvasY)
 {
-    const int regionX = static_cast<int>(std::floor(canvasX / CanvasRegion::REGION_SIZE));
-    const int regionY = static_cast<int>(std::floor(canvasY / CanvasRegion::REGION_SIZE));
+    const auto cell = getRegionCoordinates(canvasX, canvasY);
+    const int regionX = cell.x;
+    const int regionY = cell.y;
     const juce::int64 key = getRegionKey(regionX, regionY);
     
     auto it = canvasRegions.find(key);
@@ -460,25 +655,15 @@ void PaintEngine::updateCPULoad()
 
 void PaintEngine::optimizeOscillatorPool()
 {
-    // RELIABILITY FIX: Optimize using back buffer and swap
-    auto& backBuffer = getBackBuffer();
-    
-    // Reset inactive oscillators to improve cache performance
-    int compactIndex = 0;
+    // Clear oscillators whose envelope has finished. They stay in place: a slot's
+    // index is shared with oscillatorStates and with the strokes that hold it
     for (int i = 0; i < MAX_OSCILLATORS; ++i)
     {
-        if (backBuffer[i].isActive())
+        if (!oscillatorStates[i].isActive() && oscillators[i].isActive())
         {
-            if (compactIndex != i)
-            {
-                backBuffer[compactIndex] = backBuffer[i];
-                backBuffer[i].reset();
-            }
-            ++compactIndex;
+            oscillators[i].reset();
         }
     }
-    
-    requestBufferSwap();
 }
 
 //==============================================================================
@@ -529,8 +714,59 @@ PaintEngine::Stroke::Stroke(juce::uint32 id)
 
 void PaintEngine::Stroke::addPoint(const StrokePoint& point)
 {
+    if (!points.empty())
+        isMonotonicX = isMonotonicX && point.position.x >= points.back().position.x;
+    
     points.push_back(point);
-    updateBounds();
+    
+    // Grow the bounds rather than rescanning every point
+    if (points.size() == 1)
+    {
+        bounds = juce::Rectangle<float>(point.position.x, point.position.y, 0.0f, 0.0f);
+    }
+    else
+    {
+        const float left = std::min(bounds.getX(), point.position.x);
+        const float top = std::min(bounds.getY(), point.position.y);
+        const float right = std::max(bounds.getRight(), point.position.x);
+        const float bottom = std::max(bounds.getBottom(), point.position.y);
+        bounds = juce::Rectangle<float>(left, top, right - left, bottom - top);
+    }
+}
+
+PaintEngine::StrokePoint PaintEngine::Stroke::getPointAtX(float x) const
+{
+    const auto interpolate = [x](const StrokePoint& a, const StrokePoint& b)
+    {
+        const float span = b.position.x - a.position.x;
+        const float t = std::abs(span) > 1.0e-6f ? juce::jlimit(0.0f, 1.0f, (x - a.position.x) / span) : 0.0f;
+        
+        StrokePoint point = a;
+        point.position = Point(x, a.position.y + (b.position.y - a.position.y) * t);
+        point.pressure = a.pressure + (b.pressure - a.pressure) * t;
+        return point;
+    };
+    
+    if (points.size() < 2)
+        return points.front();
+    
+    if (isMonotonicX)
+    {
+        const auto next = std::lower_bound(points.begin() + 1, points.end() - 1, x,
+                                           [](const StrokePoint& point, float value) { return point.position.x < value; });
+        return interpolate(*(next - 1), *next);
+    }
+    
+    // Hand-drawn strokes may double back; use the first segment that crosses x
+    for (size_t i = 1; i < points.size(); ++i)
+    {
+        const float x0 = points[i - 1].position.x;
+        const float x1 = points[i].position.x;
+        if (x >= std::min(x0, x1) && x <= std::max(x0, x1))
+            return interpolate(points[i - 1], points[i]);
+    }
+    
+    return points.back();
 }
 
 void PaintEngine::Stroke::finalize()
@@ -596,23 +832,35 @@ void PaintEngine::CanvasRegion::addStroke(std::shared_ptr<Stroke> stroke)
 
 void PaintEngine::CanvasRegion::removeStroke(juce::uint32 strokeId)
 {
-    strokes.erase(
-        std::remove_if(strokes.begin(), strokes.end(),
-            [strokeId](const std::shared_ptr<Stroke>& stroke) {
-                return stroke->getId() == strokeId;
-            }),
-        strokes.end());
+    for (auto* region = this; region != nullptr; region = region->next.get())
+    {
+        region->strokes.erase(
+            std::remove_if(region->strokes.begin(), region->strokes.end(),
+                [strokeId](const std::shared_ptr<Stroke>& stroke) {
+                    return stroke->getId() == strokeId;
+                }),
+            region->strokes.end());
+    }
+}
+
+void PaintEngine::CanvasRegion::chain(std::unique_ptr<CanvasRegion> other)
+{
+    auto* tail = this;
+    while (tail->next != nullptr)
+        tail = tail->next.get();
+    
+    tail->next = std::move(other);
 }
 
-void PaintEngine::CanvasRegion::updateOscillators(float currentTime, std::vector<Oscillator>& oscillatorPool)
+bool PaintEngine::CanvasRegion::isEmpty() const
 {
-    for (auto& stroke : strokes)
+    for (auto* region = this; region != nullptr; region = region->next.get())
     {
-        if (stroke != nullptr && stroke->isActive())
-        {
-            stroke->updateOscillators(currentTime, oscillatorPool);
-        }
+        if (!region->strokes.empty())
+            return false;
     }
+    
+    return true;
 }
 
 //==============================================================================
@@ -701,10 +949,11 @@ void PaintEngine::activateOscillator(int index, const AudioParams& params)
     if (index < 0 || index >= MAX_OSCILLATORS) return;
     
     auto& state = oscillatorStates[index];
-    auto& osc = getBackBuffer()[index];
+    auto& osc = oscillators[index];
     
     // Set up enhanced state
     state.activate();
+    ++state.generation;
     state.targetFrequency = params.frequency;
     state.targetAmplitude = params.amplitude;
     state.targetPan = params.pan;
@@ -716,6 +965,20 @@ void PaintEngine::activateOscillator(int index, const AudioParams& params)
     DBG("SpectralCanvas: Activated oscillator " << index << " freq=" << params.frequency << "Hz");
 }
 
+void PaintEngine::retargetOscillator(int index, const AudioParams& params)
+{
+    if (index < 0 || index >= MAX_OSCILLATORS) return;
+    
+    // Like activateOscillator() for one that is already sounding, without restarting its envelope
+    auto& state = oscillatorStates[index];
+    state.targetFrequency = params.frequency;
+    state.targetAmplitude = params.amplitude;
+    state.targetPan = params.pan;
+    state.lastUsedTime = static_cast<float>(juce::Time::getMillisecondCounterHiRes());
+    
+    oscillators[index].setParameters(params);
+}
+
 void PaintEngine::releaseOscillator(int index)
 {
     if (index < 0 || index >= MAX_OSCILLATORS) return;
@@ -727,12 +990,22 @@ void PaintEngine::releaseOscillator(int index)
     // The envelope system will mark it as free when release is complete
 }
 
+bool PaintEngine::ownsPlaybackOscillator(const Stroke& stroke) const
+{
+    // Any later activation of the oscillator, including a steal, bumps its generation
+    const int index = stroke.getPlaybackOscillator();
+    if (index < 0 || index >= MAX_OSCILLATORS) return false;
+    
+    const auto& state = oscillatorStates[index];
+    return state.isActive() && state.generation == stroke.getPlaybackGeneration();
+}
+
 void PaintEngine::updateOscillatorWithInfluence(int oscillatorIndex, const StrokePoint& newPoint, const AudioParams& params)
 {
     if (oscillatorIndex < 0 || oscillatorIndex >= MAX_OSCILLATORS) return;
     
     auto& state = oscillatorStates[oscillatorIndex];
-    auto& osc = getBackBuffer()[oscillatorIndex];
+    auto& osc = oscillators[oscillatorIndex];
     
     if (!state.isActive()) return;
     
@@ -767,7 +1040,7 @@ float PaintEngine::calculateDistance(int oscillatorIndex, const Point& position)
     // For now, estimate oscillator position from its frequency
     // TODO: Store actual oscillator positions for accurate distance calculation
     
-    const auto& osc = getFrontBuffer()[oscillatorIndex];
+    const auto& osc = oscillators[oscillatorIndex];
     float oscY = frequencyToCanvasY(oscillatorStates[oscillatorIndex].targetFrequency);
     
     // Simple 2D distance in canvas space
@@ -809,44 +1082,4 @@ void PaintEngine::rebuildSpatialGrid()
     }
     
     DBG("SpectralCanvas: Rebuilt spatial grid with active oscillators");
-}
-
-//==============================================================================
-// RELIABILITY FIX: Lock-free buffer management implementation
-
-void PaintEngine::swapBuffersIfPending()
-{
-    // CRITICAL: Called from audio thread only - must be lock-free!
-    if (bufferSwapPending.load(std::memory_order_acquire))
-    {
-        // Swap the buffer indices atomically
-        int currentFront = frontBufferIndex.load(std::memory_order_relaxed);
-        int currentBack = backBufferIndex.load(std::memory_order_relaxed);
-        
-        // Perform the swap with memory barriers for reliability
-        std::atomic_thread_fence(std::memory_order_seq_cst);
-        frontBufferIndex.store(currentBack, std::memory_order_release);
-        backBufferIndex.store(currentFront, std::memory_order_release);
-        std::atomic_thread_fence(std::memory_order_seq_cst);
-        
-        // Clear the swap pending flag
-        bufferSwapPending.store(false, std::memory_order_release);
-        
-        DBG("PaintEngine: Buffer swap completed (audio thread)");
-    }
-}
-
-void PaintEngine::requestBufferSwap()
-{
-    // CRITICAL: Called from GUI thread to request buffer swap
-    // Only request if no swap is already pending to prevent conflicts
-    bool expected = false;
-    if (bufferSwapPending.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
-    {
-        DBG("PaintEngine: Buffer swap requested (GUI thread)");
-    }
-    else
-    {
-        DBG("PaintEngine: Buffer swap already pending, skipping request");
-    }
 }
\ No newline at end of file
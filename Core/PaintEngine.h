@@ -68,6 +68,17 @@ public:
               timestamp(juce::Time::getMillisecondCounter()) {}
     };
     
+    // Timestamped pen input, delivered once per audio block
+    struct PenEvent
+    {
+        enum class Type { Begin, Move, End, Clear };
+        
+        Type type = Type::Move;
+        StrokePoint point;
+        int sampleOffset = 0;         // Position of the event inside the block
+        double eventTimeMs = 0.0;     // High-resolution capture time
+    };
+    
     // Forward declarations
     class Stroke;
     class CanvasRegion;
@@ -81,7 +92,7 @@ public:
     
     // Audio processing lifecycle
     void prepareToPlay(double sampleRate, int samplesPerBlock);
-    void processBlock(juce::AudioBuffer<float>& buffer);
+    void processBlock(juce::AudioBuffer<float>& buffer, const PenEvent* penEvents = nullptr, int numPenEvents = 0);
     void releaseResources();
     
     // Stroke interaction API
@@ -89,6 +100,14 @@ public:
     void updateStroke(Point position, float pressure = 1.0f);
     void endStroke();
     
+    // Applies pen events immediately (when no audio is rendered for them)
+    void applyPenEvents(const PenEvent* penEvents, int numPenEvents);
+    
+    // Adds finished strokes built off the audio thread (e.g. by PartialTracker).
+    // Safe to call from the message thread; the audio thread places them on the
+    // canvas at the start of its next block
+    void addStrokes(const std::vector<std::vector<StrokePoint>>& strokes);
+    
     // Canvas control
     void setPlayheadPosition(float normalisedPosition);
     void setCanvasRegion(float leftX, float rightX, float bottomY, float topY);
@@ -111,6 +130,7 @@ public:
     // Performance monitoring
     float getCurrentCPULoad() const { return cpuLoad.load(); }
     int getActiveOscillatorCount() const { return activeOscillators.load(); }
+    static constexpr int getOscillatorBudget() { return MAX_OSCILLATORS; }
     
 private:
     //==============================================================================
@@ -173,10 +193,21 @@ private:
         const std::vector<StrokePoint>& getPoints() const { return points; }
         juce::uint32 getId() const { return strokeId; }
         
+        // Playback of finished strokes as the playhead crosses them
+        bool spansX(float x) const { return isFinalized && !points.empty() && x >= bounds.getX() && x <= bounds.getRight(); }
+        float getStartX() const { return bounds.getX(); }
+        StrokePoint getPointAtX(float x) const;
+        int getPlaybackOscillator() const { return playbackOscillator; }
+        juce::uint32 getPlaybackGeneration() const { return playbackGeneration; }
+        void setPlaybackOscillator(int index, juce::uint32 generation = 0) { playbackOscillator = index; playbackGeneration = generation; }
+    
     private:
         juce::uint32 strokeId;
         std::vector<StrokePoint> points;
         bool isFinalized = false;
+        bool isMonotonicX = true;        // Points run left to right, so lookups can bisect
+        int playbackOscillator = -1;
+        juce::uint32 playbackGeneration = 0; // Oscillator's activation count when this stroke took it
         
         // Cached bounds for optimization
         juce::Rectangle<float> bounds;
@@ -199,15 +230,27 @@ private:
         
         void addStroke(std::shared_ptr<Stroke> stroke);
         void removeStroke(juce::uint32 strokeId);
-        void updateOscillators(float currentTime, std::vector<Oscillator>& oscillatorPool);
         
-        bool isEmpty() const { return strokes.empty(); }
+        // Links a region built elsewhere after this one, so its strokes join
+        // without copying or allocating
+        void chain(std::unique_ptr<CanvasRegion> other);
+        
+        template <typename Callback>
+        void forEachStroke(Callback&& callback) const
+        {
+            for (auto* region = this; region != nullptr; region = region->next.get())
+                for (const auto& stroke : region->strokes)
+                    callback(*stroke);
+        }
+        
+        bool isEmpty() const;
         int getRegionX() const { return regionX; }
         int getRegionY() const { return regionY; }
         
     private:
         int regionX, regionY;
         std::vector<std::shared_ptr<Stroke>> strokes;
+        std::unique_ptr<CanvasRegion> next;
         
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CanvasRegion)
     };
@@ -236,21 +279,38 @@ private:
     float maxFrequency = 20000.0f;
     bool useLogFrequencyScale = true;
     
-    // RELIABILITY FIX: Lock-free double-buffered oscillator pool for performance
     static constexpr int MAX_OSCILLATORS = 1024;
     
-    // Double-buffered oscillator pools (front/back buffer)
-    std::array<std::vector<Oscillator>, 2> oscillatorPools;
-    std::atomic<int> frontBufferIndex{ 0 };  // Index of buffer being read by audio thread
-    std::atomic<int> backBufferIndex{ 1 };   // Index of buffer being written by GUI thread
-    std::atomic<bool> bufferSwapPending{ false };  // Signal for buffer swap
+    // Oscillator pool, indexed in step with oscillatorStates. Pen events and
+    // playback both reach it from processBlock(), so the audio thread owns it
+    std::vector<Oscillator> oscillators;
     
     // Stroke management
     std::unique_ptr<Stroke> currentStroke;
-    juce::uint32 nextStrokeId = 1;
-    
-    // Sparse canvas storage
-    std::unordered_map<juce::int64, std::unique_ptr<CanvasRegion>> canvasRegions;
+    std::atomic<juce::uint32> nextStrokeId{ 1 };
+    
+    using RegionMap = std::unordered_map<juce::int64, std::unique_ptr<CanvasRegion>>;
+    
+    // Regions built by addStrokes() as detached map nodes. The audio thread files
+    // them with a try-lock and leaves the spent nodes in retiredRegions, which
+    // the message thread frees on its next call
+    juce::CriticalSection pendingStrokeLock;
+    std::vector<RegionMap::node_type> pendingRegions;
+    std::vector<RegionMap::node_type> retiredRegions;
+    std::atomic<bool> hasPendingStrokes{ false };
+    
+    // Sparse canvas storage; buckets are reserved up front so filing a node never rehashes
+    static constexpr int RESERVED_REGIONS = 4096;
+    RegionMap canvasRegions;
+    
+    // Playback index over the stored strokes, sorted by left edge, and the strokes
+    // currently holding an oscillator. A block only visits strokes the playhead is
+    // inside or has just reached, however many are stored
+    static constexpr int RESERVED_PLAYBACK_STROKES = 8192;
+    std::vector<Stroke*> strokesByStart;
+    std::vector<Stroke*> soundingStrokes;
+    float lastPlayheadX = 0.0f;
+    bool rescanPlayback = true;
     
     // Audio processing
     juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> masterGain;
@@ -264,7 +324,16 @@ private:
     // Private Methods
     
     void updateCanvasOscillators();
+    void adoptPendingStrokes();
+    void playStoredStrokes(float currentTime);
+    bool playStroke(Stroke& stroke, float playheadX);
+    void indexStroke(Stroke& stroke);
+    void clearPlaybackIndex();
+    void applyPenEvent(const PenEvent& event);
+    void beginStroke(const StrokePoint& point);
+    void addStrokePoint(const StrokePoint& point);
     juce::int64 getRegionKey(int regionX, int regionY) const;
+    juce::Point<int> getRegionCoordinates(float canvasX, float canvasY) const;
     CanvasRegion* getOrCreateRegion(float canvasX, float canvasY);
     void cullInactiveRegions();
     
@@ -275,13 +344,6 @@ private:
     void updateCPULoad();
     void optimizeOscillatorPool();
     
-    // RELIABILITY FIX: Lock-free buffer management methods
-    std::vector<Oscillator>& getFrontBuffer() { return oscillatorPools[frontBufferIndex.load()]; }
-    const std::vector<Oscillator>& getFrontBuffer() const { return oscillatorPools[frontBufferIndex.load()]; }
-    std::vector<Oscillator>& getBackBuffer() { return oscillatorPools[backBufferIndex.load()]; }
-    void swapBuffersIfPending();  // Called from audio thread only
-    void requestBufferSwap();     // Called from GUI thread to request swap
-    
     // PHASE 1 OPTIMIZATIONS: Sub-10ms Latency Paint-to-Audio Pipeline
     
     // Spatial partitioning for efficient oscillator lookup
@@ -350,6 +412,7 @@ private:
     struct EnhancedOscillatorState {
         bool inUse = false;
         float lastUsedTime = 0.0f;
+        juce::uint32 generation = 0;    // Bumped on every activation, so a stolen oscillator is detectable
         
         // Envelope state for smooth activation/deactivation
         enum class EnvelopePhase { Inactive, Attack, Sustain, Release };
@@ -422,7 +485,9 @@ private:
     std::vector<int> freeOscillatorIndices;
     int findBestOscillatorForReplacement() const;
     void activateOscillator(int index, const AudioParams& params);
+    void retargetOscillator(int index, const AudioParams& params);
     void releaseOscillator(int index);
+    bool ownsPlaybackOscillator(const Stroke& stroke) const;
     
     // Oscillator allocation and influence calculations
     bool shouldAllocateNewOscillator(const StrokePoint& newPoint) const;
@@ -33,7 +33,11 @@ public:
         // Test 5: Audio processing
         if (!testAudioProcessing(engine))
             return false;
-            
+        
+        // Test 6: Playback of strokes added off the audio thread
+        if (!testAddedStrokePlayback(engine))
+            return false;
+        
         DBG("=== All PaintEngine tests passed! ===");
         return true;
     }
@@ -193,6 +197,91 @@ private:
         DBG("✓ Audio processing test passed");
         return true;
     }
+    
+    static bool testAddedStrokePlayback(PaintEngine& engine)
+    {
+        DBG("Testing added stroke playback...");
+        
+        engine.clearCanvas();
+        engine.setActive(true);
+        engine.setFrequencyRange(100.0f, 1000.0f);
+        
+        // One stroke across the whole canvas, rising two octaves from 220Hz
+        const float lowY = engine.frequencyToCanvasY(220.0f);
+        const float highY = engine.frequencyToCanvasY(880.0f);
+        
+        std::vector<std::vector<PaintEngine::StrokePoint>> strokes(1);
+        strokes[0].emplace_back(PaintEngine::Point(-100.0f, lowY), 0.8f, juce::Colours::white);
+        strokes[0].emplace_back(PaintEngine::Point(100.0f, highY), 0.8f, juce::Colours::white);
+        engine.addStrokes(strokes);
+        
+        // A quarter of the way along the stroke is one octave above its start...
+        const float firstFrequency = measureFrequency(engine, 0.25f);
+        if (std::abs(firstFrequency - 311.0f) > 15.0f)
+        {
+            DBG("FAIL: Added stroke should play near 311Hz at 0.25, got " << firstFrequency);
+            return false;
+        }
+        
+        // ...and the same oscillator follows it up to 622Hz at three quarters
+        const float secondFrequency = measureFrequency(engine, 0.75f);
+        if (std::abs(secondFrequency - 622.0f) > 15.0f)
+        {
+            DBG("FAIL: Added stroke should play near 622Hz at 0.75, got " << secondFrequency);
+            return false;
+        }
+        
+        engine.clearCanvas();
+        
+        DBG("✓ Added stroke playback test passed");
+        return true;
+    }
+    
+    // Renders a few blocks at the given playhead position and estimates the
+    // pitch of the output from its upward zero crossings
+    static float measureFrequency(PaintEngine& engine, float playheadPosition)
+    {
+        const double testSampleRate = 44100.0;
+        const int numSamples = 512;
+        const int numBlocks = 8;
+        juce::AudioBuffer<float> testBuffer(2, numSamples);
+        
+        engine.setPlayheadPosition(playheadPosition);
+        
+        // First block lets the oscillator settle on the new pitch
+        engine.processBlock(testBuffer);
+        
+        int crossings = 0;
+        int firstCrossing = -1;
+        int lastCrossing = -1;
+        float previous = testBuffer.getReadPointer(0)[numSamples - 1];
+        
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            engine.processBlock(testBuffer);
+            auto* channelData = testBuffer.getReadPointer(0);
+            
+            for (int sample = 0; sample < numSamples; ++sample)
+            {
+                if (previous <= 0.0f && channelData[sample] > 0.0f)
+                {
+                    const int position = block * numSamples + sample;
+                    if (firstCrossing < 0)
+                        firstCrossing = position;
+                    
+                    lastCrossing = position;
+                    ++crossings;
+                }
+                
+                previous = channelData[sample];
+            }
+        }
+        
+        if (crossings < 2)
+            return 0.0f;
+        
+        return static_cast<float>((crossings - 1) * testSampleRate / (lastCrossing - firstCrossing));
+    }
 };
 
 // Function to run tests (can be called from main application for validation)
@@ -0,0 +1,390 @@
+#include "PartialTracker.h"
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+// Construction
+
+PartialTracker::PartialTracker()
+{
+    formatManager.registerBasicFormats();
+}
+
+//==============================================================================
+// Message Thread
+
+void PartialTracker::startAnalysis(const juce::File& file, const Settings& settings)
+{
+    Job job;
+    job.file = file;
+    job.settings = settings;
+    job.settings.maxPartials = juce::jlimit(1, PaintEngine::getOscillatorBudget(), settings.maxPartials);
+    job.settings.maxStrokes = juce::jmax(1, settings.maxStrokes);
+    job.settings.maxGapFrames = juce::jmax(0, settings.maxGapFrames);
+    analysisJob.start(job);
+}
+
+void PartialTracker::cancel()
+{
+    analysisJob.cancel();
+}
+
+std::vector<std::vector<PaintEngine::StrokePoint>> PartialTracker::createStrokes(const Result& result,
+                                                                                  const PaintEngine& engine,
+                                                                                  float pointsPerSecond)
+{
+    std::vector<std::vector<PaintEngine::StrokePoint>> strokes;
+    if (result.lengthSeconds <= 0.0)
+        return strokes;
+    
+    float loudest = 0.0f;
+    for (const auto& partial : result.partials)
+        for (const auto& point : partial.points)
+            loudest = juce::jmax(loudest, point.amplitude);
+    
+    const float pressureScale = loudest > 0.0f ? 1.0f / loudest : 0.0f;
+    const float step = 1.0f / juce::jmax(1.0f, pointsPerSecond);
+    
+    const auto toStrokePoint = [&](const TrackPoint& point)
+    {
+        const PaintEngine::Point position(engine.timeToCanvasX((float)(point.time / result.lengthSeconds)),
+                                          engine.frequencyToCanvasY(point.frequency));
+        
+        // PaintEngine reads pan from the hue; stop short of 1.0, which wraps to 0.0
+        return PaintEngine::StrokePoint(position, juce::jlimit(0.0f, 1.0f, point.amplitude * pressureScale),
+                                        juce::Colour::fromHSV(juce::jlimit(0.0f, 0.999f, point.pan), 0.6f, 1.0f, 1.0f));
+    };
+    
+    strokes.reserve(result.partials.size());
+    
+    for (const auto& partial : result.partials)
+    {
+        const auto& points = partial.points;
+        if (points.size() < 2)
+            continue;
+        
+        auto& stroke = strokes.emplace_back();
+        const float startTime = points.front().time;
+        const float endTime = points.back().time;
+        size_t segment = 0;
+        
+        // Resample the trajectory at a fixed rate; the last point is always kept
+        for (int i = 0;; ++i)
+        {
+            const float time = startTime + (float)i * step;
+            if (time >= endTime)
+                break;
+            
+            while (segment + 2 < points.size() && points[segment + 1].time < time)
+                ++segment;
+            
+            const auto& a = points[segment];
+            const auto& b = points[segment + 1];
+            const float t = juce::jlimit(0.0f, 1.0f, (time - a.time) / juce::jmax(1.0e-6f, b.time - a.time));
+            
+            TrackPoint point;
+            point.time = time;
+            point.frequency = a.frequency + (b.frequency - a.frequency) * t;
+            point.amplitude = a.amplitude + (b.amplitude - a.amplitude) * t;
+            point.pan = a.pan + (b.pan - a.pan) * t;
+            stroke.push_back(toStrokePoint(point));
+        }
+        
+        stroke.push_back(toStrokePoint(points.back()));
+    }
+    
+    return strokes;
+}
+
+//==============================================================================
+// Analysis Thread
+
+std::shared_ptr<PartialTracker::Result> PartialTracker::analyse(const Job& job)
+{
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(job.file));
+    if (reader == nullptr || reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0)
+        return nullptr;
+    
+    std::vector<std::vector<Peak>> frames;
+    if (!pickAllPeaks(*reader, frames, job))
+        return nullptr;
+    
+    auto result = std::make_shared<Result>();
+    result->sourceFile = job.file;
+    result->lengthSeconds = (double)reader->lengthInSamples / reader->sampleRate;
+    
+    if (!trackPartials(frames, reader->sampleRate, job, result->partials))
+        return nullptr;
+    
+    return result;
+}
+
+//==============================================================================
+// Peak Picking
+
+bool PartialTracker::pickAllPeaks(juce::AudioFormatReader& reader, std::vector<std::vector<Peak>>& frames,
+                                  const Job& job)
+{
+    // Frame f is centred on sample f * HOP_SIZE
+    const int numFrames = (int)(reader.lengthInSamples / HOP_SIZE) + 1;
+    frames.resize((size_t)numFrames);
+    
+    const int numChannels = reader.numChannels > 1 ? 2 : 1;
+    const int maxChunksInFlight = analysisJob.getPool().getNumThreads() * 2;
+    const double sampleRate = reader.sampleRate;
+    
+    std::atomic<int> chunksInFlight{0};
+    std::atomic<int> framesDone{0};
+    juce::WaitableEvent chunkFinished;
+    
+    // Reading stays sequential on this thread; each chunk's frames are picked on the pool
+    for (int firstFrame = 0; firstFrame < numFrames && !analysisJob.isCancelled(job); firstFrame += FRAMES_PER_CHUNK)
+    {
+        // Bound the audio held in memory by waiting for the pool to catch up
+        while (chunksInFlight.load() >= maxChunksInFlight && !analysisJob.isCancelled(job))
+            chunkFinished.wait(50);
+        
+        const int endFrame = juce::jmin(numFrames, firstFrame + FRAMES_PER_CHUNK);
+        const auto startSample = (juce::int64)firstFrame * HOP_SIZE - FFT_SIZE / 2;
+        const int numSamples = (endFrame - 1 - firstFrame) * HOP_SIZE + FFT_SIZE;
+        
+        // Samples outside the file read back as silence
+        auto audio = std::make_shared<juce::AudioBuffer<float>>(numChannels, numSamples);
+        reader.read(audio.get(), 0, numSamples, startSample, true, numChannels > 1);
+        
+        ++chunksInFlight;
+        analysisJob.getPool().addJob([this, &frames, &job, &chunksInFlight, &framesDone, &chunkFinished,
+                         audio, sampleRate, firstFrame, endFrame, numFrames]
+        {
+            if (!analysisJob.isCancelled(job))
+            {
+                juce::dsp::FFT fft(FFT_ORDER);
+                std::vector<float> scratch;
+                
+                for (int frame = firstFrame; frame < endFrame; ++frame)
+                    pickPeaks(*audio, (frame - firstFrame) * HOP_SIZE, fft, scratch, sampleRate, job.settings,
+                              frames[(size_t)frame]);
+                
+                // Tracking takes the rest
+                const int done = framesDone += endFrame - firstFrame;
+                analysisJob.setProgress(0.8f * (float)done / (float)numFrames);
+            }
+            
+            --chunksInFlight;
+            chunkFinished.signal();
+        });
+    }
+    
+    // Jobs reference this frame's locals, so they must all finish even when cancelled
+    while (chunksInFlight.load() > 0)
+        chunkFinished.wait(50);
+    
+    return !analysisJob.isCancelled(job);
+}
+
+void PartialTracker::pickPeaks(const juce::AudioBuffer<float>& audio, int offset, juce::dsp::FFT& fft,
+                               std::vector<float>& scratch, double sampleRate, const Settings& settings,
+                               std::vector<Peak>& peaks) const
+{
+    const int numBins = FFT_SIZE / 2 + 1;
+    const int numChannels = audio.getNumChannels();
+    
+    // Scratch holds the transform buffer followed by each channel's magnitudes
+    scratch.resize((size_t)FFT_SIZE * 2 + (size_t)numBins * 2);
+    float* fftData = scratch.data();
+    float* magnitudes[2] = { fftData + FFT_SIZE * 2, fftData + FFT_SIZE * 2 + numBins };
+    
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        std::fill(fftData, fftData + FFT_SIZE * 2, 0.0f);
+        juce::FloatVectorOperations::copy(fftData, audio.getReadPointer(channel, offset), FFT_SIZE);
+        
+        window.multiplyWithWindowingTable(fftData, static_cast<size_t>(FFT_SIZE));
+        fft.performFrequencyOnlyForwardTransform(fftData);
+        juce::FloatVectorOperations::copy(magnitudes[channel], fftData, numBins);
+    }
+    
+    // Stereo peaks are picked on the mean magnitude; the channel ratio gives the pan
+    const float* combined = magnitudes[0];
+    if (numChannels > 1)
+    {
+        for (int bin = 0; bin < numBins; ++bin)
+            fftData[bin] = 0.5f * (magnitudes[0][bin] + magnitudes[1][bin]);
+        
+        combined = fftData;
+    }
+    
+    // A Hann-windowed sine of amplitude A peaks at A * FFT_SIZE / 4
+    const float amplitudeScale = 4.0f / (float)FFT_SIZE;
+    const float thresholdMagnitude = juce::Decibels::decibelsToGain(settings.thresholdDb) / amplitudeScale;
+    const float binHz = (float)(sampleRate / FFT_SIZE);
+    const int firstBin = juce::jmax(1, (int)std::floor(settings.minHz / binHz));
+    const int lastBin = juce::jmin(numBins - 2, (int)std::ceil(settings.maxHz / binHz));
+    
+    const auto toDecibels = [](float magnitude) { return 20.0f * std::log10(juce::jmax(1.0e-9f, magnitude)); };
+    
+    peaks.clear();
+    
+    for (int bin = firstBin; bin <= lastBin; ++bin)
+    {
+        const float magnitude = combined[bin];
+        if (magnitude <= thresholdMagnitude || magnitude <= combined[bin - 1] || magnitude < combined[bin + 1])
+            continue;
+        
+        // Parabolic interpolation on the log spectrum refines frequency and level
+        const float below = toDecibels(combined[bin - 1]);
+        const float centre = toDecibels(magnitude);
+        const float above = toDecibels(combined[bin + 1]);
+        const float curvature = below - 2.0f * centre + above;
+        const float shift = curvature < 0.0f ? juce::jlimit(-0.5f, 0.5f, 0.5f * (below - above) / curvature) : 0.0f;
+        
+        Peak peak;
+        peak.frequency = ((float)bin + shift) * binHz;
+        peak.amplitude = juce::Decibels::decibelsToGain(centre - 0.25f * (below - above) * shift) * amplitudeScale;
+        
+        if (numChannels > 1)
+        {
+            const float total = magnitudes[0][bin] + magnitudes[1][bin];
+            peak.pan = total > 0.0f ? magnitudes[1][bin] / total : 0.5f;
+        }
+        
+        peaks.push_back(peak);
+    }
+    
+    // Loudest first, which is also the order new partials are started in
+    std::sort(peaks.begin(), peaks.end(), [](const Peak& a, const Peak& b) { return a.amplitude > b.amplitude; });
+    if ((int)peaks.size() > settings.maxPartials)
+        peaks.resize((size_t)settings.maxPartials);
+}
+
+//==============================================================================
+// Tracking
+
+bool PartialTracker::trackPartials(const std::vector<std::vector<Peak>>& frames, double sampleRate,
+                                   const Job& job, std::vector<Partial>& partials)
+{
+    struct LiveTrack
+    {
+        size_t partialIndex = 0;
+        float frequency = 0.0f;
+        int missedFrames = 0;
+    };
+    
+    struct Candidate
+    {
+        float cents = 0.0f;
+        int track = 0;
+        int peak = 0;
+    };
+    
+    const auto& settings = job.settings;
+    const float hopSeconds = (float)(HOP_SIZE / sampleRate);
+    const float maxRatio = std::exp2(settings.maxDeviationCents / 1200.0f);
+    const int numFrames = (int)frames.size();
+    
+    std::vector<Partial> allPartials;
+    std::vector<LiveTrack> live;
+    std::vector<Candidate> candidates;
+    std::vector<int> byFrequency;
+    std::vector<bool> peakTaken;
+    std::vector<bool> trackMatched;
+    
+    for (int frame = 0; frame < numFrames; ++frame)
+    {
+        if (frame % FRAMES_PER_CHUNK == 0)
+        {
+            if (analysisJob.isCancelled(job))
+                return false;
+            
+            analysisJob.setProgress(0.8f + 0.2f * (float)frame / (float)numFrames);
+        }
+        
+        const auto& peaks = frames[(size_t)frame];
+        const float time = (float)frame * hopSeconds;
+        
+        const auto addPoint = [&](Partial& partial, const Peak& peak)
+        {
+            partial.points.push_back({ time, peak.frequency, peak.amplitude, peak.pan });
+        };
+        
+        // Every track/peak pairing within the allowed glide, closest first
+        byFrequency.resize(peaks.size());
+        for (size_t i = 0; i < peaks.size(); ++i)
+            byFrequency[i] = (int)i;
+        
+        std::sort(byFrequency.begin(), byFrequency.end(),
+                  [&](int a, int b) { return peaks[(size_t)a].frequency < peaks[(size_t)b].frequency; });
+        
+        candidates.clear();
+        for (int track = 0; track < (int)live.size(); ++track)
+        {
+            const float frequency = live[(size_t)track].frequency;
+            auto it = std::lower_bound(byFrequency.begin(), byFrequency.end(), frequency / maxRatio,
+                                       [&](int index, float value) { return peaks[(size_t)index].frequency < value; });
+            
+            for (; it != byFrequency.end() && peaks[(size_t)*it].frequency <= frequency * maxRatio; ++it)
+                candidates.push_back({ 1200.0f * std::abs(std::log2(peaks[(size_t)*it].frequency / frequency)), track, *it });
+        }
+        
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Candidate& a, const Candidate& b) { return a.cents < b.cents; });
+        
+        // Greedy matching: each track continues with at most one peak and vice versa
+        peakTaken.assign(peaks.size(), false);
+        trackMatched.assign(live.size(), false);
+        
+        for (const auto& candidate : candidates)
+        {
+            if (trackMatched[(size_t)candidate.track] || peakTaken[(size_t)candidate.peak])
+                continue;
+            
+            auto& track = live[(size_t)candidate.track];
+            const auto& peak = peaks[(size_t)candidate.peak];
+            addPoint(allPartials[track.partialIndex], peak);
+            
+            track.frequency = peak.frequency;
+            track.missedFrames = 0;
+            trackMatched[(size_t)candidate.track] = true;
+            peakTaken[(size_t)candidate.peak] = true;
+        }
+        
+        // Unmatched tracks survive a short gap, then die
+        size_t numLive = 0;
+        for (size_t i = 0; i < live.size(); ++i)
+        {
+            if (trackMatched[i] || ++live[i].missedFrames <= settings.maxGapFrames)
+                live[numLive++] = live[i];
+        }
+        live.resize(numLive);
+        
+        // Leftover peaks are born as new partials while the budget allows
+        for (size_t i = 0; i < peaks.size() && (int)live.size() < settings.maxPartials; ++i)
+        {
+            if (peakTaken[i])
+                continue;
+            
+            allPartials.emplace_back();
+            addPoint(allPartials.back(), peaks[i]);
+            live.push_back({ allPartials.size() - 1, peaks[i].frequency, 0 });
+        }
+    }
+    
+    // Keep partials long enough to hear, strongest first
+    for (auto& partial : allPartials)
+    {
+        if (partial.points.size() < 2
+            || partial.points.back().time - partial.points.front().time < settings.minDurationSeconds)
+            continue;
+        
+        for (const auto& point : partial.points)
+            partial.energy += point.amplitude * hopSeconds;
+        
+        partials.push_back(std::move(partial));
+    }
+    
+    std::sort(partials.begin(), partials.end(), [](const Partial& a, const Partial& b) { return a.energy > b.energy; });
+    if ((int)partials.size() > settings.maxStrokes)
+        partials.resize((size_t)settings.maxStrokes);
+    
+    return true;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "PaintEngine.h"
+#include "BackgroundJob.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * PartialTracker - Resynthesises a sample as editable PaintEngine strokes
+ *
+ * Front end: the file is streamed in chunks and every STFT frame is
+ * peak-picked on a thread pool (local maxima above a threshold, refined by
+ * parabolic interpolation, loudest maxPartials kept per frame).
+ *
+ * Back end: McAulay-Quatieri style tracking links peaks frame to frame by
+ * closest pitch within maxDeviationCents; partials may skip maxGapFrames
+ * before they die, and unmatched peaks start new ones while fewer than
+ * maxPartials are alive. Short partials are dropped and the strongest
+ * maxStrokes are kept, so playback never needs more than maxPartials
+ * oscillators at once.
+ *
+ * createStrokes() maps the trajectories onto the canvas at a chosen point
+ * density, ready for PaintEngine::addStrokes().
+ */
+class PartialTracker
+{
+public:
+    struct Settings
+    {
+        int maxPartials = 128;              // Concurrent partials; capped at the engine's oscillator budget
+        int maxStrokes = 512;               // Partials kept overall, strongest first
+        float thresholdDb = -70.0f;         // Peaks quieter than this (dBFS) are ignored
+        float maxDeviationCents = 70.0f;    // Largest frame-to-frame glide a partial follows
+        int maxGapFrames = 2;               // Frames a partial may go unmatched before it ends
+        float minDurationSeconds = 0.05f;
+        float minHz = 20.0f;
+        float maxHz = 20000.0f;
+    };
+    
+    struct TrackPoint
+    {
+        float time = 0.0f;          // Seconds from the start of the file
+        float frequency = 0.0f;
+        float amplitude = 0.0f;     // Linear sine amplitude
+        float pan = 0.5f;           // 0.0 = left, 1.0 = right
+    };
+    
+    struct Partial
+    {
+        std::vector<TrackPoint> points;
+        float energy = 0.0f;        // Amplitude integrated over time, used for ranking
+    };
+    
+    struct Result
+    {
+        juce::File sourceFile;
+        double lengthSeconds = 0.0;
+        std::vector<Partial> partials;
+    };
+    
+    static constexpr int FFT_ORDER = 11;
+    static constexpr int FFT_SIZE = 1 << FFT_ORDER;
+    static constexpr int HOP_SIZE = FFT_SIZE / 4;
+    
+    PartialTracker();
+    
+    //==============================================================================
+    // Message thread
+    
+    void startAnalysis(const juce::File& file, const Settings& settings);
+    void cancel();
+    
+    bool isAnalysing() const { return analysisJob.isBusy(); }
+    float getProgress() const { return analysisJob.getProgress(); }
+    
+    // Finished analysis, handed over once; nullptr until then
+    std::shared_ptr<const Result> takeResult() { return analysisJob.takeResult(); }
+    
+    // Canvas strokes resampled to pointsPerSecond; pressure is amplitude relative
+    // to the loudest point and the colour's hue carries pan
+    static std::vector<std::vector<PaintEngine::StrokePoint>> createStrokes(const Result& result,
+                                                                            const PaintEngine& engine,
+                                                                            float pointsPerSecond = 40.0f);
+
+private:
+    static constexpr int FRAMES_PER_CHUNK = 256;
+    
+    struct Job
+    {
+        juce::File file;
+        Settings settings;
+        juce::uint32 generation = 0;
+    };
+    
+    struct Peak
+    {
+        float frequency = 0.0f;
+        float amplitude = 0.0f;
+        float pan = 0.5f;
+    };
+    
+    std::shared_ptr<Result> analyse(const Job& job);
+    bool pickAllPeaks(juce::AudioFormatReader& reader, std::vector<std::vector<Peak>>& frames, const Job& job);
+    void pickPeaks(const juce::AudioBuffer<float>& audio, int offset, juce::dsp::FFT& fft,
+                   std::vector<float>& scratch, double sampleRate, const Settings& settings,
+                   std::vector<Peak>& peaks) const;
+    bool trackPartials(const std::vector<std::vector<Peak>>& frames, double sampleRate, const Job& job,
+                       std::vector<Partial>& partials);
+    
+    juce::AudioFormatManager formatManager;
+    juce::dsp::WindowingFunction<float> window{static_cast<size_t>(FFT_SIZE), juce::dsp::WindowingFunction<float>::hann};
+    
+    BackgroundJob<Job, Result> analysisJob{ "Partial Tracker", [this](const Job& job) { return analyse(job); } };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PartialTracker)
+};
@@ -0,0 +1,194 @@
+#include "PenInputPipeline.h"
+#include <cmath>
+
+//==============================================================================
+// Message Thread
+
+bool PenInputPipeline::pushBegin(PaintEngine::Point position, float pressure, juce::Colour colour)
+{
+    RawEvent event;
+    event.type = PaintEngine::PenEvent::Type::Begin;
+    event.position = position;
+    event.pressure = pressure;
+    event.colourARGB = colour.getARGB();
+    
+    // Moves must never land on the previous stroke, so a lost Begin drops the whole stroke
+    strokeDropped = !flushPendingEnd() || !push(event, 0);
+    return !strokeDropped;
+}
+
+bool PenInputPipeline::pushMove(PaintEngine::Point position, float pressure)
+{
+    if (strokeDropped)
+    {
+        ++droppedEvents;
+        return false;
+    }
+    
+    RawEvent event;
+    event.type = PaintEngine::PenEvent::Type::Move;
+    event.position = position;
+    event.pressure = pressure;
+    return push(event, RESERVED_SLOTS);
+}
+
+bool PenInputPipeline::pushEnd()
+{
+    if (strokeDropped)
+    {
+        strokeDropped = false;
+        ++droppedEvents;
+        return false;
+    }
+    
+    RawEvent event;
+    event.type = PaintEngine::PenEvent::Type::End;
+    
+    // Keep the End until it fits, otherwise the engine's stroke would stay open
+    endPending = !push(event, 0);
+    return !endPending;
+}
+
+bool PenInputPipeline::pushClear()
+{
+    RawEvent event;
+    event.type = PaintEngine::PenEvent::Type::Clear;
+    return flushPendingEnd() && push(event, 0);
+}
+
+bool PenInputPipeline::flushPendingEnd()
+{
+    if (endPending)
+    {
+        RawEvent event;
+        event.type = PaintEngine::PenEvent::Type::End;
+        endPending = !push(event, 0);
+    }
+    
+    return !endPending;
+}
+
+bool PenInputPipeline::push(const RawEvent& event, int reservedSlots)
+{
+    if (fifo.getFreeSpace() <= reservedSlots)
+    {
+        // Ring full - drop rather than block the message thread
+        ++droppedEvents;
+        return false;
+    }
+    
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(1, start1, size1, start2, size2);
+    
+    auto& slot = ring[static_cast<size_t>(size1 > 0 ? start1 : start2)];
+    slot = event;
+    slot.timeMs = juce::Time::getMillisecondCounterHiRes();
+    
+    fifo.finishedWrite(1);
+    return true;
+}
+
+//==============================================================================
+// Audio Thread
+
+void PenInputPipeline::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    hasLastEvent = false;
+    smoothedVelocity = 0.0f;
+    mergedMoves = 0;
+}
+
+int PenInputPipeline::collectBlock(int numSamples, PaintEngine::PenEvent* destination, int maxEvents)
+{
+    const int numReady = fifo.getNumReady();
+    if (numReady == 0 || numSamples <= 0 || maxEvents <= 0)
+        return 0;
+    
+    // Events are placed one block late, at their position within the previous
+    // block's wall-clock window, so the spacing between them is preserved
+    const double samplesPerMs = sampleRate / 1000.0;
+    const double windowStartMs = juce::Time::getMillisecondCounterHiRes() - numSamples / samplesPerMs;
+    
+    int numEvents = 0;
+    int consumed = 0;
+    
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(numReady, start1, size1, start2, size2);
+    
+    const auto processRange = [&](int start, int size)
+    {
+        for (int i = 0; i < size; ++i)
+        {
+            const auto& raw = ring[static_cast<size_t>(start + i)];
+            
+            // When the batch is full only moves can still be merged; the rest waits
+            const bool canMerge = raw.type == PaintEngine::PenEvent::Type::Move && numEvents > 0
+                               && destination[numEvents - 1].type == PaintEngine::PenEvent::Type::Move;
+            if (numEvents == maxEvents && !canMerge)
+                return false;
+            
+            const int sampleOffset = juce::jlimit(0, numSamples - 1,
+                                                  static_cast<int>((raw.timeMs - windowStartMs) * samplesPerMs));
+            appendEvent(raw, sampleOffset, destination, numEvents, maxEvents);
+            ++consumed;
+        }
+        return true;
+    };
+    
+    if (processRange(start1, size1))
+        processRange(start2, size2);
+    
+    fifo.finishedRead(consumed);
+    return numEvents;
+}
+
+void PenInputPipeline::appendEvent(const RawEvent& raw, int sampleOffset, PaintEngine::PenEvent* destination,
+                                   int& numEvents, int maxEvents)
+{
+    using Type = PaintEngine::PenEvent::Type;
+    
+    if (raw.type == Type::Begin)
+    {
+        strokeColour = juce::Colour(raw.colourARGB);
+        smoothedVelocity = 0.0f;
+    }
+    else if (raw.type == Type::Move && hasLastEvent)
+    {
+        // Velocity in canvas units per second from the exact capture times
+        const double elapsedMs = juce::jmax(0.25, raw.timeMs - lastEvent.timeMs);
+        const float dx = raw.position.x - lastEvent.position.x;
+        const float dy = raw.position.y - lastEvent.position.y;
+        const float velocity = std::sqrt(dx * dx + dy * dy) * 1000.0f / static_cast<float>(elapsedMs);
+        smoothedVelocity += 0.5f * (velocity - smoothedVelocity);
+    }
+    
+    lastEvent = raw;
+    hasLastEvent = raw.type == Type::Begin || raw.type == Type::Move;
+    
+    // Fold moves that land close to the previous delivered move into it
+    if (raw.type == Type::Move && numEvents > 0)
+    {
+        auto& previous = destination[numEvents - 1];
+        if (previous.type == Type::Move
+            && (sampleOffset - previous.sampleOffset < MIN_EVENT_SPACING || numEvents == maxEvents))
+        {
+            ++mergedMoves;
+            previous.point.position = raw.position;
+            previous.point.pressure += (raw.pressure - previous.point.pressure) / static_cast<float>(mergedMoves + 1);
+            previous.point.velocity = smoothedVelocity;
+            previous.point.timestamp = static_cast<juce::uint32>(raw.timeMs);
+            previous.eventTimeMs = raw.timeMs;
+            return;
+        }
+    }
+    
+    auto& event = destination[numEvents++];
+    event.type = raw.type;
+    event.sampleOffset = sampleOffset;
+    event.eventTimeMs = raw.timeMs;
+    event.point = PaintEngine::StrokePoint(raw.position, raw.pressure, strokeColour);
+    event.point.velocity = smoothedVelocity;
+    event.point.timestamp = static_cast<juce::uint32>(raw.timeMs);
+    mergedMoves = 0;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "PaintEngine.h"
+#include <array>
+#include <atomic>
+
+/**
+ * Coalescing pen input pipeline between the canvas and the PaintEngine
+ *
+ * The message thread timestamps raw pen events with the high-resolution
+ * clock and pushes them into a lock-free ring. Once per audio block the
+ * audio thread drains the ring into a packed batch of PaintEngine::PenEvents:
+ * - Moves landing within MIN_EVENT_SPACING samples of each other are merged
+ * - Pressure is averaged over merged events, velocity is derived from the
+ *   exact timestamps and smoothed
+ * - Each event gets a sample offset preserving its capture timing, placed
+ *   one block late so the spacing between events is kept exactly
+ *
+ * When the ring fills up only moves are dropped: the last RESERVED_SLOTS are
+ * kept for Begin/End/Clear, a stroke whose Begin was lost is dropped whole,
+ * and a lost End is delivered ahead of the next Begin or Clear. Clears travel
+ * through the same ring so they can't overtake pen events still queued.
+ *
+ * This replaces one Command per mouse event with one batch per block.
+ */
+class PenInputPipeline
+{
+public:
+    static constexpr int RING_SIZE = 2048;              // Raw events buffered between blocks
+    static constexpr int MAX_EVENTS_PER_BLOCK = 256;    // Packed events delivered per block
+    static constexpr int MIN_EVENT_SPACING = 32;        // Samples between delivered moves
+    static constexpr int RESERVED_SLOTS = 64;           // Ring space moves may not use
+    
+    PenInputPipeline() = default;
+    
+    //==============================================================================
+    // Message thread
+    
+    bool pushBegin(PaintEngine::Point position, float pressure, juce::Colour colour);
+    bool pushMove(PaintEngine::Point position, float pressure);
+    bool pushEnd();
+    
+    // Clears the canvas after everything already queued; false if the ring is full
+    bool pushClear();
+    
+    int getNumDroppedEvents() const { return droppedEvents.load(); }
+    
+    //==============================================================================
+    // Audio thread
+    
+    void prepare(double sampleRate);
+    
+    // Drains queued events into destination; returns the number written
+    int collectBlock(int numSamples, PaintEngine::PenEvent* destination, int maxEvents);
+
+private:
+    struct RawEvent
+    {
+        PaintEngine::PenEvent::Type type = PaintEngine::PenEvent::Type::Move;
+        PaintEngine::Point position;
+        float pressure = 1.0f;
+        juce::uint32 colourARGB = 0;
+        double timeMs = 0.0;
+    };
+    
+    bool push(const RawEvent& event, int reservedSlots);
+    bool flushPendingEnd();
+    void appendEvent(const RawEvent& raw, int sampleOffset, PaintEngine::PenEvent* destination,
+                     int& numEvents, int maxEvents);
+    
+    // Lock-free ring (message thread writes, audio thread reads)
+    juce::AbstractFifo fifo{RING_SIZE};
+    std::array<RawEvent, RING_SIZE> ring;
+    std::atomic<int> droppedEvents{0};
+    
+    // Message thread state
+    bool strokeDropped = false;           // Begin was lost; the rest of the stroke goes too
+    bool endPending = false;              // End was lost; sent before the next Begin/Clear
+    
+    // Audio thread state
+    double sampleRate = 44100.0;
+    RawEvent lastEvent;
+    bool hasLastEvent = false;
+    float smoothedVelocity = 0.0f;
+    juce::Colour strokeColour;
+    int mergedMoves = 0;                  // Raw moves folded into the last delivered event
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PenInputPipeline)
+};
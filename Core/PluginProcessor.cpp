@@ -20,13 +20,20 @@ ARTEFACTAudioProcessor::ARTEFACTAudioProcessor()
     apvts.addParameterListener("masterGain", this);
     apvts.addParameterListener("paintActive", this);
     apvts.addParameterListener("processingMode", this);
+    apvts.addParameterListener("processingQuality", this);
+    apvts.addParameterListener("renderQualityOffline", this);
+    apvts.addParameterListener("enhancementActive", this);
 }
 
 ARTEFACTAudioProcessor::~ARTEFACTAudioProcessor()
 {
+    cancelPendingUpdate();
     apvts.removeParameterListener("masterGain", this);
     apvts.removeParameterListener("paintActive", this);
     apvts.removeParameterListener("processingMode", this);
+    apvts.removeParameterListener("processingQuality", this);
+    apvts.removeParameterListener("renderQualityOffline", this);
+    apvts.removeParameterListener("enhancementActive", this);
 }
 
 //==============================================================================
@@ -40,7 +47,16 @@ void ARTEFACTAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBloc
     forgeProcessor.prepareToPlay(sampleRate, samplesPerBlock);
     paintEngine.prepareToPlay(sampleRate, samplesPerBlock);
     sampleMaskingEngine.prepareToPlay(sampleRate, samplesPerBlock, 2); // Stereo
+    canvasProcessor.prepareToPlay(sampleRate, samplesPerBlock);
+    canvasProcessor.setActive(true);  // Silent until the canvas panel imports an image
+    canvasBuffer.setSize(getTotalNumOutputChannels(), samplesPerBlock);
     audioRecorder.prepareToPlay(sampleRate, samplesPerBlock);
+    penInputPipeline.prepare(sampleRate);
+    
+    // Both quality tiers are prepared up front; switching between them never allocates
+    secretSauceEngine.prepareToPlay(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    audityFilter.prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    updateProcessingQuality();
     
     // Set default active state based on current mode - START DISABLED to prevent feedback
     paintEngine.setActive(false);  // User must explicitly enable to prevent feedback loops
@@ -51,6 +67,7 @@ void ARTEFACTAudioProcessor::releaseResources()
     paintEngine.releaseResources();
     sampleMaskingEngine.releaseResources();
     audioRecorder.releaseResources();
+    secretSauceEngine.releaseResources();
     // Note: ForgeProcessor doesn't have releaseResources() method yet
 }
 
@@ -74,6 +91,19 @@ juce::AudioProcessorValueTreeState::ParameterLayout ARTEFACTAudioProcessor::crea
         "processingMode", "Processing Mode", 
         juce::StringArray{"Forge", "Canvas", "Hybrid"}, 1));
     
+    // Processing quality tier - default to Live (index 1)
+    parameters.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "processingQuality", "Processing Quality",
+        getProcessingQualityNames(), 1));
+    
+    // Bounce at Render quality whenever the host renders offline
+    parameters.push_back(std::make_unique<juce::AudioParameterBool>(
+        "renderQualityOffline", "Render Quality When Bouncing", true));
+    
+    // Master enhancement stage (SecretSauce + Audity filter) - off by default
+    parameters.push_back(std::make_unique<juce::AudioParameterBool>(
+        "enhancementActive", "Enhancement", false));
+    
     return { parameters.begin(), parameters.end() };
 }
 
@@ -97,6 +127,70 @@ void ARTEFACTAudioProcessor::parameterChanged(const juce::String& parameterID, f
                               currentMode == ProcessingMode::Hybrid);
         paintEngine.setActive(shouldBeActive);
     }
+    else if (parameterID == "processingQuality")
+    {
+        selectedQuality.store(static_cast<ProcessingQuality>(static_cast<int>(newValue)));
+        updateProcessingQuality();
+    }
+    else if (parameterID == "renderQualityOffline")
+    {
+        renderQualityWhenOffline.store(newValue > 0.5f);
+        updateProcessingQuality();
+    }
+    else if (parameterID == "enhancementActive")
+    {
+        enhancementActive.store(newValue > 0.5f);
+        updateProcessingQuality();
+    }
+}
+
+void ARTEFACTAudioProcessor::setNonRealtime(bool isNonRealtime) noexcept
+{
+    AudioProcessor::setNonRealtime(isNonRealtime);
+    updateProcessingQuality();
+}
+
+void ARTEFACTAudioProcessor::updateProcessingQuality()
+{
+    // An offline bounce switches to Render (when enabled) so patches bounce at full
+    // quality without being edited
+    const auto quality = (isNonRealtime() && renderQualityWhenOffline.load()) ? ProcessingQuality::Render
+                                                                              : selectedQuality.load();
+    const bool changed = effectiveQuality.exchange(quality) != quality;
+    
+    secretSauceEngine.setProcessingQuality(quality);
+    audityFilter.setProcessingQuality(quality);
+    
+    // Time-stretch quality follows the tier
+    if (changed)
+    {
+        switch (quality)
+        {
+            case ProcessingQuality::Eco:    sampleMaskingEngine.setTimeStretchQuality(0.4f); break;
+            case ProcessingQuality::Live:   sampleMaskingEngine.setTimeStretchQuality(0.8f); break;
+            case ProcessingQuality::Render: sampleMaskingEngine.setTimeStretchQuality(1.0f); break;
+        }
+    }
+    
+    // Render's oversamplers delay the output; report it so the host compensates.
+    // parameterChanged can run on the audio thread, so anywhere but the message
+    // thread the change is posted rather than made in place
+    const int latency = enhancementActive.load() ? secretSauceEngine.getLatencySamples(quality)
+                                                   + audityFilter.getLatencySamples(quality)
+                                                 : 0;
+    pendingLatencySamples.store(latency);
+    
+    if (juce::MessageManager::existsAndIsCurrentThread())
+        handleAsyncUpdate();
+    else
+        triggerAsyncUpdate();
+}
+
+void ARTEFACTAudioProcessor::handleAsyncUpdate()
+{
+    const int latency = pendingLatencySamples.load();
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
 }
 
 //==============================================================================
@@ -355,6 +449,7 @@ void ARTEFACTAudioProcessor::processPaintCommand(const Command& cmd)
         break;
     case PaintCommandID::SetPlayheadPosition:
         paintEngine.setPlayheadPosition(cmd.floatParam);
+        canvasProcessor.setPlayheadPosition(cmd.floatParam);
         break;
     case PaintCommandID::SetPaintActive:
         paintEngine.setActive(cmd.boolParam);
@@ -394,6 +489,14 @@ void ARTEFACTAudioProcessor::processRecordingCommand(const Command& cmd)
             DBG("AudioRecorder: Export started to " << exportFile.getFullPathName());
         }
         break;
+    case RecordingCommandID::ExportToFiles:
+        if (cmd.stringParam[0] != '\0')
+        {
+            juce::File baseFile(cmd.getStringParam());
+            audioRecorder.exportToFiles(AudioRecorder::createExportTargets(baseFile, cmd.intParam));
+            DBG("AudioRecorder: Multi-format export started to " << baseFile.getFullPathName());
+        }
+        break;
     case RecordingCommandID::SetRecordingFormat:
         // TODO: Implement format setting if needed
         break;
@@ -424,6 +527,10 @@ void ARTEFACTAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
     
     // Process all pending commands with time limit
     processCommands();
+    
+    // Pen input captured since the last block, with sample offsets
+    const int numPenEvents = penInputPipeline.collectBlock(buffer.getNumSamples(), penEvents.data(),
+                                                           static_cast<int>(penEvents.size()));
 
     // Update BPM if available from host
     if (auto playHead = getPlayHead())
@@ -467,16 +574,30 @@ void ARTEFACTAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
         }
     }
 
+    // Imported images play alongside every mode, like the masking engine
+    if (canvasProcessor.hasImage())
+    {
+        canvasBuffer.setSize(buffer.getNumChannels(), buffer.getNumSamples(), false, false, true);
+        canvasBuffer.clear();
+        canvasProcessor.processBlock(canvasBuffer);
+        
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            buffer.addFrom(ch, 0, canvasBuffer, ch, 0, buffer.getNumSamples());
+        }
+    }
+
     // Process audio based on current mode
     switch (currentMode)
     {
     case ProcessingMode::Canvas:
         // Canvas mode: Only PaintEngine
-        paintEngine.processBlock(buffer);
+        paintEngine.processBlock(buffer, penEvents.data(), numPenEvents);
         break;
         
     case ProcessingMode::Forge:
-        // Forge mode: Only ForgeProcessor
+        // Forge mode: Only ForgeProcessor (strokes are still recorded)
+        paintEngine.applyPenEvents(penEvents.data(), numPenEvents);
         forgeProcessor.processBlock(buffer, midi);
         break;
         
@@ -487,7 +608,7 @@ void ARTEFACTAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
             paintBuffer.clear();
             
             // Process paint engine into separate buffer
-            paintEngine.processBlock(paintBuffer);
+            paintEngine.processBlock(paintBuffer, penEvents.data(), numPenEvents);
             
             // Process forge engine into main buffer
             forgeProcessor.processBlock(buffer, midi);
@@ -501,6 +622,13 @@ void ARTEFACTAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
         break;
     }
     
+    // Master enhancement at the tier pushed by updateProcessingQuality()
+    if (enhancementActive.load())
+    {
+        secretSauceEngine.processBlock(buffer);
+        audityFilter.processBlock(buffer);
+    }
+    
     // Send processed audio to recorder for real-time capture
     audioRecorder.processBlock(buffer);
 }
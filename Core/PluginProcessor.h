@@ -9,9 +9,15 @@
 #include "Core/SampleMaskingEngine.h"
 #include "Core/ParameterBridge.h"
 #include "Core/AudioRecorder.h"
+#include "Core/ProcessingQuality.h"
+#include "Core/SecretSauceEngine.h"
+#include "Core/CEM3389Filter.h"
+#include "Core/PenInputPipeline.h"
+#include "Core/CanvasProcessor.h"
 
 class ARTEFACTAudioProcessor : public juce::AudioProcessor,
-    public juce::AudioProcessorValueTreeState::Listener
+    public juce::AudioProcessorValueTreeState::Listener,
+    private juce::AsyncUpdater
 {
 public:
     ARTEFACTAudioProcessor();
@@ -21,6 +27,7 @@ public:
     void releaseResources() override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
     bool isBusesLayoutSupported(const BusesLayout&) const override;
+    void setNonRealtime(bool isNonRealtime) noexcept override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -49,6 +56,8 @@ public:
     PaintEngine& getPaintEngine() { return paintEngine; }
     SampleMaskingEngine& getSampleMaskingEngine() { return sampleMaskingEngine; }
     AudioRecorder& getAudioRecorder() { return audioRecorder; }
+    PenInputPipeline& getPenInputPipeline() { return penInputPipeline; }
+    CanvasProcessor& getCanvasProcessor() { return canvasProcessor; }
     
     // Paint Brush System
     void setActivePaintBrush(int slotIndex);
@@ -61,6 +70,9 @@ public:
     void resumeAudioProcessing();
     bool isAudioProcessingPaused() const { return audioProcessingPaused; }
     
+    // Processing quality tier actually in use (Render while bouncing offline)
+    ProcessingQuality getEffectiveProcessingQuality() const { return effectiveQuality.load(); }
+    
     // BPM Sync
     void setTempo(double bpm) { lastKnownBPM = bpm; }
     double getTempo() const { return lastKnownBPM; }
@@ -73,7 +85,16 @@ private:
     PaintEngine paintEngine;
     SampleMaskingEngine sampleMaskingEngine;
     ParameterBridge parameterBridge;
+    
+    // Imported images and spectrograms, fed by the editor's CanvasPanel
+    CanvasProcessor canvasProcessor;
+    juce::AudioBuffer<float> canvasBuffer;  // Sized in prepareToPlay, reused every block
     AudioRecorder audioRecorder;
+    
+    // Master enhancement stage (same order as SpectralSynthEngine's output stages)
+    SecretSauceEngine secretSauceEngine;
+    CEM3389Filter audityFilter;
+    std::atomic<bool> enhancementActive{false};
 
     enum class ProcessingMode { Forge = 0, Canvas, Hybrid };
     ProcessingMode currentMode = ProcessingMode::Canvas;
@@ -81,6 +102,10 @@ private:
     // Thread-safe command queue
     CommandQueue<512> commandQueue;  // Increased size for better performance
     
+    // Pen strokes bypass the command queue and arrive as one batch per block
+    PenInputPipeline penInputPipeline;
+    std::array<PaintEngine::PenEvent, PenInputPipeline::MAX_EVENTS_PER_BLOCK> penEvents;
+    
     // Command processing methods
     void processCommands();
     void processCommand(const Command& cmd);
@@ -92,6 +117,16 @@ private:
     double lastKnownBPM = 120.0;
     double currentSampleRate = 44100.0;
     
+    // Processing quality tier (resolved here and pushed to every tiered engine)
+    std::atomic<ProcessingQuality> selectedQuality{ProcessingQuality::Live};
+    std::atomic<ProcessingQuality> effectiveQuality{ProcessingQuality::Live};
+    std::atomic<bool> renderQualityWhenOffline{true};
+    void updateProcessingQuality();
+    
+    // Latency changes are reported from the message thread only
+    std::atomic<int> pendingLatencySamples{0};
+    void handleAsyncUpdate() override;
+    
     // Paint brush system
     int activePaintBrushSlot = 0;  // Which ForgeVoice slot is the active brush (0-7)
     
@@ -0,0 +1,25 @@
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * Global processing-quality tier for the enhancement stack
+ * (SecretSauceEngine and CEM3389Filter).
+ *
+ * - Eco:    cheaper approximations, no content analysis (laptop tracking)
+ * - Live:   the standard real-time behaviour
+ * - Render: oversampled, highest quality (offline bounce)
+ *
+ * ARTEFACTAudioProcessor resolves the tier (including the switch to Render
+ * while the host bounces offline) and pushes it to the engines.
+ */
+enum class ProcessingQuality
+{
+    Eco = 0,
+    Live,
+    Render
+};
+
+inline juce::StringArray getProcessingQualityNames()
+{
+    return { "Eco", "Live", "Render" };
+}
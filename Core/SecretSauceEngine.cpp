@@ -46,6 +46,22 @@ void SecretSauceEngine::prepareToPlay(double sampleRate, int samplesPerBlock, in
     currentSampleRate = sampleRate;
     currentBlockSize = samplesPerBlock;
     
+    // Decimate to roughly 11kHz mono for content analysis
+    analysisThread.stopThread(1000);
+    decimationFactor = juce::jmax(1, static_cast<int>(std::round(sampleRate / ANALYSIS_TARGET_RATE)));
+    decimationCounter = 0;
+    designDecimationFilter();
+    audioAnalyzer.sampleRate = sampleRate / decimationFactor;
+    analysisFifo.reset();
+    analysisThread.startThread(juce::Thread::Priority::low);
+    
+    // 2x oversampler for the Render tier (one half-band stage)
+    oversampledChannels = juce::jmax(1, numChannels);
+    oversampler = std::make_unique<juce::dsp::Oversampling<float>>(
+        static_cast<size_t>(oversampledChannels), 1,
+        juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true);
+    oversampler->initProcessing(static_cast<size_t>(samplesPerBlock));
+    
     // Initialize all filters and processors for the sample rate
     for (auto& filter : emuFilters)
     {
@@ -56,7 +72,14 @@ void SecretSauceEngine::prepareToPlay(double sampleRate, int samplesPerBlock, in
     for (auto& amp : tubeAmps)
     {
         amp.updateTubeCharacteristics(amp.glow_factor, amp.sag_amount, amp.air_presence);
+        amp.rate = TubeAmplifierModel::RateCoefficients{};
     }
+    
+    // Rate-dependent settings for both tiers, so switching never recomputes on the audio thread
+    emuRateFactor = emuFilters[0].sample_rate_factor;
+    emuOversampledRateFactor = emuRateFactor / static_cast<float>(RENDER_OVERSAMPLING);
+    tubeOversampledRate = TubeAmplifierModel::RateCoefficients::forOversampling(RENDER_OVERSAMPLING);
+    appliedQuality = ProcessingQuality::Live;
 }
 
 void SecretSauceEngine::processBlock(juce::AudioBuffer<float>& buffer)
@@ -69,6 +92,8 @@ void SecretSauceEngine::processBlock(juce::AudioBuffer<float>& buffer)
 
 void SecretSauceEngine::releaseResources()
 {
+    analysisThread.stopThread(1000);
+    
     for (auto& filter : emuFilters)
     {
         filter.reset();
@@ -79,23 +104,94 @@ void SecretSauceEngine::applySecretSauce(juce::AudioBuffer<float>& buffer, float
 {
     if (intensity <= 0.0f) return;
     
-    // Analyze the audio content for intelligent processing
-    audioAnalyzer.analyzeBuffer(buffer);
-    audioAnalyzer.updateProcessingHints();
+    const auto quality = processingQuality.load();
+    if (quality != appliedQuality)
+        applyQualityChange(quality);
+    
+    // Hand decimated audio to the analysis thread and pick up its latest results
+    const bool adaptive = settings.adaptive_processing && quality != ProcessingQuality::Eco;
+    if (adaptive)
+        pushAnalysisFrames(buffer);
+    
+    updateActiveSettings(adaptive);
     
-    // Update settings based on content analysis if adaptive processing is enabled
-    if (settings.adaptive_processing)
+    const bool oversample = quality == ProcessingQuality::Render
+                         && oversampler != nullptr
+                         && buffer.getNumChannels() <= oversampledChannels;
+    
+    if (!oversample)
     {
-        updateIntelligentSettings();
-        adaptToAudioContent(buffer);
+        applyProcessingChain(buffer, AllStages);
+        return;
     }
     
+    juce::dsp::AudioBlock<float> block(buffer);
+    auto upsampled = oversampler->processSamplesUp(block);
+    
+    std::array<float*, 8> upsampledChannels{};
+    const int numChannels = juce::jmin(buffer.getNumChannels(), static_cast<int>(upsampledChannels.size()));
+    for (int channel = 0; channel < numChannels; ++channel)
+        upsampledChannels[static_cast<size_t>(channel)] = upsampled.getChannelPointer(static_cast<size_t>(channel));
+    
+    juce::AudioBuffer<float> upsampledBuffer(upsampledChannels.data(), numChannels, static_cast<int>(upsampled.getNumSamples()));
+    applyProcessingChain(upsampledBuffer, OversampledStages);
+    
+    oversampler->processSamplesDown(block);
+    
+    // The stages with fixed per-sample timing run at the host rate, exactly as in Live
+    applyProcessingChain(buffer, AllStages & ~OversampledStages);
+}
+
+void SecretSauceEngine::applyProcessingChain(juce::AudioBuffer<float>& buffer, uint32_t stageMask)
+{
+    if (processingMode.load() == ProcessingMode::Fused)
+    {
+        applyFusedChain(buffer, stageMask);
+        return;
+    }
+    
+    const uint32_t stages = getActiveStages(buffer) & stageMask;
+    
     // Apply the secret sauce in optimal order for best sound quality
-    applyEMUFiltering(buffer);          // Vintage EMU character first
-    applyTubeAmplification(buffer);     // Tube warmth and harmonics
-    applyAnalogCharacter(buffer);       // Analog coloration and tape saturation
-    applyPsychoacousticEnhancement(buffer); // Spatial and psychoacoustic enhancement
-    applyMasteringGrade(buffer);        // Final mastering polish
+    if ((stages & StageEMUFilter) != 0)
+        applyEMUFiltering(buffer);          // Vintage EMU character first
+    
+    if ((stages & StageTubeAmp) != 0)
+        applyTubeAmplification(buffer);     // Tube warmth and harmonics
+    
+    if ((stages & StageAnalog) != 0)
+        applyAnalogCharacter(buffer);       // Analog coloration and tape saturation
+    
+    if ((stages & StagePsychoacoustic) != 0)
+        applyPsychoacousticEnhancement(buffer); // Spatial and psychoacoustic enhancement
+    
+    if ((stages & StageMastering) != 0)
+        applyMasteringGrade(buffer);        // Final mastering polish
+}
+
+void SecretSauceEngine::applyQualityChange(ProcessingQuality quality)
+{
+    // Swap in the precomputed rate settings for the oversampled stages (no re-seeding or allocation)
+    const bool render = quality == ProcessingQuality::Render;
+    
+    for (auto& filter : emuFilters)
+        filter.sample_rate_factor = render ? emuOversampledRateFactor : emuRateFactor;
+    
+    for (auto& amp : tubeAmps)
+        amp.rate = render ? tubeOversampledRate : TubeAmplifierModel::RateCoefficients{};
+    
+    if (oversampler != nullptr)
+        oversampler->reset();
+    
+    appliedQuality = quality;
+}
+
+int SecretSauceEngine::getLatencySamples(ProcessingQuality quality) const
+{
+    if (quality != ProcessingQuality::Render || oversampler == nullptr)
+        return 0;
+    
+    return juce::roundToInt(oversampler->getLatencyInSamples());
 }
 
 //==============================================================================
@@ -200,7 +296,7 @@ float SecretSauceEngine::TubeAmplifierModel::process(float input, double sampleR
 {
     // Update tube state based on input
     float abs_input = std::abs(input);
-    envelope_follower = envelope_follower * 0.999f + abs_input * 0.001f;
+    envelope_follower = envelope_follower * rate.envelope + abs_input * (1.0f - rate.envelope);
     
     // Simulate tube saturation
     float saturated = simulateTubeSaturation(input);
@@ -240,7 +336,7 @@ float SecretSauceEngine::TubeAmplifierModel::simulateTubeSaturation(float input)
 float SecretSauceEngine::TubeAmplifierModel::applyTubeHarmonics(float input)
 {
     // Generate subtle even harmonics (2nd, 4th) characteristic of tubes
-    harmonic_generator_phase += std::abs(input) * 0.1f;
+    harmonic_generator_phase += std::abs(input) * rate.harmonic_step;
     if (harmonic_generator_phase > juce::MathConstants<float>::twoPi)
         harmonic_generator_phase -= juce::MathConstants<float>::twoPi;
     
@@ -254,7 +350,7 @@ float SecretSauceEngine::TubeAmplifierModel::simulatePowerSupplySag(float input)
 {
     // Simulate power supply sag under load
     float load = envelope_follower;
-    sag_envelope = sag_envelope * 0.995f + load * 0.005f;
+    sag_envelope = sag_envelope * rate.sag + load * (1.0f - rate.sag);
     
     float sag_reduction = 1.0f - (sag_envelope * sag_amount * 0.3f);
     return input * sag_reduction;
@@ -264,8 +360,8 @@ float SecretSauceEngine::TubeAmplifierModel::applyTubeFrequencyResponse(float in
 {
     // Tube amps have characteristic frequency response - slight high-end rolloff and mid boost
     // Simplified single-pole filter simulation
-    eq_state[0] = eq_state[0] * 0.95f + input * 0.05f; // High-frequency rolloff
-    eq_state[1] = eq_state[1] * 0.98f + input * 0.02f; // Mid-frequency boost
+    eq_state[0] = eq_state[0] * rate.eq_high + input * (1.0f - rate.eq_high); // High-frequency rolloff
+    eq_state[1] = eq_state[1] * rate.eq_mid + input * (1.0f - rate.eq_mid);   // Mid-frequency boost
     
     return input * 0.7f + eq_state[0] * 0.2f + eq_state[1] * 0.1f;
 }
@@ -273,12 +369,31 @@ float SecretSauceEngine::TubeAmplifierModel::applyTubeFrequencyResponse(float in
 float SecretSauceEngine::TubeAmplifierModel::simulateThermalDrift(float input)
 {
     // Simulate thermal drift - very subtle changes over time
-    thermal_drift += (juce::Random::getSystemRandom().nextFloat() - 0.5f) * 0.00001f;
+    thermal_drift += (juce::Random::getSystemRandom().nextFloat() - 0.5f) * rate.drift_step;
     thermal_drift = juce::jlimit(-0.005f, 0.005f, thermal_drift);
     
     return input * (1.0f + thermal_drift);
 }
 
+SecretSauceEngine::TubeAmplifierModel::RateCoefficients
+SecretSauceEngine::TubeAmplifierModel::RateCoefficients::forOversampling(int factor)
+{
+    // One-pole poles become pole^(1/factor) to keep their time constants; per-sample
+    // increments shrink by the factor (the drift random walk by its square root)
+    const RateCoefficients base;
+    const float exponent = 1.0f / static_cast<float>(factor);
+    
+    RateCoefficients scaled;
+    scaled.envelope = std::pow(base.envelope, exponent);
+    scaled.sag = std::pow(base.sag, exponent);
+    scaled.eq_high = std::pow(base.eq_high, exponent);
+    scaled.eq_mid = std::pow(base.eq_mid, exponent);
+    scaled.harmonic_step = base.harmonic_step * exponent;
+    scaled.drift_step = base.drift_step * std::sqrt(exponent);
+    
+    return scaled;
+}
+
 void SecretSauceEngine::TubeAmplifierModel::updateTubeCharacteristics(float glow, float sag, float air)
 {
     glow_factor = juce::jlimit(0.0f, 1.0f, glow);
@@ -445,22 +560,25 @@ void SecretSauceEngine::MasteringProcessor::processMastering(juce::AudioBuffer<f
         
         for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
         {
-            float input = channelData[sample];
-            
-            // Apply multiband processing
-            applyMultibandProcessing(input, channel);
-            
-            // Apply harmonic excitement
-            applyHarmonicExcitement(input);
-            
-            // Apply gentle limiting
-            applyGentleLimiting(input);
-            
-            channelData[sample] = input;
+            channelData[sample] = processSample(channelData[sample], channel);
         }
     }
 }
 
+float SecretSauceEngine::MasteringProcessor::processSample(float input, int channel)
+{
+    // Apply multiband processing
+    applyMultibandProcessing(input, channel);
+    
+    // Apply harmonic excitement
+    applyHarmonicExcitement(input);
+    
+    // Apply gentle limiting
+    applyGentleLimiting(input, channel);
+    
+    return input;
+}
+
 void SecretSauceEngine::MasteringProcessor::applyMultibandProcessing(float& sample, int channel)
 {
     // Simplified 4-band processing
@@ -488,8 +606,9 @@ void SecretSauceEngine::MasteringProcessor::applyMultibandProcessing(float& samp
     }
 }
 
-void SecretSauceEngine::MasteringProcessor::applyGentleLimiting(float& sample)
+void SecretSauceEngine::MasteringProcessor::applyGentleLimiting(float& sample, int channel)
 {
+    auto& limiter_envelope = limiter_envelopes[static_cast<size_t>(channel) % limiter_envelopes.size()];
     float abs_sample = std::abs(sample);
     
     if (abs_sample > 0.95f)
@@ -514,63 +633,63 @@ void SecretSauceEngine::MasteringProcessor::applyHarmonicExcitement(float& sampl
 //==============================================================================
 // Audio Analysis Implementation
 
-void SecretSauceEngine::AudioAnalyzer::analyzeBuffer(const juce::AudioBuffer<float>& buffer)
+void SecretSauceEngine::AudioAnalyzer::analyzeFrame(const float* frame, int numSamples)
 {
-    if (buffer.getNumSamples() == 0) return;
+    if (numSamples == 0) return;
     
     // Calculate RMS and peak levels
     rms_level = 0.0f;
     peak_level = 0.0f;
     
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    for (int sample = 0; sample < numSamples; ++sample)
     {
-        auto* channelData = buffer.getReadPointer(channel);
-        
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-        {
-            float abs_sample = std::abs(channelData[sample]);
-            rms_level += channelData[sample] * channelData[sample];
-            peak_level = juce::jmax(peak_level, abs_sample);
-        }
+        float abs_sample = std::abs(frame[sample]);
+        rms_level += frame[sample] * frame[sample];
+        peak_level = juce::jmax(peak_level, abs_sample);
     }
     
-    rms_level = std::sqrt(rms_level / (buffer.getNumSamples() * buffer.getNumChannels()));
+    rms_level = std::sqrt(rms_level / numSamples);
     dynamic_range = peak_level - rms_level;
     
-    // Perform spectral analysis (simplified)
-    performSpectralAnalysis(buffer);
+    performSpectralAnalysis(frame, numSamples);
     classifyAudioContent();
 }
 
-void SecretSauceEngine::AudioAnalyzer::performSpectralAnalysis(const juce::AudioBuffer<float>& buffer)
+void SecretSauceEngine::AudioAnalyzer::performSpectralAnalysis(const float* frame, int numSamples)
 {
-    // Simplified spectral analysis - would use FFT in real implementation
-    const float* channelData = buffer.getReadPointer(0);
-    int numSamples = juce::jmin(buffer.getNumSamples(), 256);
+    // Windowed FFT of the most recent frame
+    const int frameSize = juce::jmin(numSamples, FFT_SIZE);
+    std::fill(fftBuffer.begin(), fftBuffer.end(), 0.0f);
+    std::copy(frame + numSamples - frameSize, frame + numSamples, fftBuffer.begin());
+    
+    window.multiplyWithWindowingTable(fftBuffer.data(), static_cast<size_t>(FFT_SIZE));
+    fft.performFrequencyOnlyForwardTransform(fftBuffer.data());
     
-    // Calculate spectral centroid (simplified)
+    // Spectral centroid, converted from bins to Hz so it no longer depends on the decimated rate
     float weighted_sum = 0.0f;
     float magnitude_sum = 0.0f;
     
-    for (int i = 0; i < numSamples; ++i)
+    for (int bin = 0; bin < static_cast<int>(magnitude_spectrum.size()); ++bin)
     {
-        float magnitude = std::abs(channelData[i]);
-        magnitude_spectrum[i] = magnitude;
-        weighted_sum += magnitude * i;
+        float magnitude = fftBuffer[static_cast<size_t>(bin)];
+        magnitude_spectrum[static_cast<size_t>(bin)] = magnitude;
+        weighted_sum += magnitude * bin;
         magnitude_sum += magnitude;
     }
     
-    spectral_centroid = (magnitude_sum > 0.0f) ? (weighted_sum / magnitude_sum) : 0.0f;
+    const float binWidthHz = static_cast<float>(sampleRate / FFT_SIZE);
+    spectral_centroid = (magnitude_sum > 0.0f) ? (weighted_sum / magnitude_sum) * binWidthHz : 0.0f;
 }
 
 void SecretSauceEngine::AudioAnalyzer::classifyAudioContent()
 {
     // Simple content classification
     is_percussive = (peak_level > 0.5f && dynamic_range > 0.3f);
-    is_harmonic = (spectral_centroid > 50.0f && spectral_centroid < 150.0f);
-    is_vocal = (spectral_centroid > 80.0f && spectral_centroid < 120.0f && rms_level > 0.1f);
-    needs_warmth = (spectral_centroid > 150.0f);
-    needs_brightness = (spectral_centroid < 50.0f);
+    // Centroid bands in Hz; the decimated band tops out around 5.5kHz
+    is_harmonic = (spectral_centroid > 1000.0f && spectral_centroid < 3000.0f);
+    is_vocal = (spectral_centroid > 1600.0f && spectral_centroid < 2400.0f && rms_level > 0.1f);
+    needs_warmth = (spectral_centroid > 3000.0f);
+    needs_brightness = (spectral_centroid < 1000.0f);
 }
 
 void SecretSauceEngine::AudioAnalyzer::updateProcessingHints()
@@ -584,7 +703,7 @@ void SecretSauceEngine::AudioAnalyzer::updateProcessingHints()
 
 void SecretSauceEngine::applyEMUFiltering(juce::AudioBuffer<float>& buffer)
 {
-    if (settings.emu_filter_intensity <= 0.0f) return;
+    if (activeSettings.emu_filter_intensity <= 0.0f) return;
     
     for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
     {
@@ -597,15 +716,15 @@ void SecretSauceEngine::applyEMUFiltering(juce::AudioBuffer<float>& buffer)
             float filtered = filter.process(input, EMUFilterType::EMU_Classic);
             
             // Blend with original signal
-            channelData[sample] = input * (1.0f - settings.emu_filter_intensity) + 
-                                 filtered * settings.emu_filter_intensity;
+            channelData[sample] = input * (1.0f - activeSettings.emu_filter_intensity) + 
+                                 filtered * activeSettings.emu_filter_intensity;
         }
     }
 }
 
 void SecretSauceEngine::applyTubeAmplification(juce::AudioBuffer<float>& buffer)
 {
-    if (settings.tube_amp_intensity <= 0.0f) return;
+    if (activeSettings.tube_amp_intensity <= 0.0f) return;
     
     for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
     {
@@ -618,15 +737,15 @@ void SecretSauceEngine::applyTubeAmplification(juce::AudioBuffer<float>& buffer)
             float processed = amp.process(input, currentSampleRate);
             
             // Blend with original signal
-            channelData[sample] = input * (1.0f - settings.tube_amp_intensity) + 
-                                 processed * settings.tube_amp_intensity;
+            channelData[sample] = input * (1.0f - activeSettings.tube_amp_intensity) + 
+                                 processed * activeSettings.tube_amp_intensity;
         }
     }
 }
 
 void SecretSauceEngine::applyAnalogCharacter(juce::AudioBuffer<float>& buffer)
 {
-    if (settings.analog_character_intensity <= 0.0f) return;
+    if (activeSettings.analog_character_intensity <= 0.0f) return;
     
     for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
     {
@@ -639,15 +758,15 @@ void SecretSauceEngine::applyAnalogCharacter(juce::AudioBuffer<float>& buffer)
             float processed = processor.process(input, currentSampleRate);
             
             // Blend with original signal
-            channelData[sample] = input * (1.0f - settings.analog_character_intensity) + 
-                                 processed * settings.analog_character_intensity;
+            channelData[sample] = input * (1.0f - activeSettings.analog_character_intensity) + 
+                                 processed * activeSettings.analog_character_intensity;
         }
     }
 }
 
 void SecretSauceEngine::applyPsychoacousticEnhancement(juce::AudioBuffer<float>& buffer)
 {
-    if (settings.psychoacoustic_intensity <= 0.0f || buffer.getNumChannels() < 2) return;
+    if (activeSettings.psychoacoustic_intensity <= 0.0f || buffer.getNumChannels() < 2) return;
     
     for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
     {
@@ -663,11 +782,115 @@ void SecretSauceEngine::applyPsychoacousticEnhancement(juce::AudioBuffer<float>&
 
 void SecretSauceEngine::applyMasteringGrade(juce::AudioBuffer<float>& buffer)
 {
-    if (settings.mastering_intensity <= 0.0f) return;
+    if (activeSettings.mastering_intensity <= 0.0f) return;
     
     masteringProcessor.processMastering(buffer, currentSampleRate);
 }
 
+//==============================================================================
+// Fused Processing Pipeline
+
+uint32_t SecretSauceEngine::getActiveStages(const juce::AudioBuffer<float>& buffer) const
+{
+    uint32_t stages = 0;
+    
+    if (activeSettings.emu_filter_intensity > 0.0f)          stages |= StageEMUFilter;
+    if (activeSettings.tube_amp_intensity > 0.0f)            stages |= StageTubeAmp;
+    if (activeSettings.analog_character_intensity > 0.0f)    stages |= StageAnalog;
+    if (activeSettings.mastering_intensity > 0.0f)           stages |= StageMastering;
+    
+    if (activeSettings.psychoacoustic_intensity > 0.0f && buffer.getNumChannels() >= 2)
+        stages |= StagePsychoacoustic;
+    
+    // Eco keeps the core colour (EMU, tube, limiter) and drops the rest
+    if (appliedQuality == ProcessingQuality::Eco)
+        stages &= ~static_cast<uint32_t>(StageAnalog | StagePsychoacoustic);
+    
+    return stages;
+}
+
+template <size_t... StageSets>
+std::array<SecretSauceEngine::FusedProcessFunction, sizeof...(StageSets)>
+SecretSauceEngine::makeFusedTable(std::index_sequence<StageSets...>)
+{
+    return {{ &SecretSauceEngine::processFused<static_cast<uint32_t>(StageSets)>... }};
+}
+
+void SecretSauceEngine::applyFusedChain(juce::AudioBuffer<float>& buffer, uint32_t stageMask)
+{
+    // One specialisation per stage combination - disabled stages compile away
+    static const auto fusedTable = makeFusedTable(std::make_index_sequence<NumStageCombinations>{});
+    
+    (this->*fusedTable[getActiveStages(buffer) & stageMask])(buffer);
+}
+
+template <uint32_t Stages>
+void SecretSauceEngine::processFused(juce::AudioBuffer<float>& buffer)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+    
+    // Snapshot the dry/wet mixes once per block
+    const float emuMix = activeSettings.emu_filter_intensity;
+    const float tubeMix = activeSettings.tube_amp_intensity;
+    const float analogMix = activeSettings.analog_character_intensity;
+    
+    for (int start = 0; start < numSamples; start += FUSED_SUB_BLOCK)
+    {
+        const int count = juce::jmin(FUSED_SUB_BLOCK, numSamples - start);
+        
+        // Per-channel stages: EMU filter -> tube amp -> analog character
+        if constexpr ((Stages & (StageEMUFilter | StageTubeAmp | StageAnalog)) != 0)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto* channelData = buffer.getWritePointer(channel, start);
+                auto& filter = emuFilters[channel % 2];
+                auto& amp = tubeAmps[channel % 2];
+                auto& processor = analogProcessors[channel % 2];
+                
+                for (int i = 0; i < count; ++i)
+                {
+                    float x = channelData[i];
+                    
+                    if constexpr ((Stages & StageEMUFilter) != 0)
+                        x += (filter.process(x, EMUFilterType::EMU_Classic) - x) * emuMix;
+                    
+                    if constexpr ((Stages & StageTubeAmp) != 0)
+                        x += (amp.process(x, currentSampleRate) - x) * tubeMix;
+                    
+                    if constexpr ((Stages & StageAnalog) != 0)
+                        x += (processor.process(x, currentSampleRate) - x) * analogMix;
+                    
+                    channelData[i] = x;
+                }
+            }
+        }
+        
+        // Stereo stage: psychoacoustic enhancement on the first pair
+        if constexpr ((Stages & StagePsychoacoustic) != 0)
+        {
+            auto* left = buffer.getWritePointer(0, start);
+            auto* right = buffer.getWritePointer(1, start);
+            
+            for (int i = 0; i < count; ++i)
+                psychoacousticEnhancer.processStereo(left[i], right[i], currentSampleRate);
+        }
+        
+        // Final stage: mastering polish
+        if constexpr ((Stages & StageMastering) != 0)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto* channelData = buffer.getWritePointer(channel, start);
+                
+                for (int i = 0; i < count; ++i)
+                    channelData[i] = masteringProcessor.processSample(channelData[i], channel);
+            }
+        }
+    }
+}
+
 //==============================================================================
 // Dynamic Brush Control Integration
 
@@ -763,59 +986,227 @@ void SecretSauceEngine::updateTubeCharacteristicsFromBrush(float pressure, float
 //==============================================================================
 // Intelligent Adaptation
 
+void SecretSauceEngine::designDecimationFilter()
+{
+    // Blackman-windowed sinc with its cutoff at the decimated Nyquist. The transition
+    // runs from 0.4 to 0.6 of the decimated rate, so whatever still aliases folds
+    // into the top fifth of the analysed band rather than onto the centroid ranges.
+    decimationTaps = decimationFactor > 1
+        ? juce::jmin(MAX_DECIMATION_TAPS, DECIMATION_TAPS_PER_FACTOR * decimationFactor + 1)
+        : 1;
+    decimationWritePos = 0;
+    decimationHistory.fill(0.0f);
+    
+    if (decimationTaps == 1)
+    {
+        decimationKernel[0] = 1.0f;
+        return;
+    }
+    
+    const double cutoff = 0.5 / decimationFactor;   // Cycles per input sample
+    const double centre = 0.5 * (decimationTaps - 1);
+    const double twoPi = juce::MathConstants<double>::twoPi;
+    double sum = 0.0;
+    
+    for (int i = 0; i < decimationTaps; ++i)
+    {
+        const double x = i - centre;
+        const double sinc = x == 0.0 ? 2.0 * cutoff
+                                     : std::sin(twoPi * cutoff * x) / (juce::MathConstants<double>::pi * x);
+        const double phase = twoPi * i / (decimationTaps - 1);
+        const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+        
+        decimationKernel[static_cast<size_t>(i)] = static_cast<float>(sinc * window);
+        sum += sinc * window;
+    }
+    
+    // Unity gain at DC
+    for (int i = 0; i < decimationTaps; ++i)
+        decimationKernel[static_cast<size_t>(i)] = static_cast<float>(decimationKernel[static_cast<size_t>(i)] / sum);
+}
+
+void SecretSauceEngine::pushAnalysisFrames(const juce::AudioBuffer<float>& buffer)
+{
+    // Audio thread: mono-sum, low-pass and decimate, then one FIFO write per scratch fill
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+    
+    if (numChannels == 0) return;
+    
+    const float channelScale = 1.0f / static_cast<float>(numChannels);
+    int scratchCount = 0;
+    
+    auto flushScratch = [this, &scratchCount]
+    {
+        int start1, size1, start2, size2;
+        analysisFifo.prepareToWrite(scratchCount, start1, size1, start2, size2);
+        
+        std::copy(decimationScratch.begin(), decimationScratch.begin() + size1, analysisRing.begin() + start1);
+        std::copy(decimationScratch.begin() + size1, decimationScratch.begin() + size1 + size2, analysisRing.begin() + start2);
+        analysisFifo.finishedWrite(size1 + size2);
+        
+        if (size1 + size2 < scratchCount)
+            analysisOverflowCount.fetch_add(1, std::memory_order_relaxed);
+        
+        scratchCount = 0;
+    };
+    
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        float mono = 0.0f;
+        for (int channel = 0; channel < numChannels; ++channel)
+            mono += buffer.getReadPointer(channel)[sample];
+        
+        mono *= channelScale;
+        decimationHistory[static_cast<size_t>(decimationWritePos)] = mono;
+        decimationHistory[static_cast<size_t>(decimationWritePos + decimationTaps)] = mono;
+        
+        if (++decimationWritePos == decimationTaps)
+            decimationWritePos = 0;
+        
+        if (++decimationCounter >= decimationFactor)
+        {
+            // The last decimationTaps samples, oldest first; the kernel is symmetric
+            const float* window = decimationHistory.data() + decimationWritePos;
+            float filtered = 0.0f;
+            
+            for (int tap = 0; tap < decimationTaps; ++tap)
+                filtered += decimationKernel[static_cast<size_t>(tap)] * window[tap];
+            
+            decimationScratch[static_cast<size_t>(scratchCount++)] = filtered;
+            decimationCounter = 0;
+            
+            if (scratchCount == static_cast<int>(decimationScratch.size()))
+                flushScratch();
+        }
+    }
+    
+    if (scratchCount > 0)
+        flushScratch();
+}
+
+void SecretSauceEngine::runContentAnalysis()
+{
+    // Analysis thread: drain the ring into a sliding history window
+    const int available = analysisFifo.getNumReady();
+    if (available == 0) return;
+    
+    int start1, size1, start2, size2;
+    analysisFifo.prepareToRead(available, start1, size1, start2, size2);
+    std::copy(analysisRing.begin() + start1, analysisRing.begin() + start1 + size1, analysisIncoming.begin());
+    std::copy(analysisRing.begin() + start2, analysisRing.begin() + start2 + size2, analysisIncoming.begin() + size1);
+    analysisFifo.finishedRead(size1 + size2);
+    
+    const int numNew = size1 + size2;
+    const int historySize = static_cast<int>(analysisHistory.size());
+    
+    if (numNew >= historySize)
+    {
+        std::copy(analysisIncoming.begin() + (numNew - historySize), analysisIncoming.begin() + numNew, analysisHistory.begin());
+    }
+    else
+    {
+        std::move(analysisHistory.begin() + numNew, analysisHistory.end(), analysisHistory.begin());
+        std::copy(analysisIncoming.begin(), analysisIncoming.begin() + numNew, analysisHistory.end() - numNew);
+    }
+    
+    audioAnalyzer.analyzeFrame(analysisHistory.data(), historySize);
+    audioAnalyzer.updateProcessingHints();
+    updateIntelligentSettings();
+}
+
 void SecretSauceEngine::updateIntelligentSettings()
 {
+    // Targets are multipliers on the base settings, so they never compound
+    float emu = 1.0f, tube = 1.0f, analog = 1.0f, psycho = 1.0f;
+    float mastering = 1.0f, presence = 1.0f, overall = 1.0f;
+    
     // Adapt processing based on audio content
     if (audioAnalyzer.is_percussive)
     {
-        settings.emu_filter_intensity *= settings.percussive_emphasis;
-        settings.tube_amp_intensity *= 0.9f; // Less tube saturation on drums
+        emu *= settings.percussive_emphasis;
+        tube *= 0.9f; // Less tube saturation on drums
     }
     
     if (audioAnalyzer.is_harmonic)
     {
-        settings.analog_character_intensity *= settings.harmonic_enhancement;
-        settings.psychoacoustic_intensity *= 1.1f;
+        analog *= settings.harmonic_enhancement;
+        psycho *= 1.1f;
     }
     
     if (audioAnalyzer.is_vocal)
     {
-        settings.psychoacoustic_intensity *= settings.vocal_presence;
-        settings.mastering_intensity *= 1.15f;
+        psycho *= settings.vocal_presence;
+        mastering *= 1.15f;
     }
     
     if (audioAnalyzer.needs_warmth)
     {
-        settings.tube_amp_intensity *= 1.2f;
-        settings.analog_character_intensity *= 1.1f;
+        tube *= 1.2f;
+        analog *= 1.1f;
     }
     
     if (audioAnalyzer.needs_brightness)
     {
-        settings.psychoacoustic_intensity *= 1.1f;
-        psychoacousticEnhancer.presence_boost *= 1.2f;
+        psycho *= 1.1f;
+        presence *= 1.2f;
     }
+    
+    // Adapt intensity based on signal energy
+    float energy = audioAnalyzer.rms_level;
+    
+    if (energy > 0.7f)
+        overall = 0.8f;   // Loud signal - reduce processing to avoid over-processing
+    else if (energy < 0.1f)
+        overall = 1.2f;   // Quiet signal - increase processing for enhancement
+    
+    // Smooth towards the targets (~300ms) and publish
+    const float smoothing = 1.0f - std::exp(-1.0f / (analysisRateHz.load() * 0.3f));
+    
+    auto publish = [smoothing](std::atomic<float>& published, float target)
+    {
+        const float current = published.load(std::memory_order_relaxed);
+        published.store(current + (target - current) * smoothing, std::memory_order_relaxed);
+    };
+    
+    publish(adaptiveMultipliers.emu, emu);
+    publish(adaptiveMultipliers.tube, tube);
+    publish(adaptiveMultipliers.analog, analog);
+    publish(adaptiveMultipliers.psychoacoustic, psycho);
+    publish(adaptiveMultipliers.mastering, mastering);
+    publish(adaptiveMultipliers.presence, presence);
+    publish(adaptiveMultipliers.overall, overall);
 }
 
-void SecretSauceEngine::adaptToAudioContent(const juce::AudioBuffer<float>& buffer)
+void SecretSauceEngine::updateActiveSettings(bool adaptive)
 {
-    // Real-time adaptation based on content
-    float energy = audioAnalyzer.rms_level;
+    // Audio thread: a handful of relaxed loads per block
+    activeSettings = settings;
     
-    // Adapt intensity based on signal energy
-    if (energy > 0.7f)
+    if (!adaptive)
     {
-        // Loud signal - reduce processing to avoid over-processing
-        settings.overall_intensity *= 0.8f;
+        psychoacousticEnhancer.presence_boost = basePresenceBoost;
+        return;
     }
-    else if (energy < 0.1f)
+    
+    auto& m = adaptiveMultipliers;
+    activeSettings.emu_filter_intensity = juce::jlimit(0.0f, 1.0f, settings.emu_filter_intensity * m.emu.load(std::memory_order_relaxed));
+    activeSettings.tube_amp_intensity = juce::jlimit(0.0f, 1.0f, settings.tube_amp_intensity * m.tube.load(std::memory_order_relaxed));
+    activeSettings.analog_character_intensity = juce::jlimit(0.0f, 1.0f, settings.analog_character_intensity * m.analog.load(std::memory_order_relaxed));
+    activeSettings.psychoacoustic_intensity = juce::jlimit(0.0f, 1.0f, settings.psychoacoustic_intensity * m.psychoacoustic.load(std::memory_order_relaxed));
+    activeSettings.mastering_intensity = juce::jlimit(0.0f, 1.0f, settings.mastering_intensity * m.mastering.load(std::memory_order_relaxed));
+    activeSettings.overall_intensity = juce::jlimit(0.3f, 1.0f, settings.overall_intensity * m.overall.load(std::memory_order_relaxed));
+    
+    psychoacousticEnhancer.presence_boost = basePresenceBoost * m.presence.load(std::memory_order_relaxed);
+}
+
+void SecretSauceEngine::AnalysisThread::run()
+{
+    while (!threadShouldExit())
     {
-        // Quiet signal - increase processing for enhancement
-        settings.overall_intensity *= 1.2f;
+        engine.runContentAnalysis();
+        wait(juce::roundToInt(1000.0f / engine.analysisRateHz.load()));
     }
-    
-    // Limit intensity to reasonable range
-    settings.overall_intensity = juce::jlimit(0.3f, 1.0f, settings.overall_intensity);
 }
 
 float SecretSauceEngine::calculateQualityMetric(const juce::AudioBuffer<float>& buffer)
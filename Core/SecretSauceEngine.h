@@ -1,9 +1,11 @@
 #pragma once
 #include <JuceHeader.h>
+#include "ProcessingQuality.h"
 #include <memory>
 #include <atomic>
 #include <vector>
 #include <array>
+#include <utility>
 
 /**
  * Secret Sauce Engine - The Hidden Magic Behind The Sound
@@ -62,6 +64,35 @@ public:
         EMU_Smooth          // Smooth musical filter
     };
     
+    //==============================================================================
+    // Processing Mode
+    
+    enum class ProcessingMode
+    {
+        MultiPass,          // One full-buffer pass per stage (reference path)
+        Fused               // All stages per sub-block while the data is in L1
+    };
+    
+    void setProcessingMode(ProcessingMode mode) { processingMode.store(mode); }
+    ProcessingMode getProcessingMode() const { return processingMode.load(); }
+    
+    //==============================================================================
+    // Adaptive Analysis (runs on a background thread)
+    
+    // How often the content analysis runs (1 - 60 updates per second)
+    void setAnalysisRate(float updatesPerSecond) { analysisRateHz.store(juce::jlimit(1.0f, 60.0f, updatesPerSecond)); }
+    float getAnalysisRate() const { return analysisRateHz.load(); }
+    
+    //==============================================================================
+    // Quality Tier (Eco skips analysis and the analog/psychoacoustic stages,
+    // Render runs the EMU filter and tube amp 2x oversampled)
+    
+    void setProcessingQuality(ProcessingQuality quality) { processingQuality.store(quality); }
+    ProcessingQuality getProcessingQuality() const { return processingQuality.load(); }
+    
+    // Delay the tier adds to the output (the Render oversampler's filters)
+    int getLatencySamples(ProcessingQuality quality) const;
+    
 private:
     struct VintageEMUFilter
     {
@@ -119,6 +150,22 @@ private:
         // Frequency response modeling
         std::array<float, 5> eq_state{};  // Multi-band EQ state
         
+        // Per-sample smoothing constants, tuned at the host rate and rescaled
+        // so the model keeps its timing when it runs oversampled
+        struct RateCoefficients
+        {
+            float envelope = 0.999f;
+            float sag = 0.995f;
+            float eq_high = 0.95f;
+            float eq_mid = 0.98f;
+            float harmonic_step = 0.1f;
+            float drift_step = 0.00001f;
+            
+            static RateCoefficients forOversampling(int factor);
+        };
+        
+        RateCoefficients rate;
+        
         float process(float input, double sampleRate);
         void updateTubeCharacteristics(float glow, float sag, float air);
         
@@ -216,15 +263,17 @@ private:
         
         std::array<Band, 4> bands; // 4-band mastering processor
         
-        // Limiting
-        float limiter_envelope = 0.0f;
+        // Limiting - one envelope per channel of the stereo pair, so the result
+        // does not depend on the order the channels are processed in
+        std::array<float, 2> limiter_envelopes{};
         float limiter_gain_reduction = 1.0f;
         
         void processMastering(juce::AudioBuffer<float>& buffer, double sampleRate);
+        float processSample(float input, int channel);
         
     private:
         void applyMultibandProcessing(float& sample, int channel);
-        void applyGentleLimiting(float& sample);
+        void applyGentleLimiting(float& sample, int channel);
         void applyHarmonicExcitement(float& sample);
     };
     
@@ -238,7 +287,7 @@ private:
         // Real-time audio analysis
         float rms_level = 0.0f;
         float peak_level = 0.0f;
-        float spectral_centroid = 0.0f;
+        float spectral_centroid = 0.0f;     // Hz
         float dynamic_range = 0.0f;
         
         // Analysis for intelligent processing
@@ -248,16 +297,82 @@ private:
         bool needs_warmth = false;
         bool needs_brightness = false;
         
-        void analyzeBuffer(const juce::AudioBuffer<float>& buffer);
+        void analyzeFrame(const float* frame, int numSamples);
         void updateProcessingHints();
         
+        static constexpr int FFT_ORDER = 9;
+        static constexpr int FFT_SIZE = 1 << FFT_ORDER;
+        
+        double sampleRate = ANALYSIS_TARGET_RATE;  // Rate of the decimated frames
+        
     private:
         std::array<float, 256> magnitude_spectrum{};
-        void performSpectralAnalysis(const juce::AudioBuffer<float>& buffer);
+        juce::dsp::FFT fft{FFT_ORDER};
+        juce::dsp::WindowingFunction<float> window{static_cast<size_t>(FFT_SIZE), juce::dsp::WindowingFunction<float>::hann};
+        std::array<float, FFT_SIZE * 2> fftBuffer{};
+        
+        void performSpectralAnalysis(const float* frame, int numSamples);
         void classifyAudioContent();
     };
     
-    AudioAnalyzer audioAnalyzer;
+    AudioAnalyzer audioAnalyzer;  // Owned by the analysis thread
+    
+    //==============================================================================
+    // Analysis Pipeline (audio thread -> SPSC ring -> analysis thread)
+    
+    // Content-driven multipliers, smoothed and published by the analysis thread
+    struct AdaptiveMultipliers
+    {
+        std::atomic<float> emu{1.0f};
+        std::atomic<float> tube{1.0f};
+        std::atomic<float> analog{1.0f};
+        std::atomic<float> psychoacoustic{1.0f};
+        std::atomic<float> mastering{1.0f};
+        std::atomic<float> presence{1.0f};
+        std::atomic<float> overall{1.0f};
+    };
+    
+    AdaptiveMultipliers adaptiveMultipliers;
+    
+    static constexpr int ANALYSIS_RING_SIZE = 8192;          // Decimated mono samples
+    static constexpr double ANALYSIS_TARGET_RATE = 11025.0;  // Decimated sample rate target
+    
+    juce::AbstractFifo analysisFifo{ANALYSIS_RING_SIZE};
+    std::vector<float> analysisRing = std::vector<float>(ANALYSIS_RING_SIZE, 0.0f);
+    std::array<float, 1024> decimationScratch{};
+    
+    // Anti-alias FIR run ahead of the decimation; only every decimationFactor-th
+    // output is computed. History is stored twice so each window is contiguous.
+    static constexpr int DECIMATION_TAPS_PER_FACTOR = 28;
+    static constexpr int MAX_DECIMATION_TAPS = 511;
+    std::array<float, MAX_DECIMATION_TAPS> decimationKernel{};
+    std::array<float, MAX_DECIMATION_TAPS * 2> decimationHistory{};
+    int decimationTaps = 1;
+    int decimationWritePos = 0;
+    
+    int decimationFactor = 4;
+    int decimationCounter = 0;
+    std::atomic<int> analysisOverflowCount{0};
+    std::atomic<float> analysisRateHz{20.0f};
+    
+    // Analysis-thread state
+    std::vector<float> analysisHistory = std::vector<float>(AudioAnalyzer::FFT_SIZE, 0.0f);
+    std::vector<float> analysisIncoming = std::vector<float>(ANALYSIS_RING_SIZE, 0.0f);
+    
+    class AnalysisThread : public juce::Thread
+    {
+    public:
+        AnalysisThread(SecretSauceEngine& owner)
+            : Thread("SecretSauce Analysis"), engine(owner) {}
+        void run() override;
+        
+    private:
+        SecretSauceEngine& engine;
+    } analysisThread{*this};
+    
+    void designDecimationFilter();
+    void pushAnalysisFrames(const juce::AudioBuffer<float>& buffer);
+    void runContentAnalysis();
     
     //==============================================================================
     // Secret Sauce Control (Invisible to User)
@@ -285,7 +400,9 @@ private:
         float vocal_presence = 1.15f;       // Enhance vocal presence
     };
     
-    SecretSauceSettings settings;
+    SecretSauceSettings settings;         // Base settings (brush / setters)
+    SecretSauceSettings activeSettings;   // Per-block snapshot with adaptation applied
+    float basePresenceBoost = 0.2f;
     
     //==============================================================================
     // Performance & State Management
@@ -345,7 +462,7 @@ private:
     // Internal Methods
     
     void updateIntelligentSettings();
-    void adaptToAudioContent(const juce::AudioBuffer<float>& buffer);
+    void updateActiveSettings(bool adaptive);
     float calculateQualityMetric(const juce::AudioBuffer<float>& buffer);
     
     // Secret sauce application order (optimized for best sound)
@@ -355,6 +472,53 @@ private:
     void applyPsychoacousticEnhancement(juce::AudioBuffer<float>& buffer);
     void applyMasteringGrade(juce::AudioBuffer<float>& buffer);
     
+    //==============================================================================
+    // Fused Processing (one pass, stage set folded in at compile time)
+    
+    enum StageFlags : uint32_t
+    {
+        StageEMUFilter      = 1 << 0,
+        StageTubeAmp        = 1 << 1,
+        StageAnalog         = 1 << 2,
+        StagePsychoacoustic = 1 << 3,
+        StageMastering      = 1 << 4,
+        NumStageCombinations = 1 << 5
+    };
+    
+    static constexpr int FUSED_SUB_BLOCK = 64;  // Samples per channel kept hot in L1
+    
+    using FusedProcessFunction = void (SecretSauceEngine::*)(juce::AudioBuffer<float>&);
+    
+    std::atomic<ProcessingMode> processingMode{ProcessingMode::Fused};
+    
+    // Render oversamples only the saturating stages; the analog envelopes, Haas delay
+    // and limiter have fixed per-sample time constants and stay at the host rate
+    static constexpr uint32_t AllStages = NumStageCombinations - 1;
+    static constexpr uint32_t OversampledStages = StageEMUFilter | StageTubeAmp;
+    static constexpr int RENDER_OVERSAMPLING = 2;
+    
+    std::atomic<ProcessingQuality> processingQuality{ProcessingQuality::Live};
+    ProcessingQuality appliedQuality = ProcessingQuality::Live;
+    std::unique_ptr<juce::dsp::Oversampling<float>> oversampler;
+    int oversampledChannels = 0;
+    
+    // Both tiers' rate-dependent settings, built in prepareToPlay so a tier change is a copy
+    float emuRateFactor = 1.0f;
+    float emuOversampledRateFactor = 0.5f;
+    TubeAmplifierModel::RateCoefficients tubeOversampledRate;
+    
+    void applyProcessingChain(juce::AudioBuffer<float>& buffer, uint32_t stageMask);
+    void applyQualityChange(ProcessingQuality quality);
+    
+    uint32_t getActiveStages(const juce::AudioBuffer<float>& buffer) const;
+    void applyFusedChain(juce::AudioBuffer<float>& buffer, uint32_t stageMask);
+    
+    template <uint32_t Stages>
+    void processFused(juce::AudioBuffer<float>& buffer);
+    
+    template <size_t... StageSets>
+    static std::array<FusedProcessFunction, sizeof...(StageSets)> makeFusedTable(std::index_sequence<StageSets...>);
+    
     // Performance optimization
     void optimizeForPerformance();
     bool shouldBypassProcessing(const juce::AudioBuffer<float>& buffer);
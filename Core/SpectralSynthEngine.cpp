@@ -93,7 +93,7 @@ void SpectralSynthEngine::prepareToPlay(double sampleRate, int samplesPerBlock,
     
     // SECRET: Prepare invisible Audity filter
     if (secretAudityFilter)
-        secretAudityFilter->setSampleRate(sampleRate);
+        secretAudityFilter->prepare(sampleRate, samplesPerBlock, numChannels);
     
     // if (forgeProcessor)  // TODO: Enable when ForgeProcessor is built
     //     forgeProcessor->prepareToPlay(sampleRate, samplesPerBlock);
@@ -297,6 +297,21 @@ void SpectralSynthEngine::releaseResources()
     currentMetrics = PerformanceMetrics{};
 }
 
+//==============================================================================
+// Processing Quality
+//==============================================================================
+
+void SpectralSynthEngine::setProcessingQuality(ProcessingQuality quality)
+{
+    processingQuality.store(quality);
+    
+    if (secretSauceEngine)
+        secretSauceEngine->setProcessingQuality(quality);
+    
+    if (secretAudityFilter)
+        secretAudityFilter->setProcessingQuality(quality);
+}
+
 //==============================================================================
 // Synthesis Mode Control
 //==============================================================================
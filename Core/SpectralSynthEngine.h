@@ -18,6 +18,7 @@
 #include <vector>
 #include <atomic>
 #include <functional>
+#include "ProcessingQuality.h"
 
 // Forward declarations
 class SampleMaskingEngine;
@@ -59,6 +60,13 @@ public:
     void processBlock(juce::AudioBuffer<float>& buffer);
     void releaseResources();
     
+    //==============================================================================
+    // Processing Quality (applies to the enhancement stack: SecretSauce + Audity filter)
+    
+    // Takes the tier already resolved by the owning processor (Render while bouncing)
+    void setProcessingQuality(ProcessingQuality quality);
+    ProcessingQuality getProcessingQuality() const { return processingQuality.load(); }
+    
     //==============================================================================
     // Synthesis Modes - Revolutionary Spectral Integration
     
@@ -285,6 +293,8 @@ private:
     int currentSamplesPerBlock = 512;
     int currentNumChannels = 2;
     
+    std::atomic<ProcessingQuality> processingQuality{ProcessingQuality::Live};
+    
     //==============================================================================
     // Synthesis State
     
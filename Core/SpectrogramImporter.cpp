@@ -0,0 +1,379 @@
+#include "SpectrogramImporter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Same log mapping as CanvasProcessor: row 0 is maxHz, row numRows is minHz
+    float rowToFrequency(float row, int numRows, float minHz, float maxHz)
+    {
+        const float normalisedY = 1.0f - row / static_cast<float>(numRows);
+        const float logMin = std::log(minHz);
+        const float logMax = std::log(maxHz);
+        return std::exp(logMin + normalisedY * (logMax - logMin));
+    }
+    
+    // First sample of a column's frame; frames are spread evenly over the column
+    juce::int64 getFrameStart(double samplesPerColumn, int framesPerColumn, int column, int frame)
+    {
+        const double centre = ((double)column + ((double)frame + 0.5) / (double)framesPerColumn) * samplesPerColumn;
+        return (juce::int64)std::floor(centre) - SpectrogramImporter::FFT_SIZE / 2;
+    }
+}
+
+//==============================================================================
+// Construction
+
+SpectrogramImporter::SpectrogramImporter()
+{
+    formatManager.registerBasicFormats();
+}
+
+//==============================================================================
+// Message Thread
+
+void SpectrogramImporter::startImport(const juce::File& file, int targetColumns, int targetRows)
+{
+    Job job;
+    job.file = file;
+    job.columns = juce::jmax(1, targetColumns);
+    job.rows = juce::jmax(1, targetRows);
+    job.minHz = minFreq;
+    job.maxHz = maxFreq;
+    importJob.start(job);
+}
+
+void SpectrogramImporter::cancel()
+{
+    importJob.cancel();
+}
+
+void SpectrogramImporter::setFrequencyRange(float minHz, float maxHz)
+{
+    minFreq = juce::jmax(1.0f, juce::jmin(minHz, maxHz));
+    maxFreq = juce::jmax(minFreq * 1.01f, maxHz);
+}
+
+bool SpectrogramImporter::canReadFile(const juce::File& file) const
+{
+    return formatManager.findFormatForFileExtension(file.getFileExtension()) != nullptr;
+}
+
+void SpectrogramImporter::clearCache()
+{
+    const juce::ScopedLock lock(cacheLock);
+    cache.clear();
+}
+
+//==============================================================================
+// Analysis Thread
+
+std::shared_ptr<SpectrogramImporter::Result> SpectrogramImporter::importAudio(const Job& job)
+{
+    const auto cacheKey = createCacheKey(job);
+    if (auto cached = findCachedResult(cacheKey))
+    {
+        // Same contents may live under another name; planes and image are shared
+        auto result = std::make_shared<Result>(*cached);
+        result->sourceFile = job.file;
+        return result;
+    }
+    
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(job.file));
+    if (reader == nullptr || reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0)
+        return nullptr;
+    
+    Analysis analysis;
+    analysis.numColumns = job.columns;
+    analysis.numRows = job.rows;
+    analysis.isStereo = reader->numChannels > 1;
+    analysis.power.resize((size_t)job.columns * (size_t)job.rows);
+    if (analysis.isStereo)
+        analysis.balance.resize(analysis.power.size(), 0.5f);
+    
+    const auto layout = createLayout(job, reader->sampleRate);
+    if (!analyseFile(*reader, layout, analysis, job))
+        return nullptr;
+    
+    auto result = createResult(analysis, job);
+    if (cacheKey.isNotEmpty())
+        addCachedResult(cacheKey, result);
+    
+    return result;
+}
+
+bool SpectrogramImporter::analyseFile(juce::AudioFormatReader& reader, const Layout& layout, Analysis& analysis,
+                                      const Job& job)
+{
+    const double samplesPerColumn = (double)reader.lengthInSamples / (double)analysis.numColumns;
+    analysis.samplesPerColumn = samplesPerColumn;
+    
+    // Half-overlapping frames where the column is wide enough; long files sample each column
+    analysis.framesPerColumn = juce::jlimit(1, MAX_FRAMES_PER_COLUMN,
+                                            (int)std::ceil(samplesPerColumn / (FFT_SIZE / 2)));
+    
+    const int numChannels = analysis.isStereo ? 2 : 1;
+    const int columnsPerChunk = juce::jmax(1, (int)(CHUNK_SAMPLES / juce::jmax(1.0, samplesPerColumn)));
+    const int maxChunksInFlight = importJob.getPool().getNumThreads() * 2;
+    
+    std::atomic<int> chunksInFlight{0};
+    std::atomic<int> columnsDone{0};
+    juce::WaitableEvent chunkFinished;
+    
+    // Reading stays sequential on this thread; only the transforms fan out
+    for (int firstColumn = 0; firstColumn < analysis.numColumns && !importJob.isCancelled(job); firstColumn += columnsPerChunk)
+    {
+        // Bound the audio held in memory by waiting for the pool to catch up
+        while (chunksInFlight.load() >= maxChunksInFlight && !importJob.isCancelled(job))
+            chunkFinished.wait(50);
+        
+        const int endColumn = juce::jmin(analysis.numColumns, firstColumn + columnsPerChunk);
+        const auto startSample = getFrameStart(samplesPerColumn, analysis.framesPerColumn, firstColumn, 0);
+        const auto endSample = getFrameStart(samplesPerColumn, analysis.framesPerColumn, endColumn - 1,
+                                             analysis.framesPerColumn - 1) + FFT_SIZE;
+        
+        // Samples outside the file read back as silence
+        auto audio = std::make_shared<juce::AudioBuffer<float>>(numChannels, (int)(endSample - startSample));
+        reader.read(audio.get(), 0, audio->getNumSamples(), startSample, true, analysis.isStereo);
+        
+        ++chunksInFlight;
+        importJob.getPool().addJob([this, &layout, &analysis, &job, &chunksInFlight, &columnsDone, &chunkFinished,
+                             audio, startSample, firstColumn, endColumn]
+        {
+            if (!importJob.isCancelled(job))
+            {
+                analyseColumns(*audio, startSample, firstColumn, endColumn, layout, analysis);
+                
+                // The final normalisation pass takes the rest
+                const int done = columnsDone += endColumn - firstColumn;
+                importJob.setProgress(0.95f * (float)done / (float)analysis.numColumns);
+            }
+            
+            --chunksInFlight;
+            chunkFinished.signal();
+        });
+    }
+    
+    // Jobs reference this frame's locals, so they must all finish even when cancelled
+    while (chunksInFlight.load() > 0)
+        chunkFinished.wait(50);
+    
+    return !importJob.isCancelled(job);
+}
+
+void SpectrogramImporter::analyseColumns(const juce::AudioBuffer<float>& audio, juce::int64 bufferStart,
+                                         int firstColumn, int endColumn, const Layout& layout,
+                                         Analysis& analysis) const
+{
+    juce::dsp::FFT fft(FFT_ORDER);
+    std::vector<float> fftData((size_t)FFT_SIZE * 2);
+    
+    const int numBins = FFT_SIZE / 2 + 1;
+    const int numChannels = analysis.isStereo ? 2 : 1;
+    const float frameScale = 1.0f / (float)(analysis.framesPerColumn * numChannels);
+    std::vector<float> binPower((size_t)numBins * (size_t)numChannels);
+    
+    for (int column = firstColumn; column < endColumn; ++column)
+    {
+        std::fill(binPower.begin(), binPower.end(), 0.0f);
+        
+        for (int frame = 0; frame < analysis.framesPerColumn; ++frame)
+        {
+            const int offset = (int)(getFrameStart(analysis.samplesPerColumn, analysis.framesPerColumn, column, frame)
+                                     - bufferStart);
+            jassert(offset >= 0 && offset + FFT_SIZE <= audio.getNumSamples());
+            
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                std::fill(fftData.begin(), fftData.end(), 0.0f);
+                juce::FloatVectorOperations::copy(fftData.data(), audio.getReadPointer(channel, offset), FFT_SIZE);
+                
+                window.multiplyWithWindowingTable(fftData.data(), static_cast<size_t>(FFT_SIZE));
+                fft.performFrequencyOnlyForwardTransform(fftData.data());
+                
+                float* channelPower = binPower.data() + (size_t)channel * (size_t)numBins;
+                for (int bin = 0; bin < numBins; ++bin)
+                    channelPower[bin] += fftData[(size_t)bin] * fftData[(size_t)bin];
+            }
+        }
+        
+        const float* leftPower = binPower.data();
+        const float* rightPower = binPower.data() + (size_t)(numChannels - 1) * (size_t)numBins;
+        
+        for (int row = 0; row < analysis.numRows; ++row)
+        {
+            const auto& bins = layout.rows[(size_t)row];
+            const float* weights = layout.weights.data() + bins.weightOffset;
+            float left = 0.0f, right = 0.0f;
+            
+            for (int i = 0; i < bins.numBins; ++i)
+            {
+                left += weights[i] * leftPower[bins.firstBin + i];
+                right += weights[i] * rightPower[bins.firstBin + i];
+            }
+            
+            const size_t index = (size_t)column * (size_t)analysis.numRows + (size_t)row;
+            if (analysis.isStereo)
+            {
+                analysis.power[index] = (left + right) * frameScale;
+                analysis.balance[index] = left + right > 0.0f ? right / (left + right) : 0.5f;
+            }
+            else
+            {
+                analysis.power[index] = left * frameScale;
+            }
+        }
+    }
+}
+
+std::shared_ptr<SpectrogramImporter::Result> SpectrogramImporter::createResult(const Analysis& analysis,
+                                                                               const Job& job) const
+{
+    auto result = std::make_shared<Result>();
+    result->sourceFile = job.file;
+    result->image = juce::Image(juce::Image::ARGB, analysis.numColumns, analysis.numRows, false,
+                                juce::SoftwareImageType());
+    
+    auto planes = std::make_shared<ImageImporter::Planes>();
+    planes->numColumns = analysis.numColumns;
+    planes->numRows = analysis.numRows;
+    planes->hasColour = analysis.isStereo;
+    planes->brightness.resize(analysis.power.size());
+    planes->hue.resize(analysis.power.size(), 0.5f);
+    
+    const float peak = analysis.power.empty() ? 0.0f
+                                              : *std::max_element(analysis.power.begin(), analysis.power.end());
+    const float peakScale = peak > 0.0f ? 1.0f / peak : 0.0f;
+    
+    juce::Image::BitmapData pixels(result->image, juce::Image::BitmapData::writeOnly);
+    
+    for (int column = 0; column < analysis.numColumns; ++column)
+    {
+        for (int row = 0; row < analysis.numRows; ++row)
+        {
+            const size_t index = (size_t)column * (size_t)analysis.numRows + (size_t)row;
+            
+            // Power in dB below the file's peak, mapped onto the displayed range
+            const float decibels = 10.0f * std::log10(juce::jmax(1.0e-12f, analysis.power[index] * peakScale));
+            const float brightness = juce::jlimit(0.0f, 1.0f, 1.0f + decibels / DYNAMIC_RANGE_DB);
+            planes->brightness[index] = brightness;
+            
+            if (analysis.isStereo)
+            {
+                planes->hue[index] = analysis.balance[index];
+                pixels.setPixelColour(column, row, juce::Colour::fromHSV(analysis.balance[index], 0.6f, brightness, 1.0f));
+            }
+            else
+            {
+                pixels.setPixelColour(column, row, juce::Colour::greyLevel(brightness));
+            }
+        }
+    }
+    
+    result->planes = std::move(planes);
+    return result;
+}
+
+//==============================================================================
+// Layout and Cache
+
+SpectrogramImporter::Layout SpectrogramImporter::createLayout(const Job& job, double sampleRate)
+{
+    Layout layout;
+    layout.rows.resize((size_t)job.rows);
+    
+    const float binsPerHz = (float)(FFT_SIZE / sampleRate);
+    const float lastBin = (float)(FFT_SIZE / 2);
+    
+    for (int row = 0; row < job.rows; ++row)
+    {
+        auto& bins = layout.rows[(size_t)row];
+        bins.weightOffset = layout.weights.size();
+        
+        // Bin b covers [b - 0.5, b + 0.5) in fractional bin positions
+        const float lowBin = juce::jlimit(0.0f, lastBin, rowToFrequency((float)row + 0.5f, job.rows, job.minHz, job.maxHz) * binsPerHz);
+        const float highBin = juce::jlimit(0.0f, lastBin, rowToFrequency((float)row - 0.5f, job.rows, job.minHz, job.maxHz) * binsPerHz);
+        
+        if (highBin - lowBin >= 1.0f)
+        {
+            bins.firstBin = (int)std::floor(lowBin + 0.5f);
+            const int endBin = juce::jmin((int)lastBin + 1, (int)std::ceil(highBin + 0.5f));
+            
+            for (int bin = bins.firstBin; bin < endBin; ++bin)
+                layout.weights.push_back(juce::jmax(0.0f, juce::jmin(highBin, (float)bin + 0.5f)
+                                                          - juce::jmax(lowBin, (float)bin - 0.5f)));
+        }
+        else
+        {
+            // Narrower than a bin: interpolate between the two nearest
+            const float centre = juce::jlimit(0.0f, lastBin, rowToFrequency((float)row, job.rows, job.minHz, job.maxHz) * binsPerHz);
+            bins.firstBin = juce::jmin((int)lastBin - 1, (int)centre);
+            const float fraction = centre - (float)bins.firstBin;
+            
+            layout.weights.push_back(1.0f - fraction);
+            layout.weights.push_back(fraction);
+        }
+        
+        bins.numBins = (int)(layout.weights.size() - bins.weightOffset);
+        
+        float total = 0.0f;
+        for (size_t i = bins.weightOffset; i < layout.weights.size(); ++i)
+            total += layout.weights[i];
+        
+        for (size_t i = bins.weightOffset; i < layout.weights.size() && total > 0.0f; ++i)
+            layout.weights[i] /= total;
+    }
+    
+    return layout;
+}
+
+juce::String SpectrogramImporter::createCacheKey(const Job& job)
+{
+    // Hashing both ends plus size and date stands in for a full content hash,
+    // which would cost a second pass over long files
+    juce::FileInputStream input(job.file);
+    if (!input.openedOk())
+        return {};
+    
+    juce::MemoryOutputStream fingerprint;
+    fingerprint.writeInt64(input.getTotalLength());
+    fingerprint.writeInt64(job.file.getLastModificationTime().toMilliseconds());
+    fingerprint.writeFromInputStream(input, FINGERPRINT_BYTES);
+    
+    if (input.getTotalLength() > FINGERPRINT_BYTES * 2)
+    {
+        input.setPosition(input.getTotalLength() - FINGERPRINT_BYTES);
+        fingerprint.writeFromInputStream(input, FINGERPRINT_BYTES);
+    }
+    
+    fingerprint.writeInt(job.columns);
+    fingerprint.writeInt(job.rows);
+    fingerprint.writeFloat(job.minHz);
+    fingerprint.writeFloat(job.maxHz);
+    
+    return juce::MD5(fingerprint.getMemoryBlock()).toHexString();
+}
+
+std::shared_ptr<const SpectrogramImporter::Result> SpectrogramImporter::findCachedResult(const juce::String& key)
+{
+    if (key.isEmpty())
+        return nullptr;
+    
+    const juce::ScopedLock lock(cacheLock);
+    const auto entry = std::find_if(cache.begin(), cache.end(), [&](const auto& cached) { return cached.first == key; });
+    if (entry == cache.end())
+        return nullptr;
+    
+    // Move to the front so the least recently used entry is evicted first
+    std::rotate(cache.begin(), entry, entry + 1);
+    return cache.front().second;
+}
+
+void SpectrogramImporter::addCachedResult(const juce::String& key, std::shared_ptr<const Result> result)
+{
+    const juce::ScopedLock lock(cacheLock);
+    cache.insert(cache.begin(), { key, std::move(result) });
+    
+    if ((int)cache.size() > MAX_CACHED_RESULTS)
+        cache.resize((size_t)MAX_CACHED_RESULTS);
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "ImageImporter.h"
+#include "BackgroundJob.h"
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * SpectrogramImporter - Turns an audio file into a paintable canvas
+ *
+ * Streams the file through an AudioFormatReader in bounded chunks and runs
+ * the STFT for each chunk on a thread pool. Every canvas column averages the
+ * power of several Hann-windowed frames across its span of the file, and the
+ * bins are folded into the canvas's log-frequency rows (top row = maxHz).
+ * Levels are normalised to the file's peak over DYNAMIC_RANGE_DB.
+ *
+ * The output is the same Result that ImageImporter produces: brightness is the
+ * level and, for stereo files, hue is the right/left balance, which is what
+ * CanvasProcessor reads as pan. Results are cached by a fingerprint of the
+ * file contents plus the analysis settings, so re-importing is instant.
+ */
+class SpectrogramImporter
+{
+public:
+    using Result = ImageImporter::Result;
+    
+    static constexpr int FFT_ORDER = 12;
+    static constexpr int FFT_SIZE = 1 << FFT_ORDER;
+    static constexpr float DYNAMIC_RANGE_DB = 80.0f;
+    static constexpr int MAX_CACHED_RESULTS = 8;
+    
+    SpectrogramImporter();
+    
+    //==============================================================================
+    // Message thread
+    
+    void startImport(const juce::File& file, int targetColumns, int targetRows);
+    void cancel();
+    
+    // Range the rows span; should match the processor the result is sent to
+    void setFrequencyRange(float minHz, float maxHz);
+    
+    bool isImporting() const { return importJob.isBusy(); }
+    float getProgress() const { return importJob.getProgress(); }
+    
+    // Finished import, handed over once; nullptr until then
+    std::shared_ptr<const Result> takeResult() { return importJob.takeResult(); }
+    
+    bool canReadFile(const juce::File& file) const;
+    void clearCache();
+
+private:
+    static constexpr int MAX_FRAMES_PER_COLUMN = 16;
+    static constexpr int CHUNK_SAMPLES = 1 << 20;       // Audio read per pool job, per channel
+    static constexpr int FINGERPRINT_BYTES = 1 << 18;   // Hashed from each end of the file
+    
+    struct Job
+    {
+        juce::File file;
+        int columns = 0;
+        int rows = 0;
+        float minHz = 20.0f;
+        float maxHz = 20000.0f;
+        juce::uint32 generation = 0;
+    };
+    
+    // FFT bins averaged into one row; a single bin pair interpolates narrow rows
+    struct RowBins
+    {
+        int firstBin = 0;
+        int numBins = 0;
+        size_t weightOffset = 0;
+    };
+    
+    struct Layout
+    {
+        std::vector<RowBins> rows;
+        std::vector<float> weights;
+    };
+    
+    // Column-major power and right/(left + right) balance for the whole file
+    struct Analysis
+    {
+        int numColumns = 0;
+        int numRows = 0;
+        bool isStereo = false;
+        double samplesPerColumn = 0.0;
+        int framesPerColumn = 1;
+        std::vector<float> power;
+        std::vector<float> balance;
+    };
+    
+    std::shared_ptr<Result> importAudio(const Job& job);
+    bool analyseFile(juce::AudioFormatReader& reader, const Layout& layout, Analysis& analysis, const Job& job);
+    void analyseColumns(const juce::AudioBuffer<float>& audio, juce::int64 bufferStart, int firstColumn,
+                        int endColumn, const Layout& layout, Analysis& analysis) const;
+    std::shared_ptr<Result> createResult(const Analysis& analysis, const Job& job) const;
+    
+    static Layout createLayout(const Job& job, double sampleRate);
+    static juce::String createCacheKey(const Job& job);
+    
+    std::shared_ptr<const Result> findCachedResult(const juce::String& key);
+    void addCachedResult(const juce::String& key, std::shared_ptr<const Result> result);
+    
+    juce::AudioFormatManager formatManager;
+    juce::dsp::WindowingFunction<float> window{static_cast<size_t>(FFT_SIZE), juce::dsp::WindowingFunction<float>::hann};
+    
+    // Message thread only; copied into each job
+    float minFreq = 20.0f;
+    float maxFreq = 20000.0f;
+    
+    // Most recently used first
+    juce::CriticalSection cacheLock;
+    std::vector<std::pair<juce::String, std::shared_ptr<const Result>>> cache;
+    
+    BackgroundJob<Job, Result> importJob{ "Spectrogram Import", [this](const Job& job) { return importAudio(job); } };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrogramImporter)
+};
@@ -1,4 +1,5 @@
 #include "VisualFeedbackEngine.h"
+#include <algorithm>
 #include <cmath>
 
 //==============================================================================
@@ -24,6 +25,13 @@ VisualFeedbackEngine::VisualFeedbackEngine()
     drumBands[10] = {8000.0f, 15000.0f, 0.0f, 0.0f, juce::Colours::white, "Closed Hat"};
     drumBands[11] = {10000.0f, 16000.0f, 0.0f, 0.0f, juce::Colours::lightgrey, "Shaker"};
     
+    // The analysis thread measures the same ranges without touching the visual state
+    for (size_t i = 0; i < drumBands.size(); ++i)
+        drumBandRanges[i] = {drumBands[i].lowFreq, drumBands[i].highFreq};
+    
+    updateBandLayout();
+    frequencyVisualization.bandFrequencies = analysisState.bandFrequencies;
+    
     // Initialize tracker colors
     auto& trackColors = trackerVisualization.trackColors;
     for (int i = 0; i < TrackerVisualization::MAX_TRACKS; ++i)
@@ -43,6 +51,7 @@ VisualFeedbackEngine::VisualFeedbackEngine()
 
 VisualFeedbackEngine::~VisualFeedbackEngine()
 {
+    analysisThread.stopThread(1000);
     shutdown();
 }
 
@@ -67,8 +76,8 @@ void VisualFeedbackEngine::initialize(juce::OpenGLContext* glContext)
 
 void VisualFeedbackEngine::shutdown()
 {
-    activePaintTrails.clear();
-    activeParticles.clear();
+    trailPool.count = 0;
+    particlePool.count = 0;
     // TODO: Reset renderer pointers when implemented
     // openGLRenderer.reset();
     // softwareRenderer.reset();
@@ -83,6 +92,24 @@ void VisualFeedbackEngine::renderFrame(juce::Graphics& g, juce::Rectangle<int> b
     lastFrameTime = currentFrameTime;
     currentTime += deltaTime;
     
+    const auto renderStartTicks = juce::Time::getHighResolutionTicks();
+    
+    // Pick up the newest analysed spectrum, if any
+    if ((sharedSnapshot.load(std::memory_order_acquire) & SNAPSHOT_FRESH) != 0)
+    {
+        readSnapshot = sharedSnapshot.exchange(readSnapshot, std::memory_order_acq_rel) & SNAPSHOT_INDEX_MASK;
+        const auto& snapshot = snapshotBuffers[static_cast<size_t>(readSnapshot)];
+        applySpectrumSnapshot(snapshot);
+        writeWaterfallColumns(snapshot);
+        
+        // Particle bursts follow the audio energy
+        if (particleEffectsEnabled.load() && getQualityLevel() >= QualityLevel::Balanced && snapshot.rmsLevel > 0.1f)
+        {
+            createParticleSystem(bounds.getCentre().toFloat(), currentColorTheme.accentColor,
+                               static_cast<int>(snapshot.rmsLevel * 50));
+        }
+    }
+    
     // Update animations and effects
     updateAnimation(deltaTime);
     updateEffects(deltaTime);
@@ -103,6 +130,8 @@ void VisualFeedbackEngine::renderFrame(juce::Graphics& g, juce::Rectangle<int> b
     juce::Graphics::ScopedSaveState saveState(g);
     g.addTransform(transform);
     
+    auto stageStartTicks = juce::Time::getHighResolutionTicks();
+    
     // Render main visualization based on mode
     switch (getVisualizationMode())
     {
@@ -124,16 +153,22 @@ void VisualFeedbackEngine::renderFrame(juce::Graphics& g, juce::Rectangle<int> b
         case VisualizationMode::ParticleField:
             renderParticleField(g, bounds);
             break;
+        case VisualizationMode::Waterfall:
+            renderWaterfall(g, bounds);
+            break;
         default:
             renderSpectrum2D(g, bounds);
             break;
     }
+    finishStage(RenderStage::Visualization, stageStartTicks);
     
     // Render paint trails
     renderPaintTrails(g);
+    finishStage(RenderStage::PaintTrails, stageStartTicks);
     
     // Render particles
     renderParticles(g);
+    finishStage(RenderStage::Particles, stageStartTicks);
     
     // Render tracker pattern if visible
     if (getQualityLevel() >= QualityLevel::Balanced)
@@ -141,9 +176,16 @@ void VisualFeedbackEngine::renderFrame(juce::Graphics& g, juce::Rectangle<int> b
         auto trackerBounds = bounds.removeFromBottom(200);
         trackerVisualization.renderPattern(g, trackerBounds);
     }
+    finishStage(RenderStage::TrackerPattern, stageStartTicks);
     
     // Render screen effects (flash, chromatic aberration, etc.)
     renderScreenEffects(g, bounds);
+    finishStage(RenderStage::ScreenEffects, stageStartTicks);
+    
+    // Adapt quality to what this frame cost
+    const auto renderMs = static_cast<float>(juce::Time::highResolutionTicksToSeconds(
+        juce::Time::getHighResolutionTicks() - renderStartTicks) * 1000.0);
+    runQualityGovernor(renderMs);
     
     // Update performance metrics
     updatePerformanceMetrics();
@@ -152,46 +194,69 @@ void VisualFeedbackEngine::renderFrame(juce::Graphics& g, juce::Rectangle<int> b
 //==============================================================================
 // Audio Data Updates
 
+void VisualFeedbackEngine::prepareAudioTap(double sampleRate)
+{
+    // Decimate by a whole factor while keeping the tap at TAP_MIN_RATE or above
+    analysisThread.stopThread(1000);
+    decimationFactor = juce::jmax(1, static_cast<int>(sampleRate / TAP_MIN_RATE));
+    decimationCounter = 0;
+    decimationAccumulator = 0.0f;
+    tapFifo.reset();
+    
+    tapSampleRate = sampleRate / decimationFactor;
+    std::fill(analysisHistory.begin(), analysisHistory.end(), 0.0f);
+    analysisState = SpectrumSnapshot();
+    peakAges.fill(0.0f);
+    lastAnalysisTimeMs = 0.0;
+    updateBandLayout();
+    
+    analysisThread.startThread(juce::Thread::Priority::low);
+}
+
 void VisualFeedbackEngine::updateAudioData(const juce::AudioBuffer<float>& buffer)
 {
-    if (buffer.getNumSamples() == 0) return;
+    // Audio thread: mono-sum, box-filter decimate, then one FIFO write per scratch fill
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
     
-    // Update frequency visualization with basic spectrum analysis
-    const int fftSize = 512;
-    std::vector<float> spectrum(fftSize / 2);
+    if (numChannels == 0) return;
     
-    // Simple magnitude calculation (in real implementation would use proper FFT)
-    const float* channelData = buffer.getReadPointer(0);
-    const int numSamples = juce::jmin(buffer.getNumSamples(), fftSize);
+    const float channelScale = 1.0f / static_cast<float>(numChannels * decimationFactor);
+    int scratchCount = 0;
     
-    for (int i = 0; i < spectrum.size(); ++i)
+    auto flushScratch = [this, &scratchCount]
     {
-        float magnitude = 0.0f;
-        if (i < numSamples)
-        {
-            magnitude = std::abs(channelData[i]);
-        }
-        spectrum[i] = magnitude;
-    }
-    
-    updateSpectrumData(spectrum);
+        int start1, size1, start2, size2;
+        tapFifo.prepareToWrite(scratchCount, start1, size1, start2, size2);
+        
+        std::copy(decimationScratch.begin(), decimationScratch.begin() + size1, tapRing.begin() + start1);
+        std::copy(decimationScratch.begin() + size1, decimationScratch.begin() + size1 + size2, tapRing.begin() + start2);
+        tapFifo.finishedWrite(size1 + size2);
+        
+        if (size1 + size2 < scratchCount)
+            tapOverflowCount.fetch_add(1, std::memory_order_relaxed);
+        
+        scratchCount = 0;
+    };
     
-    // Create particles based on audio energy
-    if (particleEffectsEnabled.load() && getQualityLevel() >= QualityLevel::Balanced)
+    for (int sample = 0; sample < numSamples; ++sample)
     {
-        float energy = 0.0f;
-        for (int i = 0; i < numSamples; ++i)
-        {
-            energy += std::abs(channelData[i]);
-        }
-        energy /= numSamples;
+        for (int channel = 0; channel < numChannels; ++channel)
+            decimationAccumulator += buffer.getReadPointer(channel)[sample];
         
-        if (energy > 0.1f) // Threshold for particle creation
+        if (++decimationCounter >= decimationFactor)
         {
-            createParticleSystem({400.0f, 300.0f}, currentColorTheme.accentColor, 
-                               static_cast<int>(energy * 50));
+            decimationScratch[static_cast<size_t>(scratchCount++)] = decimationAccumulator * channelScale;
+            decimationAccumulator = 0.0f;
+            decimationCounter = 0;
+            
+            if (scratchCount == static_cast<int>(decimationScratch.size()))
+                flushScratch();
         }
     }
+    
+    if (scratchCount > 0)
+        flushScratch();
 }
 
 void VisualFeedbackEngine::updateSpectrumData(const std::vector<float>& magnitudeSpectrum)
@@ -205,97 +270,306 @@ void VisualFeedbackEngine::updateTrackerData(const std::vector<std::vector<int>>
 }
 
 //==============================================================================
-// Paint Stroke Visualization
+// Spectrum Analysis
 
-void VisualFeedbackEngine::addPaintStroke(const juce::Path& path, juce::Colour color, float intensity)
+void VisualFeedbackEngine::updateBandLayout()
 {
-    PaintTrail trail;
-    trail.strokePath = path;
-    trail.color = color;
-    trail.intensity = intensity;
-    trail.age = 0.0f;
-    trail.maxAge = paintTrailLength.load();
-    trail.glowRadius = intensity * 10.0f;
-    trail.strokeWidth = intensity * 5.0f;
-    trail.hasParticles = paintParticlesEnabled.load();
+    // Log-spaced bands from MIN_BAND_FREQUENCY to Nyquist, measured in fractional FFT bins
+    const int numBands = FrequencyVisualization::NUM_BANDS;
+    const float binHz = static_cast<float>(tapSampleRate / FFT_SIZE);
+    const float octaves = std::log2(static_cast<float>(tapSampleRate * 0.5) / MIN_BAND_FREQUENCY);
     
-    // Generate particles along the path if enabled
-    if (trail.hasParticles && getQualityLevel() >= QualityLevel::Quality)
+    for (int band = 0; band < numBands; ++band)
     {
-        const float pathLength = path.getLength();
-        const int particleCount = static_cast<int>(pathLength / 10.0f);
+        const float low = MIN_BAND_FREQUENCY * std::pow(2.0f, octaves * band / numBands);
+        const float high = MIN_BAND_FREQUENCY * std::pow(2.0f, octaves * (band + 1) / numBands);
         
-        for (int i = 0; i < particleCount; ++i)
+        bandLowBins[static_cast<size_t>(band)] = low / binHz;
+        bandHighBins[static_cast<size_t>(band)] = high / binHz;
+        analysisState.bandFrequencies[static_cast<size_t>(band)] = std::sqrt(low * high);
+    }
+}
+
+void VisualFeedbackEngine::runSpectrumAnalysis()
+{
+    // Analysis thread: drain the tap into a sliding history window
+    const int available = tapFifo.getNumReady();
+    if (available == 0) return;
+    
+    int start1, size1, start2, size2;
+    tapFifo.prepareToRead(available, start1, size1, start2, size2);
+    std::copy(tapRing.begin() + start1, tapRing.begin() + start1 + size1, analysisIncoming.begin());
+    std::copy(tapRing.begin() + start2, tapRing.begin() + start2 + size2, analysisIncoming.begin() + size1);
+    tapFifo.finishedRead(size1 + size2);
+    
+    const int numNew = size1 + size2;
+    const int historySize = static_cast<int>(analysisHistory.size());
+    
+    if (numNew >= historySize)
+    {
+        std::copy(analysisIncoming.begin() + (numNew - historySize), analysisIncoming.begin() + numNew, analysisHistory.begin());
+    }
+    else
+    {
+        std::move(analysisHistory.begin() + numNew, analysisHistory.end(), analysisHistory.begin());
+        std::copy(analysisIncoming.begin(), analysisIncoming.begin() + numNew, analysisHistory.end() - numNew);
+    }
+    
+    float sumSquares = 0.0f;
+    for (int i = 0; i < numNew; ++i)
+        sumSquares += analysisIncoming[static_cast<size_t>(i)] * analysisIncoming[static_cast<size_t>(i)];
+    analysisState.rmsLevel = std::sqrt(sumSquares / numNew);
+    
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    const float elapsed = lastAnalysisTimeMs > 0.0
+        ? juce::jlimit(0.0f, 0.25f, static_cast<float>((nowMs - lastAnalysisTimeMs) / 1000.0))
+        : 1.0f / ANALYSIS_RATE_HZ;
+    lastAnalysisTimeMs = nowMs;
+    
+    // Hann-windowed magnitudes; the normalised window puts a full-scale sine at 0 dB
+    std::copy(analysisHistory.begin(), analysisHistory.end(), fftData.begin());
+    std::fill(fftData.begin() + FFT_SIZE, fftData.end(), 0.0f);
+    window.multiplyWithWindowingTable(fftData.data(), static_cast<size_t>(FFT_SIZE));
+    fft.performFrequencyOnlyForwardTransform(fftData.data());
+    
+    const float magnitudeScale = 2.0f / FFT_SIZE;
+    for (size_t bin = 0; bin < binLevels.size(); ++bin)
+    {
+        const float decibels = juce::Decibels::gainToDecibels(fftData[bin] * magnitudeScale, -DYNAMIC_RANGE_DB);
+        binLevels[bin] = 1.0f + decibels / DYNAMIC_RANGE_DB;
+    }
+    
+    const int lastBin = static_cast<int>(binLevels.size()) - 1;
+    
+    for (size_t band = 0; band < bandLowBins.size(); ++band)
+    {
+        const int firstBin = static_cast<int>(std::ceil(bandLowBins[band]));
+        const int endBin = juce::jmin(lastBin, static_cast<int>(std::floor(bandHighBins[band])));
+        float level = 0.0f;
+        
+        if (endBin >= firstBin)
         {
-            const float t = static_cast<float>(i) / particleCount;
-            juce::Point<float> point;
-            path.getNearestPoint(path.getPointAlongPath(pathLength * t), point);
-            trail.particles.push_back(point);
+            // Wide bands show the strongest bin they cover
+            for (int bin = firstBin; bin <= endBin; ++bin)
+                level = juce::jmax(level, binLevels[static_cast<size_t>(bin)]);
+        }
+        else
+        {
+            // Bands narrower than a bin interpolate at their centre
+            const float centre = juce::jlimit(0.0f, static_cast<float>(lastBin), (bandLowBins[band] + bandHighBins[band]) * 0.5f);
+            const int index = static_cast<int>(centre);
+            const int next = juce::jmin(index + 1, lastBin);
+            level = binLevels[static_cast<size_t>(index)]
+                  + (centre - index) * (binLevels[static_cast<size_t>(next)] - binLevels[static_cast<size_t>(index)]);
+        }
+        
+        analysisState.magnitudes[band] = level;
+        
+        // Peak hold, then a steady fall
+        auto& peak = analysisState.peakValues[band];
+        if (level >= peak)
+        {
+            peak = level;
+            peakAges[band] = 0.0f;
+        }
+        else
+        {
+            peakAges[band] += elapsed;
+            if (peakAges[band] > PEAK_HOLD_SECONDS)
+                peak = juce::jmax(level, peak - PEAK_FALL_PER_SECOND * elapsed);
         }
     }
     
-    activePaintTrails.push_back(trail);
+    // Drum bands take the strongest bin in their range
+    const float binHz = static_cast<float>(tapSampleRate / FFT_SIZE);
+    const float drumPeakDecay = std::pow(0.98f, elapsed * ANALYSIS_RATE_HZ);
     
-    // Limit number of active trails for performance
-    const int maxTrails = (getQualityLevel() == QualityLevel::Performance) ? 10 : 50;
-    if (activePaintTrails.size() > maxTrails)
+    for (size_t i = 0; i < drumBandRanges.size(); ++i)
     {
-        activePaintTrails.erase(activePaintTrails.begin());
+        const auto range = drumBandRanges[i];
+        float level = 0.0f;
+        
+        if (range.second > range.first)
+        {
+            const int firstBin = juce::jlimit(0, lastBin, static_cast<int>(range.first / binHz));
+            const int endBin = juce::jlimit(0, lastBin, static_cast<int>(range.second / binHz));
+            
+            for (int bin = firstBin; bin <= endBin; ++bin)
+                level = juce::jmax(level, binLevels[static_cast<size_t>(bin)]);
+        }
+        
+        analysisState.drumLevels[i] = level;
+        analysisState.drumPeaks[i] = juce::jmax(level, analysisState.drumPeaks[i] * drumPeakDecay);
     }
+    
+    publishSnapshot();
 }
 
-void VisualFeedbackEngine::clearPaintStrokes()
+void VisualFeedbackEngine::publishSnapshot()
 {
-    activePaintTrails.clear();
+    ++analysisState.sequence;
+    snapshotBuffers[static_cast<size_t>(writeSnapshot)] = analysisState;
+    writeSnapshot = sharedSnapshot.exchange(writeSnapshot | SNAPSHOT_FRESH, std::memory_order_acq_rel) & SNAPSHOT_INDEX_MASK;
 }
 
-void VisualFeedbackEngine::PaintTrail::update(float deltaTime)
+void VisualFeedbackEngine::applySpectrumSnapshot(const SpectrumSnapshot& snapshot)
 {
-    age += deltaTime;
-    isActive = (age < maxAge);
+    frequencyVisualization.magnitudes = snapshot.magnitudes;
+    frequencyVisualization.peakValues = snapshot.peakValues;
+    frequencyVisualization.bandFrequencies = snapshot.bandFrequencies;
     
-    // Update particle positions
-    for (auto& particle : particles)
+    auto& drumBands = frequencyVisualization.drumFrequencyBands;
+    for (size_t i = 0; i < drumBands.size(); ++i)
     {
-        // Simple particle animation
-        particle.x += (juce::Random::getSystemRandom().nextFloat() - 0.5f) * 2.0f;
-        particle.y += (juce::Random::getSystemRandom().nextFloat() - 0.5f) * 2.0f;
+        drumBands[i].currentLevel = snapshot.drumLevels[i];
+        drumBands[i].peakLevel = snapshot.drumPeaks[i];
+        drumBands[i].isActive = snapshot.drumLevels[i] > 0.25f;   // Above -60 dB
     }
+    
+    spectrumFromAnalyser = true;
 }
 
-void VisualFeedbackEngine::PaintTrail::render(juce::Graphics& g, const juce::AffineTransform& transform) const
+//==============================================================================
+// Waterfall
+
+void VisualFeedbackEngine::rebuildWaterfallLut()
 {
-    if (!isActive) return;
+    // The getSpectrumColor ranges, blended up from the background and
+    // brightening towards white for the loudest partials
+    const juce::Colour rangeColours[] = { currentColorTheme.spectrumLow,
+                                          currentColorTheme.spectrumMid,
+                                          currentColorTheme.spectrumHigh };
     
-    const float alpha = 1.0f - (age / maxAge);
-    const juce::Colour drawColor = color.withAlpha(alpha * intensity);
-    
-    // Render glow effect
-    if (glowRadius > 0.0f && alpha > 0.1f)
+    for (size_t range = 0; range < waterfallLut.size(); ++range)
     {
-        for (float r = glowRadius; r > 0; r -= 1.0f)
+        for (int level = 0; level < WATERFALL_LUT_SIZE; ++level)
         {
-            const float glowAlpha = (1.0f - r / glowRadius) * alpha * 0.1f;
-            g.setColour(drawColor.withAlpha(glowAlpha));
-            g.strokePath(strokePath, juce::PathStrokeType(strokeWidth + r * 2.0f), transform);
+            const float magnitude = static_cast<float>(level) / (WATERFALL_LUT_SIZE - 1);
+            auto colour = currentColorTheme.backgroundColor.interpolatedWith(rangeColours[range], magnitude);
+            
+            if (magnitude > 0.75f)
+                colour = colour.interpolatedWith(juce::Colours::white, (magnitude - 0.75f) * 2.0f);
+            
+            waterfallLut[range][static_cast<size_t>(level)] = colour;
         }
     }
     
-    // Render main stroke
-    g.setColour(drawColor);
-    g.strokePath(strokePath, juce::PathStrokeType(strokeWidth), transform);
+    waterfallLutDirty = false;
+}
+
+void VisualFeedbackEngine::writeWaterfallColumns(const SpectrumSnapshot& snapshot)
+{
+    const int numBands = FrequencyVisualization::NUM_BANDS;
     
-    // Render particles
-    if (hasParticles)
+    if (waterfallLutDirty)
+        rebuildWaterfallLut();
+    
+    if (!waterfallImage.isValid())
+        waterfallImage = juce::Image(juce::Image::RGB, WATERFALL_HISTORY, numBands, true);
+    
+    // Hops that landed between frames repeat the newest column, keeping the time axis even
+    const juce::uint32 hops = snapshot.sequence > lastWaterfallSequence ? snapshot.sequence - lastWaterfallSequence : 1;
+    const int numColumns = static_cast<int>(juce::jmin(hops, static_cast<juce::uint32>(WATERFALL_HISTORY)));
+    lastWaterfallSequence = snapshot.sequence;
+    
+    for (int band = 0; band < numBands; ++band)
     {
-        g.setColour(drawColor.withAlpha(alpha * 0.8f));
-        for (const auto& particle : particles)
+        const int range = getSpectrumRange(snapshot.bandFrequencies[band]);
+        const int level = juce::jlimit(0, WATERFALL_LUT_SIZE - 1,
+                                       static_cast<int>(snapshot.magnitudes[band] * (WATERFALL_LUT_SIZE - 1)));
+        waterfallColumn[band] = waterfallLut[static_cast<size_t>(range)][static_cast<size_t>(level)];
+    }
+    
+    for (int column = 0; column < numColumns; ++column)
+    {
+        juce::Image::BitmapData pixels(waterfallImage, waterfallWriteColumn, 0, 1, numBands,
+                                       juce::Image::BitmapData::writeOnly);
+        
+        // Low frequencies at the bottom
+        for (int band = 0; band < numBands; ++band)
+            pixels.setPixelColour(0, numBands - 1 - band, waterfallColumn[band]);
+        
+        waterfallWriteColumn = (waterfallWriteColumn + 1) % WATERFALL_HISTORY;
+    }
+}
+
+void VisualFeedbackEngine::renderWaterfall(juce::Graphics& g, juce::Rectangle<int> bounds)
+{
+    if (!waterfallImage.isValid() || bounds.isEmpty())
+        return;
+    
+    // Oldest history starts at the write position: draw [write, end) on the left,
+    // then [0, write) up to the right edge
+    const int numBands = FrequencyVisualization::NUM_BANDS;
+    const int olderColumns = WATERFALL_HISTORY - waterfallWriteColumn;
+    const int splitX = bounds.getX() + bounds.getWidth() * olderColumns / WATERFALL_HISTORY;
+    
+    g.setImageResamplingQuality(juce::Graphics::lowResamplingQuality);
+    g.drawImage(waterfallImage, bounds.getX(), bounds.getY(), splitX - bounds.getX(), bounds.getHeight(),
+                waterfallWriteColumn, 0, olderColumns, numBands);
+    
+    if (waterfallWriteColumn > 0)
+    {
+        g.drawImage(waterfallImage, splitX, bounds.getY(), bounds.getRight() - splitX, bounds.getHeight(),
+                    0, 0, waterfallWriteColumn, numBands);
+    }
+}
+
+void VisualFeedbackEngine::AnalysisThread::run()
+{
+    while (!threadShouldExit())
+    {
+        engine.runSpectrumAnalysis();
+        wait(juce::roundToInt(1000.0f / ANALYSIS_RATE_HZ));
+    }
+}
+
+//==============================================================================
+// Paint Stroke Visualization
+
+void VisualFeedbackEngine::addPaintStroke(const juce::Path& path, juce::Colour color, float intensity)
+{
+    const int trail = trailPool.allocate(getTrailCap());
+    trailPool.paths[trail] = path;
+    trailPool.colour[trail] = color.getARGB();
+    trailPool.intensity[trail] = intensity;
+    trailPool.age[trail] = 0.0f;
+    trailPool.maxAge[trail] = paintTrailLength.load();
+    trailPool.glowRadius[trail] = intensity * 10.0f;
+    trailPool.strokeWidth[trail] = intensity * 5.0f;
+    
+    // Scatter drifting dots along the stroke; they live in the particle pool and
+    // fade out with the trail
+    if (paintParticlesEnabled.load() && getQualityLevel() >= QualityLevel::Quality)
+    {
+        auto& random = juce::Random::getSystemRandom();
+        const float pathLength = path.getLength();
+        const int cap = getParticleCap();
+        const int particleCount = juce::jmin(cap, static_cast<int>(pathLength / 10.0f));
+        const juce::uint32 dotColour = color.withAlpha(0.8f).getARGB();
+        
+        for (int n = 0; n < particleCount; ++n)
         {
-            g.fillEllipse(particle.x - 1, particle.y - 1, 2, 2);
+            const auto point = path.getPointAlongPath(pathLength * n / particleCount);
+            const int i = particlePool.allocate(cap);
+            
+            particlePool.x[i] = point.x;
+            particlePool.y[i] = point.y;
+            particlePool.vx[i] = (random.nextFloat() - 0.5f) * 60.0f;
+            particlePool.vy[i] = (random.nextFloat() - 0.5f) * 60.0f;
+            particlePool.gravity[i] = 0.0f;
+            particlePool.life[i] = particlePool.maxLife[i] = trailPool.maxAge[trail];
+            particlePool.size[i] = 2.0f;
+            particlePool.colour[i] = dotColour;
         }
     }
 }
 
+void VisualFeedbackEngine::clearPaintStrokes()
+{
+    trailPool.count = 0;
+}
+
 //==============================================================================
 // Real-Time Visual Effects
 
@@ -324,28 +598,159 @@ void VisualFeedbackEngine::createParticleSystem(juce::Point<float> origin, juce:
 {
     if (!particleEffectsEnabled.load()) return;
     
-    for (int i = 0; i < count; ++i)
+    // At the cap, new particles recycle existing slots instead of growing the pool
+    auto& random = juce::Random::getSystemRandom();
+    const int cap = getParticleCap();
+    const juce::uint32 argb = color.getARGB();
+    
+    for (int n = 0; n < juce::jmin(count, cap); ++n)
+    {
+        const int i = particlePool.allocate(cap);
+        
+        particlePool.x[i] = origin.x;
+        particlePool.y[i] = origin.y;
+        particlePool.vx[i] = (random.nextFloat() - 0.5f) * 200.0f;
+        particlePool.vy[i] = (random.nextFloat() - 0.5f) * 200.0f;
+        particlePool.gravity[i] = 100.0f;
+        particlePool.life[i] = particlePool.maxLife[i] = 1.0f + random.nextFloat();
+        particlePool.size[i] = 1.0f + random.nextFloat() * 3.0f;
+        particlePool.colour[i] = argb;
+    }
+}
+
+//==============================================================================
+// Particle & Trail Pools
+
+int VisualFeedbackEngine::getParticleCap() const
+{
+    switch (getQualityLevel())
+    {
+        case QualityLevel::Performance: return 100;
+        case QualityLevel::Balanced:    return 500;
+        case QualityLevel::Quality:     return 1000;
+        case QualityLevel::Ultra:       return ParticlePool::CAPACITY;
+    }
+    return 500;
+}
+
+int VisualFeedbackEngine::getTrailCap() const
+{
+    switch (getQualityLevel())
     {
-        Particle particle;
-        particle.position = origin;
-        particle.velocity = {
-            (juce::Random::getSystemRandom().nextFloat() - 0.5f) * 200.0f,
-            (juce::Random::getSystemRandom().nextFloat() - 0.5f) * 200.0f
-        };
-        particle.color = color;
-        particle.life = particle.maxLife = 1.0f + juce::Random::getSystemRandom().nextFloat();
-        particle.size = 1.0f + juce::Random::getSystemRandom().nextFloat() * 3.0f;
+        case QualityLevel::Performance: return 10;
+        case QualityLevel::Balanced:    return 32;
+        case QualityLevel::Quality:     return 50;
+        case QualityLevel::Ultra:       return TrailPool::CAPACITY;
+    }
+    return 32;
+}
+
+int VisualFeedbackEngine::ParticlePool::allocate(int cap)
+{
+    cap = juce::jlimit(1, CAPACITY, cap);
+    
+    if (count < cap)
+        return count++;
+    
+    count = cap;
+    recycleCursor = (recycleCursor + 1) % cap;
+    return recycleCursor;
+}
+
+void VisualFeedbackEngine::ParticlePool::integrate(float deltaTime)
+{
+    using Vector = juce::FloatVectorOperations;
+    
+    Vector::addWithMultiply(x.data(), vx.data(), deltaTime, count);
+    Vector::addWithMultiply(y.data(), vy.data(), deltaTime, count);
+    Vector::addWithMultiply(vy.data(), gravity.data(), deltaTime, count);
+    
+    // Friction
+    Vector::multiply(vx.data(), 0.98f, count);
+    Vector::multiply(vy.data(), 0.98f, count);
+    
+    Vector::add(life.data(), -deltaTime, count);
+}
+
+void VisualFeedbackEngine::ParticlePool::removeDead()
+{
+    // Swap-remove: draw order of particles doesn't matter
+    for (int i = 0; i < count;)
+    {
+        if (life[i] > 0.0f)
+        {
+            ++i;
+            continue;
+        }
         
-        activeParticles.push_back(particle);
+        const int last = --count;
+        x[i] = x[last];
+        y[i] = y[last];
+        vx[i] = vx[last];
+        vy[i] = vy[last];
+        gravity[i] = gravity[last];
+        life[i] = life[last];
+        maxLife[i] = maxLife[last];
+        size[i] = size[last];
+        colour[i] = colour[last];
     }
     
-    // Limit particle count for performance
-    const int maxParticles = (getQualityLevel() == QualityLevel::Performance) ? 100 : 500;
-    if (activeParticles.size() > maxParticles)
+    recycleCursor = juce::jmin(recycleCursor, juce::jmax(0, count - 1));
+}
+
+int VisualFeedbackEngine::TrailPool::allocate(int cap)
+{
+    trimTo(juce::jlimit(1, CAPACITY, cap) - 1);
+    return count++;
+}
+
+void VisualFeedbackEngine::TrailPool::trimTo(int maxCount)
+{
+    // Shift out the oldest trails, keeping paint order
+    const int excess = count - juce::jmax(0, maxCount);
+    if (excess <= 0)
+        return;
+    
+    for (int i = excess; i < count; ++i)
     {
-        activeParticles.erase(activeParticles.begin(), 
-                             activeParticles.begin() + (activeParticles.size() - maxParticles));
+        std::swap(paths[i - excess], paths[i]);
+        age[i - excess] = age[i];
+        maxAge[i - excess] = maxAge[i];
+        intensity[i - excess] = intensity[i];
+        glowRadius[i - excess] = glowRadius[i];
+        strokeWidth[i - excess] = strokeWidth[i];
+        colour[i - excess] = colour[i];
     }
+    count -= excess;
+}
+
+void VisualFeedbackEngine::TrailPool::integrate(float deltaTime)
+{
+    juce::FloatVectorOperations::add(age.data(), deltaTime, count);
+}
+
+void VisualFeedbackEngine::TrailPool::removeExpired()
+{
+    // Stable compaction so older trails stay underneath newer ones
+    int live = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        if (age[i] >= maxAge[i])
+            continue;
+        
+        if (live != i)
+        {
+            std::swap(paths[live], paths[i]);
+            age[live] = age[i];
+            maxAge[live] = maxAge[i];
+            intensity[live] = intensity[i];
+            glowRadius[live] = glowRadius[i];
+            strokeWidth[live] = strokeWidth[i];
+            colour[live] = colour[i];
+        }
+        ++live;
+    }
+    count = live;
 }
 
 //==============================================================================
@@ -369,31 +774,12 @@ void VisualFeedbackEngine::updateAnimation(float deltaTime)
 
 void VisualFeedbackEngine::updateEffects(float deltaTime)
 {
-    // Update paint trails
-    for (auto& trail : activePaintTrails)
-    {
-        trail.update(deltaTime);
-    }
-    
-    // Remove inactive trails
-    activePaintTrails.erase(
-        std::remove_if(activePaintTrails.begin(), activePaintTrails.end(),
-            [](const PaintTrail& trail) { return !trail.isActive; }),
-        activePaintTrails.end()
-    );
-    
-    // Update particles
-    for (auto& particle : activeParticles)
-    {
-        particle.update(deltaTime);
-    }
+    // Age trails and integrate particles as whole arrays
+    trailPool.integrate(deltaTime);
+    trailPool.removeExpired();
     
-    // Remove dead particles
-    activeParticles.erase(
-        std::remove_if(activeParticles.begin(), activeParticles.end(),
-            [](const Particle& particle) { return !particle.isAlive(); }),
-        activeParticles.end()
-    );
+    particlePool.integrate(deltaTime);
+    particlePool.removeDead();
     
     // Update screen shake
     screenShake.update(deltaTime);
@@ -401,8 +787,9 @@ void VisualFeedbackEngine::updateEffects(float deltaTime)
     // Update flash effect
     flashEffect.update(deltaTime);
     
-    // Update frequency visualization peaks
-    frequencyVisualization.updatePeaks(deltaTime);
+    // Update frequency visualization peaks (the analyser holds its own)
+    if (!spectrumFromAnalyser)
+        frequencyVisualization.updatePeaks(deltaTime);
 }
 
 //==============================================================================
@@ -414,22 +801,33 @@ void VisualFeedbackEngine::renderSpectrum2D(juce::Graphics& g, juce::Rectangle<i
     const int numBands = spectrum.size();
     const float bandWidth = static_cast<float>(bounds.getWidth()) / numBands;
     
-    for (int i = 0; i < numBands; ++i)
+    // At reduced resolution each bar shows the loudest of the bands it covers
+    const int stride = spectrumBandStride;
+    const float barWidth = bandWidth * stride;
+    
+    for (int i = 0; i < numBands; i += stride)
     {
-        const float magnitude = spectrum[i];
+        float magnitude = 0.0f;
+        float peak = 0.0f;
+        for (int band = i; band < juce::jmin(numBands, i + stride); ++band)
+        {
+            magnitude = juce::jmax(magnitude, spectrum[band]);
+            peak = juce::jmax(peak, frequencyVisualization.peakValues[band]);
+        }
+        
         const float barHeight = magnitude * bounds.getHeight() * 0.8f;
         
         // Color based on frequency
-        const float frequency = (static_cast<float>(i) / numBands) * 22050.0f;
+        const float frequency = frequencyVisualization.bandFrequencies[i];
         const juce::Colour barColor = getSpectrumColor(frequency, magnitude);
         
         g.setColour(barColor);
-        g.fillRect(i * bandWidth, bounds.getBottom() - barHeight, bandWidth - 1, barHeight);
+        g.fillRect(i * bandWidth, bounds.getBottom() - barHeight, barWidth - 1, barHeight);
         
         // Peak indicators
-        const float peakHeight = frequencyVisualization.peakValues[i] * bounds.getHeight() * 0.8f;
+        const float peakHeight = peak * bounds.getHeight() * 0.8f;
         g.setColour(barColor.brighter(0.5f));
-        g.fillRect(i * bandWidth, bounds.getBottom() - peakHeight, bandWidth - 1, 2.0f);
+        g.fillRect(i * bandWidth, bounds.getBottom() - peakHeight, barWidth - 1, 2.0f);
     }
 }
 
@@ -442,7 +840,7 @@ void VisualFeedbackEngine::renderSpectrum3D(juce::Graphics& g, juce::Rectangle<i
     const float centerY = bounds.getCentreY();
     const float radius = juce::jmin(bounds.getWidth(), bounds.getHeight()) * 0.3f;
     
-    for (int i = 0; i < numBands; ++i)
+    for (int i = 0; i < numBands; i += spectrumBandStride)
     {
         const float angle = (static_cast<float>(i) / numBands) * juce::MathConstants<float>::twoPi + rotationAngle;
         const float magnitude = spectrum[i];
@@ -456,7 +854,7 @@ void VisualFeedbackEngine::renderSpectrum3D(juce::Graphics& g, juce::Rectangle<i
         
         // Color and transparency for depth effect
         const float depth = (std::cos(angle + rotationAngle) + 1.0f) * 0.5f;
-        const juce::Colour barColor = getSpectrumColor(i * 22050.0f / numBands, magnitude)
+        const juce::Colour barColor = getSpectrumColor(frequencyVisualization.bandFrequencies[i], magnitude)
                                      .withAlpha(0.3f + depth * 0.7f);
         
         g.setColour(barColor);
@@ -488,7 +886,7 @@ void VisualFeedbackEngine::renderSpectrumSphere(juce::Graphics& g, juce::Rectang
         const float ringY = centerY + baseRadius * std::cos(ringAngle) * 0.5f;
         
         const int bandsPerRing = numBands / numRings;
-        for (int i = 0; i < bandsPerRing; ++i)
+        for (int i = 0; i < bandsPerRing; i += spectrumBandStride)
         {
             const int bandIndex = ring * bandsPerRing + i;
             if (bandIndex >= numBands) break;
@@ -498,7 +896,7 @@ void VisualFeedbackEngine::renderSpectrumSphere(juce::Graphics& g, juce::Rectang
             const float x = centerX + std::cos(angle) * ringRadius;
             const float y = ringY;
             
-            const juce::Colour pointColor = getSpectrumColor(bandIndex * 22050.0f / numBands, magnitude);
+            const juce::Colour pointColor = getSpectrumColor(frequencyVisualization.bandFrequencies[bandIndex], magnitude);
             g.setColour(pointColor);
             
             const float pointSize = 2.0f + magnitude * 8.0f;
@@ -521,41 +919,78 @@ void VisualFeedbackEngine::renderParticleField(juce::Graphics& g, juce::Rectangl
 
 void VisualFeedbackEngine::renderPaintTrails(juce::Graphics& g)
 {
-    if (!paintGlowEnabled.load() && getQualityLevel() == QualityLevel::Performance)
+    const bool drawGlow = paintGlowEnabled.load() || getQualityLevel() != QualityLevel::Performance;
+    
+    for (int i = 0; i < trailPool.count; ++i)
     {
-        // Simple rendering for performance
-        for (const auto& trail : activePaintTrails)
+        const float alpha = 1.0f - (trailPool.age[i] / trailPool.maxAge[i]);
+        const juce::Colour drawColor = juce::Colour(trailPool.colour[i]).withAlpha(alpha * trailPool.intensity[i]);
+        const auto& path = trailPool.paths[i];
+        const float glowRadius = trailPool.glowRadius[i];
+        
+        // Glow effect
+        if (drawGlow && glowRadius > 0.0f && alpha > 0.1f)
         {
-            if (trail.isActive)
+            for (float r = glowRadius; r > 0; r -= 1.0f)
             {
-                const float alpha = 1.0f - (trail.age / trail.maxAge);
-                g.setColour(trail.color.withAlpha(alpha * trail.intensity));
-                g.strokePath(trail.strokePath, juce::PathStrokeType(trail.strokeWidth));
+                const float glowAlpha = (1.0f - r / glowRadius) * alpha * 0.1f;
+                g.setColour(drawColor.withAlpha(glowAlpha));
+                g.strokePath(path, juce::PathStrokeType(trailPool.strokeWidth[i] + r * 2.0f));
             }
         }
-    }
-    else
-    {
-        // Full quality rendering with effects
-        for (const auto& trail : activePaintTrails)
-        {
-            trail.render(g, juce::AffineTransform::identity);
-        }
+        
+        // Main stroke
+        g.setColour(drawColor);
+        g.strokePath(path, juce::PathStrokeType(trailPool.strokeWidth[i]));
     }
 }
 
 void VisualFeedbackEngine::renderParticles(juce::Graphics& g)
 {
-    for (const auto& particle : activeParticles)
+    // Gather particles into one path per colour and fade step, so a loud passage
+    // costs a handful of fills instead of one per particle
+    int numBatches = 0;
+    
+    for (int i = 0; i < particlePool.count; ++i)
     {
-        if (particle.isAlive())
+        const float fade = particlePool.life[i] / particlePool.maxLife[i];
+        if (fade <= 0.0f)
+            continue;
+        
+        const int alphaStep = juce::jlimit(1, PARTICLE_ALPHA_STEPS, juce::roundToInt(fade * PARTICLE_ALPHA_STEPS));
+        const float size = particlePool.size[i];
+        const float left = particlePool.x[i] - size * 0.5f;
+        const float top = particlePool.y[i] - size * 0.5f;
+        
+        int batch = 0;
+        while (batch < numBatches && (particleBatchColours[batch] != particlePool.colour[i]
+                                      || particleBatchAlphaSteps[batch] != alphaStep))
+            ++batch;
+        
+        if (batch == numBatches)
         {
-            const float alpha = particle.life / particle.maxLife;
-            g.setColour(particle.color.withAlpha(alpha));
-            g.fillEllipse(particle.position.x - particle.size * 0.5f,
-                         particle.position.y - particle.size * 0.5f,
-                         particle.size, particle.size);
+            if (numBatches == MAX_PARTICLE_BATCHES)
+            {
+                // Out of batches - draw this one directly
+                g.setColour(juce::Colour(particlePool.colour[i]).withMultipliedAlpha(fade));
+                g.fillEllipse(left, top, size, size);
+                continue;
+            }
+            
+            particleBatchPaths[batch].clear();
+            particleBatchColours[batch] = particlePool.colour[i];
+            particleBatchAlphaSteps[batch] = alphaStep;
+            ++numBatches;
         }
+        
+        particleBatchPaths[batch].addEllipse(left, top, size, size);
+    }
+    
+    for (int batch = 0; batch < numBatches; ++batch)
+    {
+        const float alpha = static_cast<float>(particleBatchAlphaSteps[batch]) / PARTICLE_ALPHA_STEPS;
+        g.setColour(juce::Colour(particleBatchColours[batch]).withMultipliedAlpha(alpha));
+        g.fillPath(particleBatchPaths[batch]);
     }
 }
 
@@ -598,12 +1033,21 @@ void VisualFeedbackEngine::renderGrid(juce::Graphics& g, juce::Rectangle<int> bo
 juce::Colour VisualFeedbackEngine::getSpectrumColor(float frequency, float magnitude) const
 {
     // Color based on frequency range
+    switch (getSpectrumRange(frequency))
+    {
+        case 0:  return currentColorTheme.spectrumLow.withAlpha(magnitude);
+        case 1:  return currentColorTheme.spectrumMid.withAlpha(magnitude);
+        default: return currentColorTheme.spectrumHigh.withAlpha(magnitude);
+    }
+}
+
+int VisualFeedbackEngine::getSpectrumRange(float frequency)
+{
     if (frequency < 250.0f) // Bass
-        return currentColorTheme.spectrumLow.withAlpha(magnitude);
-    else if (frequency < 4000.0f) // Mids
-        return currentColorTheme.spectrumMid.withAlpha(magnitude);
-    else // Highs
-        return currentColorTheme.spectrumHigh.withAlpha(magnitude);
+        return 0;
+    if (frequency < 4000.0f) // Mids
+        return 1;
+    return 2; // Highs
 }
 
 void VisualFeedbackEngine::setColorScheme(ColorScheme scheme)
@@ -640,6 +1084,14 @@ void VisualFeedbackEngine::setColorScheme(ColorScheme scheme)
         default:
             break;
     }
+    
+    waterfallLutDirty = true;
+}
+
+void VisualFeedbackEngine::setCustomColorTheme(const ColorTheme& theme)
+{
+    currentColorTheme = theme;
+    waterfallLutDirty = true;
 }
 
 //==============================================================================
@@ -647,8 +1099,70 @@ void VisualFeedbackEngine::setColorScheme(ColorScheme scheme)
 
 void VisualFeedbackEngine::setQualityLevel(QualityLevel level)
 {
-    currentQualityLevel.store(static_cast<int>(level));
+    requestedQualityLevel.store(static_cast<int>(level));
+    applyGovernorPosition(static_cast<int>(level) + RESOLUTION_STEPS);
+}
+
+void VisualFeedbackEngine::enableAdaptiveQuality(bool enable)
+{
+    adaptiveQualityEnabled.store(enable);
+    
+    // Without the governor the requested level applies as-is
+    if (!enable)
+        applyGovernorPosition(requestedQualityLevel.load() + RESOLUTION_STEPS);
+}
+
+void VisualFeedbackEngine::finishStage(RenderStage stage, juce::int64& stageStartTicks)
+{
+    const auto now = juce::Time::getHighResolutionTicks();
+    const auto stageMs = static_cast<float>(juce::Time::highResolutionTicksToSeconds(now - stageStartTicks) * 1000.0);
+    
+    auto& smoothed = stageTimesMs[static_cast<size_t>(stage)];
+    smoothed += 0.1f * (stageMs - smoothed);
+    stageStartTicks = now;
+}
+
+void VisualFeedbackEngine::runQualityGovernor(float renderMs)
+{
+    smoothedRenderMs += 0.1f * (renderMs - smoothedRenderMs);
+    ++framesSinceGovernorChange;
+    
+    if (!adaptiveQualityEnabled.load())
+        return;
+    
+    const float budget = frameBudgetMs.load();
+    const float load = audioLoad.load();
+    
+    // Separate thresholds for stepping down and up keep the level from oscillating
+    const bool overBudget = smoothedRenderMs > budget || load > AUDIO_LOAD_LIMIT;
+    const bool wellUnderBudget = smoothedRenderMs < budget * STEP_UP_BUDGET_FRACTION && load < AUDIO_LOAD_RECOVERED;
+    
+    overBudgetFrames = overBudget ? overBudgetFrames + 1 : 0;
+    underBudgetFrames = wellUnderBudget ? underBudgetFrames + 1 : 0;
+    
+    if (framesSinceGovernorChange < FRAMES_AFTER_CHANGE)
+        return;
+    
+    const int topPosition = requestedQualityLevel.load() + RESOLUTION_STEPS;
+    
+    if (overBudgetFrames >= FRAMES_TO_STEP_DOWN && governorPosition > 0)
+        applyGovernorPosition(governorPosition - 1);
+    else if (underBudgetFrames >= FRAMES_TO_STEP_UP && governorPosition < topPosition)
+        applyGovernorPosition(governorPosition + 1);
+}
+
+void VisualFeedbackEngine::applyGovernorPosition(int position)
+{
+    governorPosition = juce::jlimit(0, requestedQualityLevel.load() + RESOLUTION_STEPS, position);
+    
+    // Below Performance the spectrum is drawn at 1/2, then 1/4 resolution
+    spectrumBandStride = 1 << juce::jmax(0, RESOLUTION_STEPS - governorPosition);
+    currentQualityLevel.store(juce::jmax(0, governorPosition - RESOLUTION_STEPS));
     applyQualitySettings();
+    
+    overBudgetFrames = 0;
+    underBudgetFrames = 0;
+    framesSinceGovernorChange = 0;
 }
 
 void VisualFeedbackEngine::applyQualitySettings()
@@ -679,6 +1193,12 @@ void VisualFeedbackEngine::applyQualitySettings()
             chromaticAberrationEnabled.store(quality == QualityLevel::Ultra);
             break;
     }
+    
+    // Enforce the new caps straight away
+    particlePool.count = juce::jmin(particlePool.count, getParticleCap());
+    particlePool.recycleCursor = 0;
+    
+    trailPool.trimTo(getTrailCap());
 }
 
 VisualFeedbackEngine::PerformanceMetrics VisualFeedbackEngine::getPerformanceMetrics() const
@@ -692,31 +1212,44 @@ void VisualFeedbackEngine::updatePerformanceMetrics()
     
     if (deltaTime > 0.0f)
     {
-        frameTimes.push_back(deltaTime * 1000.0f); // Convert to ms
+        frameTimeAccumulator += deltaTime * 1000.0f; // Convert to ms
+        ++framesInWindow;
     }
     
     // Update metrics every second
     auto now = juce::Time::getCurrentTime();
     if ((now - lastPerformanceUpdate).inMilliseconds() >= 1000)
     {
-        if (!frameTimes.empty())
+        if (framesInWindow > 0)
         {
-            float totalTime = 0.0f;
-            for (float time : frameTimes)
-                totalTime += time;
-            
-            performanceMetrics.frameTimeMs = totalTime / frameTimes.size();
+            performanceMetrics.frameTimeMs = frameTimeAccumulator / framesInWindow;
             performanceMetrics.averageFPS = 1000.0f / performanceMetrics.frameTimeMs;
-            frameTimes.clear();
+            frameTimeAccumulator = 0.0f;
+            framesInWindow = 0;
         }
         
-        performanceMetrics.activeParticles = static_cast<int>(activeParticles.size());
-        performanceMetrics.activePaintTrails = static_cast<int>(activePaintTrails.size());
+        performanceMetrics.activeParticles = particlePool.count;
+        performanceMetrics.activePaintTrails = trailPool.count;
+        performanceMetrics.renderTimeMs = smoothedRenderMs;
+        performanceMetrics.stageTimeMs = stageTimesMs;
+        performanceMetrics.audioLoad = audioLoad.load();
+        performanceMetrics.spectrumBandStride = spectrumBandStride;
         
         lastPerformanceUpdate = now;
     }
 }
 
+void VisualFeedbackEngine::resetPerformanceCounters()
+{
+    performanceMetrics = PerformanceMetrics();
+    frameTimeAccumulator = 0.0f;
+    framesInWindow = 0;
+    frameCounter = 0;
+    stageTimesMs.fill(0.0f);
+    smoothedRenderMs = 0.0f;
+    lastPerformanceUpdate = juce::Time::getCurrentTime();
+}
+
 //==============================================================================
 // Helper Method Implementations
 
@@ -763,21 +1296,6 @@ float VisualFeedbackEngine::FlashEffect::getCurrentAlpha() const
     return intensity * (timeRemaining / duration);
 }
 
-void VisualFeedbackEngine::Particle::update(float deltaTime)
-{
-    position.x += velocity.x * deltaTime;
-    position.y += velocity.y * deltaTime;
-    
-    // Apply gravity
-    velocity.y += 100.0f * deltaTime;
-    
-    // Apply friction
-    velocity.x *= 0.98f;
-    velocity.y *= 0.98f;
-    
-    life -= deltaTime;
-}
-
 //==============================================================================
 // Frequency Visualization Implementation
 
@@ -18,6 +18,11 @@
  * - Satisfying visual feedback for every interaction
  * - Performance-optimized GPU-accelerated rendering
  * - Professional information density without clutter
+ *
+ * Not yet hooked up: the only owner is RetroCanvasProcessor, which has no
+ * implementation, so nothing calls prepareAudioTap, updateAudioData or
+ * reportAudioLoad and the spectrum tap, analyser and quality governor stay idle
+ * until a processor feeds the engine and a view calls renderFrame.
  */
 class VisualFeedbackEngine
 {
@@ -33,32 +38,14 @@ public:
     void renderFrame(juce::Graphics& g, juce::Rectangle<int> bounds);
     
     // Update with audio data
-    void updateAudioData(const juce::AudioBuffer<float>& buffer);
+    void prepareAudioTap(double sampleRate);
+    void updateAudioData(const juce::AudioBuffer<float>& buffer);   // Audio thread: decimated copy only
     void updateSpectrumData(const std::vector<float>& magnitudeSpectrum);
     void updateTrackerData(const std::vector<std::vector<int>>& patternData);
     
     //==============================================================================
     // Paint Stroke Visualization
     
-    struct PaintTrail
-    {
-        juce::Path strokePath;
-        juce::Colour color;
-        float intensity = 1.0f;
-        float age = 0.0f;           // Age in seconds
-        float maxAge = 2.0f;        // Fade out time
-        bool isActive = true;
-        
-        // Visual effects
-        float glowRadius = 5.0f;
-        float strokeWidth = 2.0f;
-        bool hasParticles = false;
-        std::vector<juce::Point<float>> particles;
-        
-        void update(float deltaTime);
-        void render(juce::Graphics& g, const juce::AffineTransform& transform) const;
-    };
-    
     // Paint stroke management
     void addPaintStroke(const juce::Path& path, juce::Colour color, float intensity);
     void clearPaintStrokes();
@@ -78,7 +65,8 @@ public:
         SpectrumSphere,      // Spherical spectrum visualization
         SpectrumTunnel,      // Tunnel effect with spectrum
         ParticleField,       // Audio-reactive particle system
-        VinylSpectrum        // Rotating vinyl-style visualization
+        VinylSpectrum,       // Rotating vinyl-style visualization
+        Waterfall            // Scrolling time-frequency spectrogram
     };
     
     void setVisualizationMode(VisualizationMode mode) { currentVisualizationMode.store(static_cast<int>(mode)); }
@@ -117,12 +105,14 @@ public:
         std::array<float, NUM_BANDS> peakAges{};
         
         // Linear drumming frequency ranges
+        std::array<float, NUM_BANDS> bandFrequencies{};   // Centre of each log-spaced band
+        
         struct FrequencyBand
         {
-            float lowFreq;
-            float highFreq;
-            float currentLevel;
-            float peakLevel;
+            float lowFreq = 0.0f;
+            float highFreq = 0.0f;
+            float currentLevel = 0.0f;
+            float peakLevel = 0.0f;
             juce::Colour bandColor;
             juce::String bandName;
             bool isActive = false;
@@ -137,6 +127,18 @@ public:
     
     FrequencyVisualization& getFrequencyVisualization() { return frequencyVisualization; }
     
+    // One analysed spectrum frame, published by the analysis thread
+    struct SpectrumSnapshot
+    {
+        std::array<float, FrequencyVisualization::NUM_BANDS> magnitudes{};       // 0-1 over an 80 dB range
+        std::array<float, FrequencyVisualization::NUM_BANDS> peakValues{};
+        std::array<float, FrequencyVisualization::NUM_BANDS> bandFrequencies{};
+        std::array<float, 16> drumLevels{};
+        std::array<float, 16> drumPeaks{};
+        float rmsLevel = 0.0f;
+        juce::uint32 sequence = 0;                                                  // Analysis hop counter
+    };
+    
     //==============================================================================
     // Tracker Pattern Visualization
     
@@ -202,8 +204,26 @@ public:
         Ultra = 3          // All effects enabled, may impact performance
     };
     
+    // The requested level is a ceiling: with adaptive quality on, the governor steps
+    // below it (and then down in spectrum resolution) while renderFrame overruns its
+    // budget or the audio thread is short of headroom, and back up with hysteresis
     void setQualityLevel(QualityLevel level);
     QualityLevel getQualityLevel() const { return static_cast<QualityLevel>(currentQualityLevel.load()); }
+    QualityLevel getRequestedQualityLevel() const { return static_cast<QualityLevel>(requestedQualityLevel.load()); }
+    
+    void enableAdaptiveQuality(bool enable);
+    void setFrameBudgetMs(float milliseconds) { frameBudgetMs.store(juce::jmax(1.0f, milliseconds)); }
+    void reportAudioLoad(float load) { audioLoad.store(load); }   // 0-1, callable from any thread
+    
+    enum class RenderStage
+    {
+        Visualization = 0,  // Spectrum, sphere, bars or particle field
+        PaintTrails,
+        Particles,
+        TrackerPattern,
+        ScreenEffects,
+        NumStages
+    };
     
     // Performance metrics
     struct PerformanceMetrics
@@ -214,6 +234,12 @@ public:
         float gpuUsage = 0.0f;      // If GPU acceleration available
         int activeParticles = 0;
         int activePaintTrails = 0;
+        
+        // Governor state
+        float renderTimeMs = 0.0f;  // Smoothed cost of renderFrame itself
+        std::array<float, static_cast<size_t>(RenderStage::NumStages)> stageTimeMs{};
+        float audioLoad = 0.0f;
+        int spectrumBandStride = 1; // 1 = full spectrum resolution
     };
     
     PerformanceMetrics getPerformanceMetrics() const;
@@ -272,7 +298,6 @@ private:
     //==============================================================================
     // Visual Data
     
-    std::vector<PaintTrail> activePaintTrails;
     FrequencyVisualization frequencyVisualization;
     TrackerVisualization trackerVisualization;
     Visualization3DParams visualization3DParams;
@@ -305,20 +330,60 @@ private:
         float getCurrentAlpha() const;
     } flashEffect;
     
-    struct Particle
+    //==============================================================================
+    // Particle & Trail Pools
+    //
+    // Fixed-capacity structure-of-arrays storage: spawning never allocates and
+    // integration runs as whole-array vector operations. Live entries are packed
+    // at the front of each array; caps follow the QualityLevel.
+    
+    struct ParticlePool
     {
-        juce::Point<float> position;
-        juce::Point<float> velocity;
-        juce::Colour color;
-        float life = 1.0f;
-        float maxLife = 1.0f;
-        float size = 1.0f;
+        static constexpr int CAPACITY = 2048;
         
-        void update(float deltaTime);
-        bool isAlive() const { return life > 0.0f; }
+        std::array<float, CAPACITY> x{}, y{};
+        std::array<float, CAPACITY> vx{}, vy{};
+        std::array<float, CAPACITY> gravity{};
+        std::array<float, CAPACITY> life{}, maxLife{};
+        std::array<float, CAPACITY> size{};
+        std::array<juce::uint32, CAPACITY> colour{};    // ARGB; alpha scales the fade
+        int count = 0;
+        int recycleCursor = 0;                           // Slots reused round-robin at the cap
+        
+        int allocate(int cap);
+        void integrate(float deltaTime);
+        void removeDead();
     };
     
-    std::vector<Particle> activeParticles;
+    struct TrailPool
+    {
+        static constexpr int CAPACITY = 64;
+        
+        std::array<juce::Path, CAPACITY> paths;          // Swapped, never reallocated, on removal
+        std::array<float, CAPACITY> age{}, maxAge{};
+        std::array<float, CAPACITY> intensity{};
+        std::array<float, CAPACITY> glowRadius{}, strokeWidth{};
+        std::array<juce::uint32, CAPACITY> colour{};
+        int count = 0;
+        
+        int allocate(int cap);                           // Drops the oldest trail at the cap
+        void trimTo(int maxCount);
+        void integrate(float deltaTime);
+        void removeExpired();
+    };
+    
+    ParticlePool particlePool;
+    TrailPool trailPool;
+    
+    // Particle drawing batches, one path per colour and fade step
+    static constexpr int MAX_PARTICLE_BATCHES = 32;
+    static constexpr int PARTICLE_ALPHA_STEPS = 8;
+    std::array<juce::Path, MAX_PARTICLE_BATCHES> particleBatchPaths;
+    std::array<juce::uint32, MAX_PARTICLE_BATCHES> particleBatchColours{};
+    std::array<int, MAX_PARTICLE_BATCHES> particleBatchAlphaSteps{};
+    
+    int getParticleCap() const;
+    int getTrailCap() const;
     
     //==============================================================================
     // State Management
@@ -337,6 +402,90 @@ private:
     
     std::atomic<float> chromaticAberrationAmount{0.0f};
     
+    //==============================================================================
+    // Spectrum Pipeline (audio thread -> SPSC ring -> analysis thread -> triple buffer)
+    
+    static constexpr int FFT_ORDER = 11;
+    static constexpr int FFT_SIZE = 1 << FFT_ORDER;
+    static constexpr int TAP_RING_SIZE = 16384;             // Decimated mono samples
+    static constexpr double TAP_MIN_RATE = 32000.0;         // Decimate no lower than this
+    static constexpr float ANALYSIS_RATE_HZ = 60.0f;        // Display rate
+    static constexpr float MIN_BAND_FREQUENCY = 20.0f;
+    static constexpr float DYNAMIC_RANGE_DB = 80.0f;
+    static constexpr float PEAK_HOLD_SECONDS = 0.5f;
+    static constexpr float PEAK_FALL_PER_SECOND = 0.6f;
+    
+    // Audio-thread state
+    juce::AbstractFifo tapFifo{TAP_RING_SIZE};
+    std::vector<float> tapRing = std::vector<float>(TAP_RING_SIZE, 0.0f);
+    std::array<float, 1024> decimationScratch{};
+    int decimationFactor = 1;
+    int decimationCounter = 0;
+    float decimationAccumulator = 0.0f;
+    std::atomic<int> tapOverflowCount{0};
+    
+    // Analysis-thread state
+    double tapSampleRate = 44100.0;
+    std::vector<float> analysisHistory = std::vector<float>(FFT_SIZE, 0.0f);
+    std::vector<float> analysisIncoming = std::vector<float>(TAP_RING_SIZE, 0.0f);
+    juce::dsp::FFT fft{FFT_ORDER};
+    juce::dsp::WindowingFunction<float> window{static_cast<size_t>(FFT_SIZE), juce::dsp::WindowingFunction<float>::hann};
+    std::array<float, FFT_SIZE * 2> fftData{};
+    std::array<float, FFT_SIZE / 2> binLevels{};
+    std::array<float, FrequencyVisualization::NUM_BANDS> bandLowBins{};
+    std::array<float, FrequencyVisualization::NUM_BANDS> bandHighBins{};
+    std::array<float, FrequencyVisualization::NUM_BANDS> peakAges{};
+    std::array<std::pair<float, float>, 16> drumBandRanges{};
+    SpectrumSnapshot analysisState;
+    double lastAnalysisTimeMs = 0.0;
+    
+    // Triple buffer: the analysis thread fills one snapshot while renderFrame reads
+    // another; the third is exchanged atomically along with a "fresh" flag
+    static constexpr int SNAPSHOT_INDEX_MASK = 3;
+    static constexpr int SNAPSHOT_FRESH = 4;
+    std::array<SpectrumSnapshot, 3> snapshotBuffers;
+    std::atomic<int> sharedSnapshot{1};
+    int writeSnapshot = 0;                                  // Analysis thread
+    int readSnapshot = 2;                                   // Render thread
+    bool spectrumFromAnalyser = false;
+    
+    class AnalysisThread : public juce::Thread
+    {
+    public:
+        AnalysisThread(VisualFeedbackEngine& owner)
+            : Thread("Visual Spectrum Analysis"), engine(owner) {}
+        void run() override;
+        
+    private:
+        VisualFeedbackEngine& engine;
+    };
+    
+    void updateBandLayout();
+    void runSpectrumAnalysis();
+    void publishSnapshot();
+    void applySpectrumSnapshot(const SpectrumSnapshot& snapshot);
+    
+    //==============================================================================
+    // Waterfall
+    //
+    // A circular image with one column per analysis hop and one row per band. Only
+    // the new column is written each hop, and the view is two blits either side of
+    // the write position, so a frame costs the same whatever the history length.
+    
+    static constexpr int WATERFALL_HISTORY = 512;           // Columns kept
+    static constexpr int WATERFALL_LUT_SIZE = 256;          // Levels per colour range
+    
+    juce::Image waterfallImage;
+    int waterfallWriteColumn = 0;                           // Next column to write (the oldest)
+    juce::uint32 lastWaterfallSequence = 0;
+    std::array<std::array<juce::Colour, WATERFALL_LUT_SIZE>, 3> waterfallLut;   // Low, mid, high ranges
+    std::array<juce::Colour, FrequencyVisualization::NUM_BANDS> waterfallColumn;
+    bool waterfallLutDirty = true;
+    
+    void rebuildWaterfallLut();
+    void writeWaterfallColumns(const SpectrumSnapshot& snapshot);
+    void renderWaterfall(juce::Graphics& g, juce::Rectangle<int> bounds);
+    
     //==============================================================================
     // Timing & Animation
     
@@ -354,9 +503,42 @@ private:
     
     mutable PerformanceMetrics performanceMetrics;
     juce::Time lastPerformanceUpdate;
-    std::vector<float> frameTimes;
+    float frameTimeAccumulator = 0.0f;
+    int framesInWindow = 0;
     int frameCounter = 0;
     
+    //==============================================================================
+    // Quality Governor
+    //
+    // Ladder positions, lowest first: Performance at 1/4 and 1/2 spectrum resolution,
+    // then each QualityLevel at full resolution. The top is the requested level.
+    
+    static constexpr int RESOLUTION_STEPS = 2;
+    static constexpr float DEFAULT_FRAME_BUDGET_MS = 8.0f;   // Half a 60 Hz frame
+    static constexpr float AUDIO_LOAD_LIMIT = 0.75f;         // Step down above this
+    static constexpr float AUDIO_LOAD_RECOVERED = 0.5f;      // Step up only below this
+    static constexpr float STEP_UP_BUDGET_FRACTION = 0.6f;
+    static constexpr int FRAMES_TO_STEP_DOWN = 8;
+    static constexpr int FRAMES_TO_STEP_UP = 120;            // About two seconds of headroom
+    static constexpr int FRAMES_AFTER_CHANGE = 30;           // Let timings settle first
+    
+    std::atomic<int> requestedQualityLevel{1};
+    std::atomic<bool> adaptiveQualityEnabled{true};
+    std::atomic<float> frameBudgetMs{DEFAULT_FRAME_BUDGET_MS};
+    std::atomic<float> audioLoad{0.0f};
+    
+    int governorPosition = 1 + RESOLUTION_STEPS;
+    int spectrumBandStride = 1;
+    std::array<float, static_cast<size_t>(RenderStage::NumStages)> stageTimesMs{};
+    float smoothedRenderMs = 0.0f;
+    int overBudgetFrames = 0;
+    int underBudgetFrames = 0;
+    int framesSinceGovernorChange = 0;
+    
+    void finishStage(RenderStage stage, juce::int64& stageStartTicks);
+    void runQualityGovernor(float renderMs);
+    void applyGovernorPosition(int position);
+    
     //==============================================================================
     // Rendering Methods
     
@@ -380,9 +562,12 @@ private:
     
     // Utility methods
     juce::Colour getSpectrumColor(float frequency, float magnitude) const;
+    static int getSpectrumRange(float frequency);   // 0 = bass, 1 = mids, 2 = highs
     juce::AffineTransform get3DTransform(juce::Rectangle<int> bounds) const;
     void applyQualitySettings();
     void initializeDefaultColorSchemes();
     
+    AnalysisThread analysisThread{*this};
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VisualFeedbackEngine)
 };
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "WaveformOverview.h"
+#include <cmath>
+#include <limits>
+
+//==============================================================================
+// Builder - accumulates level 0 bins block by block, then derives coarser levels
+
+class WaveformOverview::Builder
+{
+public:
+    explicit Builder(WaveformOverview& target) : overview(target)
+    {
+        overview.levels.emplace_back();
+    }
+    
+    void addBlock(const juce::AudioBuffer<float>& buffer, int numSamples)
+    {
+        const int numChannels = buffer.getNumChannels();
+        if (numChannels == 0)
+            return;
+        
+        int position = 0;
+        while (position < numSamples)
+        {
+            const int count = juce::jmin(numSamples - position, BASE_SAMPLES_PER_BIN - binFill);
+            
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                const float* data = buffer.getReadPointer(channel, position);
+                const auto range = juce::FloatVectorOperations::findMinAndMax(data, count);
+                
+                binMin = juce::jmin(binMin, range.getStart());
+                binMax = juce::jmax(binMax, range.getEnd());
+                
+                for (int i = 0; i < count; ++i)
+                    sumSquares += (double)data[i] * data[i];
+            }
+            
+            binFill += count;
+            position += count;
+            
+            if (binFill == BASE_SAMPLES_PER_BIN)
+                flushBin(numChannels);
+        }
+        
+        lastNumChannels = numChannels;
+        overview.numSamples += numSamples;
+    }
+    
+    void finish()
+    {
+        if (binFill > 0)
+            flushBin(lastNumChannels);
+        
+        // Each level merges neighbouring pairs of the one below
+        while (overview.levels.back().size() > 1)
+        {
+            const auto& finer = overview.levels.back();
+            std::vector<Bin> coarser((finer.size() + 1) / 2);
+            
+            for (size_t i = 0; i < coarser.size(); ++i)
+            {
+                const auto& first = finer[i * 2];
+                if (i * 2 + 1 < finer.size())
+                {
+                    const auto& second = finer[i * 2 + 1];
+                    coarser[i].minValue = juce::jmin(first.minValue, second.minValue);
+                    coarser[i].maxValue = juce::jmax(first.maxValue, second.maxValue);
+                    coarser[i].meanSquare = (first.meanSquare + second.meanSquare) * 0.5f;
+                }
+                else
+                {
+                    coarser[i] = first;
+                }
+            }
+            
+            overview.levels.push_back(std::move(coarser));
+        }
+    }
+
+private:
+    void flushBin(int numChannels)
+    {
+        Bin bin;
+        bin.minValue = binMin;
+        bin.maxValue = binMax;
+        bin.meanSquare = (float)(sumSquares / (double)(binFill * juce::jmax(1, numChannels)));
+        overview.levels.front().push_back(bin);
+        
+        binMin = std::numeric_limits<float>::max();
+        binMax = std::numeric_limits<float>::lowest();
+        sumSquares = 0.0;
+        binFill = 0;
+    }
+    
+    WaveformOverview& overview;
+    float binMin = std::numeric_limits<float>::max();
+    float binMax = std::numeric_limits<float>::lowest();
+    double sumSquares = 0.0;
+    int binFill = 0;
+    int lastNumChannels = 1;
+};
+
+//==============================================================================
+// Construction
+
+std::shared_ptr<const WaveformOverview> WaveformOverview::createFromBuffer(const juce::AudioBuffer<float>& buffer,
+                                                                           double sampleRate)
+{
+    std::shared_ptr<WaveformOverview> overview(new WaveformOverview());
+    overview->sampleRate = sampleRate;
+    
+    Builder builder(*overview);
+    builder.addBlock(buffer, buffer.getNumSamples());
+    builder.finish();
+    
+    return overview;
+}
+
+//==============================================================================
+// Queries
+
+int WaveformOverview::getLevelForSamplesPerColumn(double samplesPerColumn) const
+{
+    // Finest level with no more than one bin per column on average
+    const double binsPerColumn = samplesPerColumn / BASE_SAMPLES_PER_BIN;
+    const int level = binsPerColumn > 1.0 ? (int)std::floor(std::log2(binsPerColumn)) : 0;
+    
+    return juce::jlimit(0, juce::jmax(0, getNumLevels() - 1), level);
+}
+
+WaveformOverview::Column WaveformOverview::getColumn(double startSample, double endSample) const
+{
+    return summarise(getLevelForSamplesPerColumn(endSample - startSample), startSample, endSample);
+}
+
+void WaveformOverview::getColumns(double startSample, double samplesPerColumn, Column* columns, int numColumns) const
+{
+    const int level = getLevelForSamplesPerColumn(samplesPerColumn);
+    
+    for (int i = 0; i < numColumns; ++i)
+    {
+        const double columnStart = startSample + samplesPerColumn * i;
+        columns[i] = summarise(level, columnStart, columnStart + samplesPerColumn);
+    }
+}
+
+WaveformOverview::Column WaveformOverview::summarise(int level, double startSample, double endSample) const
+{
+    Column column;
+    
+    if (levels.empty() || levels[(size_t)level].empty()
+        || endSample <= 0.0 || startSample >= (double)numSamples)
+        return column;
+    
+    const auto& bins = levels[(size_t)level];
+    const double samplesPerBin = std::ldexp((double)BASE_SAMPLES_PER_BIN, level);
+    const int lastIndex = (int)bins.size() - 1;
+    
+    const int first = juce::jlimit(0, lastIndex, (int)std::floor(startSample / samplesPerBin));
+    const int last = juce::jlimit(first, lastIndex, (int)std::ceil(endSample / samplesPerBin) - 1);
+    
+    column.minValue = bins[(size_t)first].minValue;
+    column.maxValue = bins[(size_t)first].maxValue;
+    float meanSquare = 0.0f;
+    
+    for (int i = first; i <= last; ++i)
+    {
+        const auto& bin = bins[(size_t)i];
+        column.minValue = juce::jmin(column.minValue, bin.minValue);
+        column.maxValue = juce::jmax(column.maxValue, bin.maxValue);
+        meanSquare += bin.meanSquare;
+    }
+    
+    column.rms = std::sqrt(meanSquare / (float)(last - first + 1));
+    return column;
+}
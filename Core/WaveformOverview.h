@@ -0,0 +1,70 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+
+/**
+ * WaveformOverview - Min/max/RMS summary pyramid of a sample
+ *
+ * Level 0 summarises BASE_SAMPLES_PER_BIN samples per bin; each further level
+ * halves the bin count by merging neighbouring pairs. A view asks for columns
+ * at its own pixel density and is served from the level whose bins are closest
+ * to one per column, so drawing costs O(pixels) for any sample length or zoom.
+ *
+ * Built once (off the audio and message threads) and then shared immutably.
+ */
+class WaveformOverview
+{
+public:
+    static constexpr int BASE_SAMPLES_PER_BIN = 16;
+    
+    struct Bin
+    {
+        float minValue = 0.0f;
+        float maxValue = 0.0f;
+        float meanSquare = 0.0f;
+    };
+    
+    struct Column
+    {
+        float minValue = 0.0f;
+        float maxValue = 0.0f;
+        float rms = 0.0f;
+    };
+    
+    //==============================================================================
+    // Construction
+    
+    static std::shared_ptr<const WaveformOverview> createFromBuffer(const juce::AudioBuffer<float>& buffer,
+                                                                    double sampleRate);
+    
+    //==============================================================================
+    // Queries
+    
+    juce::int64 getNumSamples() const { return numSamples; }
+    double getSampleRate() const { return sampleRate; }
+    int getNumLevels() const { return (int)levels.size(); }
+    
+    // Pyramid level whose bins best match the requested density
+    int getLevelForSamplesPerColumn(double samplesPerColumn) const;
+    
+    // Summary of [startSample, endSample)
+    Column getColumn(double startSample, double endSample) const;
+    
+    // Fills numColumns consecutive columns, each samplesPerColumn wide
+    void getColumns(double startSample, double samplesPerColumn, Column* columns, int numColumns) const;
+
+private:
+    WaveformOverview() = default;
+    
+    class Builder;
+    
+    Column summarise(int level, double startSample, double endSample) const;
+    
+    std::vector<std::vector<Bin>> levels;
+    juce::int64 numSamples = 0;
+    double sampleRate = 44100.0;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformOverview)
+};
@@ -11,6 +11,13 @@ CanvasPanel::CanvasPanel()
     addAndMakeVisible(placeholderLabel.get());
 }
 
+CanvasPanel::~CanvasPanel()
+{
+    stopTimer();
+    importer.cancel();
+    spectrogramImporter.cancel();
+}
+
 void CanvasPanel::paint(juce::Graphics& g)
 {
     auto bounds = getLocalBounds();
@@ -87,6 +94,25 @@ void CanvasPanel::paint(juce::Graphics& g)
                 static_cast<float>(contentBounds.getRight()));
         }
     }
+
+    if (isImporting())
+    {
+        // Progress bar and label over whatever is currently shown
+        auto barBounds = contentBounds.withSizeKeepingCentre(juce::jmin(240, contentBounds.getWidth() - 16), 10);
+
+        g.setColour(ArtefactLookAndFeel::kBackground.withAlpha(0.8f));
+        g.fillRect(barBounds.expanded(8, 24).withTrimmedBottom(16));
+
+        g.setColour(ArtefactLookAndFeel::kBevelLight);
+        g.drawRect(barBounds, 1);
+        g.fillRect(barBounds.reduced(2).withWidth(
+            juce::roundToInt((float)(barBounds.getWidth() - 4) * getImportProgress())));
+
+        g.setColour(ArtefactLookAndFeel::kTextColour);
+        g.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(), 12.0f, juce::Font::plain));
+        g.drawText("IMPORTING " + juce::String(juce::roundToInt(getImportProgress() * 100.0f)) + "%",
+                   barBounds.translated(0, -18), juce::Justification::centred);
+    }
 }
 
 void CanvasPanel::resized()
@@ -102,7 +128,7 @@ bool CanvasPanel::isInterestedInFileDrag(const juce::StringArray& files)
     for (auto& file : files)
     {
         juce::File f(file);
-        if (f.hasFileExtension("jpg;jpeg;png;gif;bmp"))
+        if (f.hasFileExtension("jpg;jpeg;png;gif;bmp") || spectrogramImporter.canReadFile(f))
             return true;
     }
     return false;
@@ -112,25 +138,90 @@ void CanvasPanel::filesDropped(const juce::StringArray& files, int, int)
 {
     if (files.size() > 0)
     {
-        loadImage(juce::File(files[0]));
+        const juce::File file(files[0]);
+        if (spectrogramImporter.canReadFile(file))
+            loadAudio(file);
+        else
+            loadImage(file);
     }
 }
 
+void CanvasPanel::mouseDown(const juce::MouseEvent&)
+{
+    if (isImporting())
+        cancelImport();
+}
+
 void CanvasPanel::loadImage(const juce::File& imageFile)
 {
-    currentImage = juce::ImageFileFormat::loadFrom(imageFile);
-    if (currentImage.isValid())
+    // Decoding and resampling happen on the importer's threads; the current
+    // image stays on screen until the new one is ready
+    spectrogramImporter.cancel();
+    importer.startImport(imageFile, importColumns, importRows);
+    startTimerHz(30);
+    repaint();
+}
+
+void CanvasPanel::loadAudio(const juce::File& audioFile)
+{
+    // The rows use the spectrogram importer's frequency range, which should
+    // match the processor the result is sent to
+    importer.cancel();
+    spectrogramImporter.startImport(audioFile, importColumns, importRows);
+    startTimerHz(30);
+    repaint();
+}
+
+void CanvasPanel::cancelImport()
+{
+    importer.cancel();
+    spectrogramImporter.cancel();
+    stopTimer();
+    repaint();
+}
+
+void CanvasPanel::setImportResolution(int columns, int rows)
+{
+    importColumns = juce::jmax(1, columns);
+    importRows = juce::jmax(1, rows);
+}
+
+void CanvasPanel::timerCallback()
+{
+    // Read before taking the result so one published in between isn't missed
+    const bool finished = !isImporting();
+
+    auto result = importer.takeResult();
+    if (result == nullptr)
+        result = spectrogramImporter.takeResult();
+
+    if (result != nullptr)
     {
-        currentImageFile = imageFile;
+        currentImage = result->image;
+        currentImageFile = result->sourceFile;
         hasImage = true;
         if (placeholderLabel)
             placeholderLabel->setVisible(false);
-        repaint();
+
+        if (onImageImported)
+            onImageImported(result);
     }
+
+    // Failed decodes end the import without a result
+    if (finished)
+        stopTimer();
+
+    repaint();
+}
+
+float CanvasPanel::getImportProgress() const
+{
+    return importer.isImporting() ? importer.getProgress() : spectrogramImporter.getProgress();
 }
 
 void CanvasPanel::clearImage()
 {
+    cancelImport();
     currentImage = juce::Image();
     currentImageFile = juce::File();
     hasImage = false;
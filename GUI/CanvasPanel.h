@@ -1,14 +1,18 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "Core/ImageImporter.h"
+#include "Core/SpectrogramImporter.h"
+#include <functional>
 #include <memory>
 
 class CanvasPanel : public juce::Component,
-                    public juce::FileDragAndDropTarget
+                    public juce::FileDragAndDropTarget,
+                    private juce::Timer
 {
 public:
     CanvasPanel();
-    ~CanvasPanel() override = default;
+    ~CanvasPanel() override;
 
     // Component overrides
     void paint(juce::Graphics& g) override;
@@ -18,18 +22,43 @@ public:
     bool isInterestedInFileDrag(const juce::StringArray& files) override;
     void filesDropped(const juce::StringArray& files, int x, int y) override;
 
-    // Image loading and management
+    // Clicking the canvas while an import is running cancels it
+    void mouseDown(const juce::MouseEvent& event) override;
+
+    // Image loading and management - loadImage decodes and resamples in the background
     void loadImage(const juce::File& imageFile);
+    void cancelImport();
     void clearImage();
+    bool isImporting() const { return importer.isImporting() || spectrogramImporter.isImporting(); }
+
+    // Audio files become a spectrogram of the whole file on the same grid
+    void loadAudio(const juce::File& audioFile);
+    void setSpectrogramFrequencyRange(float minHz, float maxHz) { spectrogramImporter.setFrequencyRange(minHz, maxHz); }
+
+    // Time x frequency grid imported images are resampled to
+    void setImportResolution(int columns, int rows);
+
+    // Called on the message thread with each finished import, so the owner can hand
+    // the planes to CanvasProcessor::updateFromPlanes or the paint engine
+    std::function<void(std::shared_ptr<const ImageImporter::Result>)> onImageImported;
 
     // Get brightness at normalized position (0-1)
     float getBrightnessAt(float normX, float normY) const;
 
 private:
+    void timerCallback() override;
+    float getImportProgress() const;
+
     // Image data
     juce::Image currentImage;
     juce::File currentImageFile;
 
+    // Background import
+    ImageImporter importer;
+    SpectrogramImporter spectrogramImporter;
+    int importColumns = 1024;
+    int importRows = 512;
+
     // Display state
     bool hasImage{ false };
     juce::Rectangle<float> imageDisplayBounds;
@@ -0,0 +1,362 @@
+#include "CanvasTileCache.h"
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+// Constructor and Destructor
+
+CanvasTileCache::CanvasTileCache()
+{
+    workerThread.startThread(juce::Thread::Priority::low);
+}
+
+CanvasTileCache::~CanvasTileCache()
+{
+    workerThread.stopThread(2000);
+}
+
+//==============================================================================
+// Mapping
+
+float CanvasTileCache::Mapping::frequencyToY(float frequency) const
+{
+    const float logFreq = juce::jlimit(logMinFreq, logMaxFreq, std::log2(juce::jmax(frequency, 1.0f)));
+    const float normalizedY = (logFreq - logMinFreq) / (logMaxFreq - logMinFreq);
+    
+    return originY + (1.0f - normalizedY) * height;
+}
+
+void CanvasTileCache::drawSegment(juce::Graphics& g, const Segment& segment, const Mapping& mapping)
+{
+    g.setColour(segment.colour);
+    g.drawLine(mapping.timeToX(segment.start.x), mapping.frequencyToY(segment.start.y),
+               mapping.timeToX(segment.end.x), mapping.frequencyToY(segment.end.y),
+               segment.thickness);
+}
+
+CanvasTileCache::Mapping CanvasTileCache::getTileMapping(const TileKey& key) const
+{
+    Mapping mapping;
+    mapping.pixelsPerSecond = getLevelPixelsPerSecond(std::get<0>(key));
+    mapping.originX = -(float)(std::get<1>(key) * TILE_SIZE);
+    mapping.originY = -(float)(std::get<2>(key) * TILE_SIZE);
+    mapping.height = (float)canvasHeight;
+    mapping.logMinFreq = std::log2(minFreq);
+    mapping.logMaxFreq = std::log2(maxFreq);
+    return mapping;
+}
+
+juce::Rectangle<float> CanvasTileCache::getSegmentBounds(const Segment& segment, const Mapping& mapping) const
+{
+    const juce::Point<float> start(mapping.timeToX(segment.start.x), mapping.frequencyToY(segment.start.y));
+    const juce::Point<float> end(mapping.timeToX(segment.end.x), mapping.frequencyToY(segment.end.y));
+    
+    return juce::Rectangle<float>(start, end).expanded(segment.thickness * 0.5f + 1.0f);
+}
+
+//==============================================================================
+// Layout and Content
+
+void CanvasTileCache::setLayout(float newBasePixelsPerSecond, int newCanvasHeight, float newMinFreq, float newMaxFreq)
+{
+    const juce::ScopedLock lock(cacheLock);
+    
+    if (newBasePixelsPerSecond == basePixelsPerSecond && newCanvasHeight == canvasHeight
+        && newMinFreq == minFreq && newMaxFreq == maxFreq)
+        return;
+    
+    basePixelsPerSecond = newBasePixelsPerSecond;
+    canvasHeight = newCanvasHeight;
+    minFreq = newMinFreq;
+    maxFreq = newMaxFreq;
+    
+    // Every tile was rasterised against the old layout
+    ++layoutGeneration;
+    tiles.clear();
+    pendingRequests.clear();
+}
+
+void CanvasTileCache::addSegment(const Segment& segment)
+{
+    const juce::ScopedLock lock(cacheLock);
+    
+    segments.push_back(segment);
+    maxSegmentThickness = juce::jmax(maxSegmentThickness, segment.thickness);
+    indexSegment(segments.size() - 1);
+    markStaleTiles(segment);
+}
+
+void CanvasTileCache::clear()
+{
+    const juce::ScopedLock lock(cacheLock);
+    
+    segments.clear();
+    segmentBuckets.clear();
+    maxSegmentThickness = 1.0f;
+    
+    ++layoutGeneration;
+    tiles.clear();
+    pendingRequests.clear();
+}
+
+size_t CanvasTileCache::getNumSegments() const
+{
+    const juce::ScopedLock lock(cacheLock);
+    return segments.size();
+}
+
+void CanvasTileCache::indexSegment(size_t index)
+{
+    const auto& segment = segments[index];
+    const int firstBucket = (int)std::floor(juce::jmin(segment.start.x, segment.end.x) / BUCKET_SECONDS);
+    const int lastBucket = (int)std::floor(juce::jmax(segment.start.x, segment.end.x) / BUCKET_SECONDS);
+    
+    for (int bucket = firstBucket; bucket <= lastBucket; ++bucket)
+        segmentBuckets[bucket].push_back(index);
+}
+
+void CanvasTileCache::markStaleTiles(const Segment& segment)
+{
+    const juce::Rectangle<float> tileArea(0.0f, 0.0f, (float)TILE_SIZE, (float)TILE_SIZE);
+    
+    for (auto& [key, tile] : tiles)
+    {
+        if (!tile.stale && getSegmentBounds(segment, getTileMapping(key)).intersects(tileArea))
+            tile.stale = true;
+    }
+}
+
+void CanvasTileCache::gatherSegments(float startTime, float endTime, size_t fromIndex, size_t toIndex,
+                                     std::vector<Segment>& result) const
+{
+    const auto overlaps = [startTime, endTime](const Segment& segment)
+    {
+        return juce::jmax(segment.start.x, segment.end.x) >= startTime
+            && juce::jmin(segment.start.x, segment.end.x) <= endTime;
+    };
+    
+    // A short tail of recent segments is cheaper to scan than the index
+    if (toIndex - fromIndex <= 64)
+    {
+        for (size_t i = fromIndex; i < toIndex; ++i)
+        {
+            if (overlaps(segments[i]))
+                result.push_back(segments[i]);
+        }
+        return;
+    }
+    
+    std::vector<size_t> indices;
+    const int firstBucket = (int)std::floor(startTime / BUCKET_SECONDS);
+    const int lastBucket = (int)std::floor(endTime / BUCKET_SECONDS);
+    
+    for (auto it = segmentBuckets.lower_bound(firstBucket);
+         it != segmentBuckets.end() && it->first <= lastBucket; ++it)
+    {
+        for (const auto index : it->second)
+        {
+            if (index >= fromIndex && index < toIndex)
+                indices.push_back(index);
+        }
+    }
+    
+    // Segments spanning several buckets appear more than once; keep paint order
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    
+    result.reserve(result.size() + indices.size());
+    for (const auto index : indices)
+        result.push_back(segments[index]);
+}
+
+void CanvasTileCache::collectSegments(float startTime, float endTime, size_t fromIndex,
+                                      std::vector<Segment>& result) const
+{
+    const juce::ScopedLock lock(cacheLock);
+    
+    if (fromIndex < segments.size())
+        gatherSegments(startTime, endTime, fromIndex, segments.size(), result);
+}
+
+//==============================================================================
+// Pyramid Levels
+
+int CanvasTileCache::getLevelForZoom(float zoomLevel)
+{
+    // Rounding up means tiles are only ever scaled down when composited
+    const int level = (int)std::ceil(std::log2(juce::jmax(zoomLevel, 1.0e-3f)) - 1.0e-3f);
+    return juce::jlimit(MIN_LEVEL, MAX_LEVEL, level);
+}
+
+float CanvasTileCache::getLevelPixelsPerSecond(int level) const
+{
+    return basePixelsPerSecond * std::ldexp(1.0f, level);
+}
+
+int CanvasTileCache::getNumTileRows() const
+{
+    return (canvasHeight + TILE_SIZE - 1) / TILE_SIZE;
+}
+
+//==============================================================================
+// Tile Lookup
+
+bool CanvasTileCache::findTile(int level, int tileX, int tileY, TileView& result)
+{
+    const juce::ScopedLock lock(cacheLock);
+    
+    const TileKey key(level, tileX, tileY);
+    auto it = tiles.find(key);
+    
+    if (it == tiles.end() || it->second.stale)
+        requestTile(key);
+    
+    // Fall back to the nearest coarser tile covering the same area
+    for (int fallback = level; it == tiles.end() && fallback > MIN_LEVEL; --fallback)
+    {
+        const int shift = level - fallback + 1;
+        it = tiles.find(TileKey(fallback - 1, tileX >> shift, tileY));
+    }
+    
+    if (it == tiles.end())
+        return false;
+    
+    auto& tile = it->second;
+    tile.lastUsed = ++useCounter;
+    
+    result.image = tile.image;
+    result.level = std::get<0>(it->first);
+    result.tileX = std::get<1>(it->first);
+    result.tileY = std::get<2>(it->first);
+    result.segmentCount = tile.segmentCount;
+    return true;
+}
+
+void CanvasTileCache::requestTile(const TileKey& key)
+{
+    auto existing = std::find(pendingRequests.begin(), pendingRequests.end(), key);
+    if (existing != pendingRequests.end())
+        pendingRequests.erase(existing);
+    
+    pendingRequests.push_back(key);
+    
+    // Requests from views that scrolled away are dropped first
+    const size_t maxPendingRequests = 128;
+    if (pendingRequests.size() > maxPendingRequests)
+        pendingRequests.erase(pendingRequests.begin());
+    
+    workerThread.notify();
+}
+
+void CanvasTileCache::setMemoryBudget(size_t bytes)
+{
+    const juce::ScopedLock lock(cacheLock);
+    memoryBudget = bytes;
+    evictTiles();
+}
+
+void CanvasTileCache::evictTiles()
+{
+    const size_t tileBytes = (size_t)TILE_SIZE * TILE_SIZE * 4;
+    const size_t maxTiles = juce::jmax((size_t)1, memoryBudget / tileBytes);
+    
+    while (tiles.size() > maxTiles)
+    {
+        auto oldest = tiles.begin();
+        for (auto it = tiles.begin(); it != tiles.end(); ++it)
+        {
+            if (it->second.lastUsed < oldest->second.lastUsed)
+                oldest = it;
+        }
+        tiles.erase(oldest);
+    }
+}
+
+//==============================================================================
+// Background Rasterisation
+
+bool CanvasTileCache::prepareNextJob(RasterJob& job)
+{
+    const juce::ScopedLock lock(cacheLock);
+    
+    while (!pendingRequests.empty())
+    {
+        const auto key = pendingRequests.back();
+        pendingRequests.pop_back();
+        
+        // Already refreshed by an earlier request
+        const auto it = tiles.find(key);
+        if (it != tiles.end() && !it->second.stale)
+            continue;
+        
+        if (basePixelsPerSecond <= 0.0f || canvasHeight <= 0)
+            return false;
+        
+        job.key = key;
+        job.mapping = getTileMapping(key);
+        job.segmentCount = segments.size();
+        job.generation = layoutGeneration;
+        job.segments.clear();
+        
+        // Include segments whose stroke width reaches into the tile
+        const float margin = (maxSegmentThickness * 0.5f + 1.0f) / job.mapping.pixelsPerSecond;
+        const float startTime = -job.mapping.originX / job.mapping.pixelsPerSecond - margin;
+        const float endTime = startTime + (float)TILE_SIZE / job.mapping.pixelsPerSecond + margin * 2.0f;
+        gatherSegments(startTime, endTime, 0, job.segmentCount, job.segments);
+        return true;
+    }
+    
+    return false;
+}
+
+void CanvasTileCache::publishTile(RasterJob& job, juce::Image image)
+{
+    const juce::ScopedLock lock(cacheLock);
+    
+    // Layout changed or canvas cleared while rasterising
+    if (job.generation != layoutGeneration)
+        return;
+    
+    auto& tile = tiles[job.key];
+    tile.image = image;
+    tile.segmentCount = job.segmentCount;
+    tile.lastUsed = ++useCounter;
+    tile.stale = false;
+    
+    // Segments added during rasterisation still need to be baked in
+    const juce::Rectangle<float> tileArea(0.0f, 0.0f, (float)TILE_SIZE, (float)TILE_SIZE);
+    for (size_t i = job.segmentCount; i < segments.size() && !tile.stale; ++i)
+        tile.stale = getSegmentBounds(segments[i], job.mapping).intersects(tileArea);
+    
+    evictTiles();
+    tilesCompleted = true;
+}
+
+void CanvasTileCache::TileWorkerThread::run()
+{
+    RasterJob job;
+    
+    while (!threadShouldExit())
+    {
+        if (!cache.prepareNextJob(job))
+        {
+            wait(-1);
+            continue;
+        }
+        
+        // Software images can be drawn on any thread
+        juce::Image image(juce::Image::ARGB, TILE_SIZE, TILE_SIZE, true, juce::SoftwareImageType());
+        {
+            juce::Graphics g(image);
+            for (const auto& segment : job.segments)
+            {
+                if (threadShouldExit())
+                    return;
+                
+                drawSegment(g, segment, job.mapping);
+            }
+        }
+        
+        cache.publishTile(job, image);
+    }
+}
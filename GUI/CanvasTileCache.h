@@ -0,0 +1,181 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <map>
+#include <tuple>
+#include <vector>
+
+/**
+ * CanvasTileCache - Multi-resolution tile cache for painted canvas strokes
+ *
+ * Stroke segments are rasterised into fixed-size tiles at power-of-two
+ * horizontal zoom levels (a mip pyramid) on a background thread. The view
+ * composites whichever tiles cover the visible area, so zooming and
+ * scrolling never re-rasterise the stroke geometry on the message thread.
+ *
+ * Design:
+ * - Segments are append-only; each tile remembers how many segments it
+ *   contains, so anything newer can be overlaid until the tile is refreshed
+ * - New segments mark the tiles under their bounding box stale at every level
+ * - Tiles are kept under an LRU memory budget
+ * - A layout change (canvas size, frequency range) drops all tiles
+ */
+class CanvasTileCache
+{
+public:
+    //==============================================================================
+    // Constants
+    
+    static constexpr int TILE_SIZE = 256;                      // Tile width/height in pixels
+    static constexpr int MIN_LEVEL = -4;                       // Coarsest level (1/16 zoom)
+    static constexpr int MAX_LEVEL = 4;                        // Finest level (16x zoom)
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = 64 * 1024 * 1024;
+    
+    //==============================================================================
+    // Content
+    
+    struct Segment
+    {
+        juce::Point<float> start;             // Canvas coordinates (time, frequency)
+        juce::Point<float> end;
+        float thickness = 1.0f;               // Line thickness in screen pixels
+        juce::Colour colour;
+    };
+    
+    // Maps canvas coordinates (seconds, Hz) to pixels for one drawing target
+    struct Mapping
+    {
+        float pixelsPerSecond = 100.0f;
+        float originX = 0.0f;                 // Pixel position of time zero
+        float originY = 0.0f;                 // Pixel position of the maximum frequency
+        float height = 0.0f;                  // Pixel span of the frequency range
+        float logMinFreq = 0.0f;
+        float logMaxFreq = 1.0f;
+        
+        float timeToX(float time) const { return originX + time * pixelsPerSecond; }
+        float frequencyToY(float frequency) const;
+    };
+    
+    // A cached tile as seen by the compositor
+    struct TileView
+    {
+        juce::Image image;
+        int level = 0;
+        int tileX = 0;
+        int tileY = 0;
+        size_t segmentCount = 0;              // Segments [0, segmentCount) are baked in
+    };
+    
+    //==============================================================================
+    // Main Interface
+    
+    CanvasTileCache();
+    ~CanvasTileCache();
+    
+    // Layout of level 0 - changing it invalidates every tile
+    void setLayout(float basePixelsPerSecond, int canvasHeight, float minFreq, float maxFreq);
+    
+    void addSegment(const Segment& segment);
+    void clear();
+    size_t getNumSegments() const;
+    
+    // Choose the pyramid level for a view zoom; the level is never coarser than the view
+    static int getLevelForZoom(float zoomLevel);
+    float getLevelPixelsPerSecond(int level) const;
+    int getNumTileRows() const;
+    
+    // Finds the tile at (level, tileX, tileY), falling back to coarser levels while it
+    // is being rasterised. Missing or stale tiles are queued for the worker.
+    bool findTile(int level, int tileX, int tileY, TileView& result);
+    
+    // Segments newer than fromIndex overlapping [startTime, endTime]
+    void collectSegments(float startTime, float endTime, size_t fromIndex,
+                         std::vector<Segment>& result) const;
+    
+    // Returns true once after the worker has published new tiles
+    bool takeCompletedTiles() { return tilesCompleted.exchange(false); }
+    
+    void setMemoryBudget(size_t bytes);
+    
+    static void drawSegment(juce::Graphics& g, const Segment& segment, const Mapping& mapping);
+
+private:
+    //==============================================================================
+    // Tile Storage
+    
+    using TileKey = std::tuple<int, int, int>;    // level, tileX, tileY
+    
+    struct Tile
+    {
+        juce::Image image;
+        size_t segmentCount = 0;
+        uint64_t lastUsed = 0;
+        bool stale = false;
+    };
+    
+    struct RasterJob
+    {
+        TileKey key;
+        Mapping mapping;
+        std::vector<Segment> segments;
+        size_t segmentCount = 0;
+        uint32_t generation = 0;
+    };
+    
+    bool prepareNextJob(RasterJob& job);
+    void publishTile(RasterJob& job, juce::Image image);
+    void requestTile(const TileKey& key);
+    void evictTiles();
+    
+    Mapping getTileMapping(const TileKey& key) const;
+    juce::Rectangle<float> getSegmentBounds(const Segment& segment, const Mapping& mapping) const;
+    void markStaleTiles(const Segment& segment);
+    void indexSegment(size_t index);
+    void gatherSegments(float startTime, float endTime, size_t fromIndex, size_t toIndex,
+                        std::vector<Segment>& result) const;
+    
+    //==============================================================================
+    // Member Variables
+    
+    static constexpr float BUCKET_SECONDS = 0.25f;    // Spatial index bucket width
+    
+    mutable juce::CriticalSection cacheLock;
+    
+    // Layout
+    float basePixelsPerSecond = 0.0f;
+    int canvasHeight = 0;
+    float minFreq = 80.0f;
+    float maxFreq = 8000.0f;
+    uint32_t layoutGeneration = 0;
+    
+    // Content, indexed by time bucket
+    std::vector<Segment> segments;
+    std::map<int, std::vector<size_t>> segmentBuckets;
+    float maxSegmentThickness = 1.0f;
+    
+    // Tiles
+    std::map<TileKey, Tile> tiles;
+    std::vector<TileKey> pendingRequests;         // Most recent request is served first
+    uint64_t useCounter = 0;
+    size_t memoryBudget = DEFAULT_MEMORY_BUDGET;
+    std::atomic<bool> tilesCompleted{false};
+    
+    //==============================================================================
+    // Background rasteriser
+    
+    class TileWorkerThread : public juce::Thread
+    {
+    public:
+        explicit TileWorkerThread(CanvasTileCache& owner)
+            : juce::Thread("Canvas Tile Worker"), cache(owner) {}
+        
+        void run() override;
+    
+    private:
+        CanvasTileCache& cache;
+    };
+    
+    TileWorkerThread workerThread{*this};
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CanvasTileCache)
+};
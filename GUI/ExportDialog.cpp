@@ -7,7 +7,7 @@
 ExportDialog::ExportDialog()
 {
     setupComponents();
-    setSize(600, 400);
+    setSize(600, 430);
     
     // Set default export directory to user's music folder
     auto musicDir = juce::File::getSpecialLocation(juce::File::userMusicDirectory);
@@ -54,7 +54,7 @@ void ExportDialog::paint(juce::Graphics& g)
     drawTerminalSection(g, fileSection, "FILE SETTINGS", ArtefactLookAndFeel::kAccentColour);
     yPos += 140;
     
-    auto optionsSection = juce::Rectangle<int>(bounds.getX(), yPos, bounds.getWidth(), 60);
+    auto optionsSection = juce::Rectangle<int>(bounds.getX(), yPos, bounds.getWidth(), 90);
     drawTerminalSection(g, optionsSection, "OPTIONS", ArtefactLookAndFeel::kAccentColour);
 }
 
@@ -85,6 +85,15 @@ void ExportDialog::resized()
     
     // Options Section
     overwriteToggle.setBounds(bounds.getX() + 10, yPos, 200, 25);
+    yPos += 30;
+    
+    alsoExportLabel.setBounds(bounds.getX() + 10, yPos, 90, 25);
+    int toggleX = bounds.getX() + 100;
+    for (auto& toggle : alsoExportToggles)
+    {
+        toggle.setBounds(toggleX, yPos, 80, 25);
+        toggleX += 84;
+    }
     yPos += 50;
     
     // Buttons
@@ -111,12 +120,33 @@ void ExportDialog::buttonClicked(juce::Button* button)
         
         currentSettings.overwriteExisting = overwriteToggle.getToggleState();
         
-        // Check if file exists and warn user
-        auto outputFile = currentSettings.outputDirectory.getChildFile(currentSettings.filename);
-        if (outputFile.existsAsFile() && !currentSettings.overwriteExisting)
+        // Extra formats are written alongside the primary one in a single pass
+        currentSettings.additionalFormatMask = 0;
+        for (size_t i = 0; i < alsoExportToggles.size(); ++i)
         {
-            // For now, just skip the overwrite check - will improve with proper async dialog later
-            // TODO: Implement proper async file overwrite dialog
+            if (alsoExportToggles[i].getToggleState())
+                currentSettings.additionalFormatMask |= AudioRecorder::getFormatBit(static_cast<AudioRecorder::ExportFormat>(i));
+        }
+        
+        // Check every file the export will write, suffixed names included, and warn the user
+        if (!currentSettings.overwriteExisting)
+        {
+            auto outputFile = currentSettings.outputDirectory.getChildFile(currentSettings.filename);
+            juce::StringArray existingFiles;
+            
+            for (const auto& target : AudioRecorder::createExportTargets(outputFile, currentSettings.getFormatMask()))
+            {
+                if (target.file.existsAsFile())
+                    existingFiles.add(target.file.getFileName());
+            }
+            
+            if (!existingFiles.isEmpty())
+            {
+                juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "File Exists",
+                                                       "These files already exist:\n" + existingFiles.joinIntoString("\n")
+                                                       + "\n\nChoose another name or enable overwriting.");
+                return;
+            }
         }
         
         // Close dialog with success
@@ -173,6 +203,16 @@ void ExportDialog::setupComponents()
     addAndMakeVisible(filenameEditor);
     addAndMakeVisible(browseButton);
     addAndMakeVisible(overwriteToggle);
+    addAndMakeVisible(alsoExportLabel);
+    
+    const char* alsoExportNames[] = { "WAV16", "WAV24", "WAV32F", "AIF16", "AIF24" };
+    for (size_t i = 0; i < alsoExportToggles.size(); ++i)
+    {
+        alsoExportToggles[i].setButtonText(alsoExportNames[i]);
+        alsoExportToggles[i].setColour(juce::ToggleButton::textColourId, ArtefactLookAndFeel::kTextColour);
+        alsoExportToggles[i].setColour(juce::ToggleButton::tickColourId, ArtefactLookAndFeel::kAccentColour);
+        addAndMakeVisible(alsoExportToggles[i]);
+    }
     
     // Buttons
     addAndMakeVisible(exportButton);
@@ -200,6 +240,9 @@ void ExportDialog::setupComponents()
     qualityInfoLabel.setColour(juce::Label::textColourId, ArtefactLookAndFeel::kPrimaryGreen);
     
     fileLabel.setFont(terminalFont);
+    
+    alsoExportLabel.setFont(terminalFont);
+    alsoExportLabel.setColour(juce::Label::textColourId, ArtefactLookAndFeel::kTextColour);
     fileLabel.setColour(juce::Label::textColourId, ArtefactLookAndFeel::kAccentColour);
     
     directoryLabel.setFont(createTerminalFont(9.0f));
@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "Core/AudioRecorder.h"
+#include <array>
 
 /**
  * ExportDialog - Terminal-aesthetic file export dialog
@@ -10,6 +11,7 @@
  * - Retro-style file format selection
  * - Terminal green aesthetic matching ARTEFACT theme
  * - WAV/AIFF format options with quality settings
+ * - Additional formats rendered in the same export pass
  * - File location chooser
  * - Export progress indication
  */
@@ -25,8 +27,11 @@ public:
         juce::File outputDirectory;
         juce::String filename;
         bool overwriteExisting = false;
+        int additionalFormatMask = 0;       // AudioRecorder::getFormatBit flags
         
         ExportSettings() = default;
+        
+        int getFormatMask() const { return AudioRecorder::getFormatBit(format) | additionalFormatMask; }
     };
     
     //==============================================================================
@@ -78,6 +83,8 @@ private:
     
     // Options
     juce::ToggleButton overwriteToggle {"Overwrite existing files"};
+    juce::Label alsoExportLabel {"alsoExportLabel", "ALSO EXPORT"};
+    std::array<juce::ToggleButton, 5> alsoExportToggles;    // Indexed by ExportFormat
     
     //==============================================================================
     // State
@@ -167,6 +167,15 @@ void HeaderBarComponent::buttonClicked(juce::Button* button)
     }
     else if (button == &exportButton)
     {
+        // A second press while an export is running cancels it
+        auto& recorder = processor.getAudioRecorder();
+        if (recorder.isExporting())
+        {
+            recorder.cancelExport();
+            statusLabel.setText("EXPORT CANCELLED", juce::dontSendNotification);
+            return;
+        }
+        
         // Show export dialog
         DBG("Export button clicked");
         statusLabel.setText("EXPORT DIALOG", juce::dontSendNotification);
@@ -183,10 +192,14 @@ void HeaderBarComponent::buttonClicked(juce::Button* button)
             // User confirmed export - send command to processor
             statusLabel.setText("EXPORTING...", juce::dontSendNotification);
             
-            // Send export command with settings
+            // Send export command with settings; several formats go out as one job
             auto outputFile = exportSettings.outputDirectory.getChildFile(exportSettings.filename);
-            Command exportCmd(RecordingCommandID::ExportToFile, outputFile.getFullPathName());
-            exportCmd.intParam = static_cast<int>(exportSettings.format);
+            const int formatMask = exportSettings.getFormatMask();
+            const bool severalFormats = (formatMask & (formatMask - 1)) != 0;
+            
+            Command exportCmd(severalFormats ? RecordingCommandID::ExportToFiles : RecordingCommandID::ExportToFile,
+                              outputFile.getFullPathName());
+            exportCmd.intParam = severalFormats ? formatMask : static_cast<int>(exportSettings.format);
             processor.pushCommandToQueue(exportCmd);
             
             DBG("Export command sent: " << outputFile.getFullPathName());
@@ -279,7 +292,12 @@ void HeaderBarComponent::updateRecordingStatus()
         
         // Show recording info when not recording
         auto& recorder = processor.getAudioRecorder();
-        if (recorder.getRecordedSeconds() > 0.0)
+        if (recorder.isExporting())
+        {
+            const int percent = juce::roundToInt(recorder.getExportProgress() * 100.0f);
+            statusLabel.setText("EXPORTING " + juce::String(percent) + "%", juce::dontSendNotification);
+        }
+        else if (recorder.getRecordedSeconds() > 0.0)
         {
             statusLabel.setText("READY TO EXPORT", juce::dontSendNotification);
         }
@@ -404,8 +404,9 @@ void PaintControlPanel::buttonClicked(juce::Button* button)
     // Canvas controls
     else if (button == &clearCanvasButton)
     {
-        sendPaintCommand(PaintCommandID::ClearCanvas);
+        // The canvas sends the clear itself, in order with its pen input
         if (canvasComponent) canvasComponent->clearCanvas();
+        else sendPaintCommand(PaintCommandID::ClearCanvas);
         DBG("Canvas cleared");
     }
     else if (button == &resetViewButton)
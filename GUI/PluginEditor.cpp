@@ -20,11 +20,13 @@ ARTEFACTAudioProcessorEditor::ARTEFACTAudioProcessorEditor(ARTEFACTAudioProcesso
     forgePanel = std::make_unique<ForgePanel>(p);
     retroCanvasComponent = std::make_unique<RetroCanvasComponent>();
     paintControlPanel = std::make_unique<PaintControlPanel>(p);
+    canvasPanel = std::make_unique<CanvasPanel>();
 
     addAndMakeVisible(headerBar.get());
     addAndMakeVisible(forgePanel.get());
     addAndMakeVisible(retroCanvasComponent.get());
     addAndMakeVisible(paintControlPanel.get());
+    addAndMakeVisible(canvasPanel.get());
 
     // Set up canvas integration with PaintEngine
     retroCanvasComponent->setPaintEngine(&p.getPaintEngine());
@@ -32,9 +34,16 @@ ARTEFACTAudioProcessorEditor::ARTEFACTAudioProcessorEditor(ARTEFACTAudioProcesso
         return p.pushCommandToQueue(cmd);
     });
     retroCanvasComponent->setProcessor(&p);
+    retroCanvasComponent->setPenInput(&p.getPenInputPipeline());
     
     // Set up paint control panel integration
     paintControlPanel->setCanvasComponent(retroCanvasComponent.get());
+    
+    // Dropped images and audio files are resynthesised by the CanvasProcessor
+    canvasPanel->onImageImported = [&p](std::shared_ptr<const ImageImporter::Result> result) {
+        if (result != nullptr && result->planes != nullptr)
+            p.getCanvasProcessor().updateFromPlanes(result->planes);
+    };
 
     // Add test button
     addAndMakeVisible(testButton);
@@ -82,6 +91,9 @@ void ARTEFACTAudioProcessorEditor::resized()
     auto paintControlArea = bounds.removeFromRight(paintControlWidth);
     paintControlPanel->setBounds(paintControlArea);
 
+    // Image import strip under the canvas
+    canvasPanel->setBounds(bounds.removeFromBottom(140));
+
     // Canvas takes the remaining center space (approximately 420px wide)
     retroCanvasComponent->setBounds(bounds);
 }
@@ -107,6 +119,10 @@ void ARTEFACTAudioProcessorEditor::timerCallback()
             paintEngine.getActiveOscillatorCount(),
             0.008f  // Approximate 8ms latency - could be more accurate
         );
+
+        // Preview the active paint brush sample once its overview is built
+        retroCanvasComponent->setWaveformOverview(
+            audioProcessor.getForgeProcessor().getWaveformOverview(audioProcessor.getActivePaintBrush()));
     }
 }
 
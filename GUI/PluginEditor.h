@@ -8,6 +8,7 @@
 #include "Core/ParameterBridge.h"
 #include "GUI/RetroCanvasComponent.h"
 #include "GUI/PaintControlPanel.h"
+#include "GUI/CanvasPanel.h"
 
 // Forward declarations
 class ARTEFACTAudioProcessor;
@@ -43,6 +44,7 @@ private:
     std::unique_ptr<ForgePanel> forgePanel;
     std::unique_ptr<RetroCanvasComponent> retroCanvasComponent;
     std::unique_ptr<PaintControlPanel> paintControlPanel;
+    std::unique_ptr<CanvasPanel> canvasPanel;
     juce::TextButton testButton {"Test"};
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ARTEFACTAudioProcessorEditor)
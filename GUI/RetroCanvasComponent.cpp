@@ -52,35 +52,22 @@ void RetroCanvasComponent::paint(juce::Graphics& g)
     // Calculate layout geometry
     const auto geom = calculateGeometry();
     
-    // Fill background with terminal black
-    g.fillAll(CanvasColors::CANVAS_IVORY);
+    if (getWidth() <= 0 || getHeight() <= 0)
+        return;
     
-    // Draw main canvas area
-    g.setColour(CanvasColors::CANVAS_WHITE);
-    g.fillRect(geom.canvasArea);
+    // Rebuild cached layers only when their inputs changed
+    if (staticLayerDirty)
+        rebuildStaticLayer(geom);
     
-    // Draw terminal-style border around canvas
-    drawTerminalBorder(g, geom.canvasArea, "SPECTRAL PAINT CANVAS", CanvasColors::EMERALD_GREEN);
+    // Background, border, grids and waveform preview
+    g.drawImageAt(staticLayer, 0, 0);
     
-    // Draw frequency and time grids
-    if (canvasState.showGrid)
-    {
-        drawFrequencyGrid(g, geom);
-        drawTimeGrid(g, geom);
-    }
-    
-    // Draw painted strokes (audio visualization)
+    // Painted strokes (audio visualization)
     drawPaintedStrokes(g, geom);
     
     // Draw playhead position
     drawPlayhead(g, geom);
     
-    // Draw waveform preview
-    if (canvasState.showWaveform)
-    {
-        drawWaveformPreview(g, geom);
-    }
-    
     // Draw status bar with performance info
     drawStatusBar(g, geom);
     
@@ -90,8 +77,8 @@ void RetroCanvasComponent::paint(juce::Graphics& g)
         drawBrushCursor(g);
     }
     
-    // Draw CRT-style scanlines for authentic retro feel
-    drawScanlines(g, getLocalBounds());
+    // CRT-style scanlines for authentic retro feel
+    g.drawImageAt(scanlineLayer, 0, 0);
     
     // Draw particles for visual feedback
     for (const auto& particle : particles)
@@ -102,7 +89,7 @@ void RetroCanvasComponent::paint(juce::Graphics& g)
 
 void RetroCanvasComponent::resized()
 {
-    geometryNeedsUpdate = true;
+    invalidateLayers();
 }
 
 void RetroCanvasComponent::mouseDown(const juce::MouseEvent& e)
@@ -113,7 +100,7 @@ void RetroCanvasComponent::mouseDown(const juce::MouseEvent& e)
         return;
         
     const auto canvasPoint = screenToCanvas(e.getPosition());
-    const float pressure = e.mods.isLeftButtonDown() ? 1.0f : 0.5f;
+    const float pressure = getPenPressure(e);
     
     beginPaintStroke(canvasPoint, pressure);
     
@@ -133,7 +120,7 @@ void RetroCanvasComponent::mouseDrag(const juce::MouseEvent& e)
         return;
         
     const auto canvasPoint = screenToCanvas(e.getPosition());
-    const float pressure = e.mods.isLeftButtonDown() ? 1.0f : 0.5f;
+    const float pressure = getPenPressure(e);
     
     updatePaintStroke(canvasPoint, pressure);
     
@@ -162,19 +149,21 @@ void RetroCanvasComponent::mouseWheelMove(const juce::MouseEvent& e, const juce:
     {
         float zoomFactor = 1.0f + (wheel.deltaY * 0.1f);
         canvasState.zoomLevel = juce::jlimit(0.1f, 10.0f, canvasState.zoomLevel * zoomFactor);
-        geometryNeedsUpdate = true;
+        invalidateLayers();
         repaint();
     }
     // Scroll vertically (frequency)
     else if (e.mods.isShiftDown())
     {
         canvasState.scrollY += wheel.deltaY * 50.0f;
+        invalidateLayers();
         repaint();
     }
     // Scroll horizontally (time)
     else
     {
         canvasState.scrollX += wheel.deltaX * 50.0f;
+        invalidateLayers();
         repaint();
     }
 }
@@ -190,8 +179,21 @@ void RetroCanvasComponent::timerCallback()
     // Cursor blinking effect
     showCursor = std::sin(animationTime * 4.0f) > 0.0f;
     
-    // Repaint for smooth animation
-    repaint();
+    // Repaint only the regions whose overlays moved or changed
+    const auto geom = calculateGeometry();
+    repaintIfChanged(lastPlayheadBounds, getPlayheadBounds(geom));
+    repaintIfChanged(lastCursorBounds, (showCursor && isMouseOver()) ? getCursorBounds()
+                                                                     : juce::Rectangle<int>());
+    
+    // Particles move every frame while alive, so their area is always refreshed
+    const auto particleBounds = getParticleBounds();
+    if (!particleBounds.isEmpty() || !lastParticleBounds.isEmpty())
+        repaint(lastParticleBounds.getUnion(particleBounds));
+    lastParticleBounds = particleBounds;
+    
+    // Stroke tiles finished rasterising in the background
+    if (tileCache.takeCompletedTiles())
+        repaint(geom.canvasArea);
 }
 
 //==============================================================================
@@ -316,32 +318,78 @@ void RetroCanvasComponent::drawTimeGrid(juce::Graphics& g, const CanvasGeometry&
 
 void RetroCanvasComponent::drawPaintedStrokes(juce::Graphics& g, const CanvasGeometry& geom)
 {
-    // TODO: Get painted strokes from PaintEngine and visualize them
-    // For now, draw a placeholder pattern
+    // Composite cached stroke tiles from the pyramid level matching the zoom
+    tileCache.setLayout(geom.canvasArea.getWidth() / canvasState.timeRange, geom.canvasArea.getHeight(),
+                        canvasState.minFreq, canvasState.maxFreq);
+    
+    const auto clip = g.getClipBounds().getIntersection(geom.canvasArea);
+    const int level = CanvasTileCache::getLevelForZoom(canvasState.zoomLevel);
+    const float levelPixelsPerSecond = tileCache.getLevelPixelsPerSecond(level);
+    
+    if (clip.isEmpty() || levelPixelsPerSecond <= 0.0f)
+        return;
+    
+    const int tileSize = CanvasTileCache::TILE_SIZE;
+    const float tileSeconds = (float)tileSize / levelPixelsPerSecond;
+    const float overlayMargin = 32.0f / geom.pixelsPerSecond;
+    const auto mapping = getScreenMapping(geom);
+    const size_t numSegments = tileCache.getNumSegments();
     
-    g.setColour(CanvasColors::PAINT_BLUE.withAlpha(0.7f));
+    const int firstColumn = juce::jmax(0, (int)std::floor(screenXToTime(clip.getX(), geom) / tileSeconds));
+    const int lastColumn = (int)std::floor(screenXToTime(clip.getRight(), geom) / tileSeconds);
+    const int firstRow = (clip.getY() - geom.canvasArea.getY()) / tileSize;
+    const int lastRow = juce::jmin(tileCache.getNumTileRows() - 1,
+                                   (clip.getBottom() - 1 - geom.canvasArea.getY()) / tileSize);
     
-    // Draw some example painted areas as bright blocks
-    for (int i = 0; i < 10; ++i)
+    g.saveState();
+    g.reduceClipRegion(geom.canvasArea);
+    g.setImageResamplingQuality(juce::Graphics::mediumResamplingQuality);
+    
+    for (int column = firstColumn; column <= lastColumn; ++column)
     {
-        const float time = i * 0.8f;
-        const float freq = 200.0f + i * 100.0f;
-        const int x = timeToScreenX(time, geom);
-        const int y = frequencyToScreenY(freq, geom);
-        const int width = (int)(geom.pixelsPerSecond * 0.3f);
-        const int height = 8;
+        const float startTime = column * tileSeconds;
+        const float destX = mapping.timeToX(startTime);
+        const float destWidth = mapping.timeToX(startTime + tileSeconds) - destX;
         
-        if (x >= geom.canvasArea.getX() && x <= geom.canvasArea.getRight() &&
-            y >= geom.canvasArea.getY() && y <= geom.canvasArea.getBottom())
+        for (int row = firstRow; row <= lastRow; ++row)
         {
-            g.fillRect(x, y - height/2, width, height);
+            const int destY = geom.canvasArea.getY() + row * tileSize;
+            size_t bakedSegments = 0;
             
-            // Add glow effect
-            g.setColour(CanvasColors::PAINT_BLUE.withAlpha(0.3f));
-            g.fillRect(x - 1, y - height/2 - 1, width + 2, height + 2);
-            g.setColour(CanvasColors::PAINT_BLUE.withAlpha(0.7f));
+            CanvasTileCache::TileView tile;
+            if (tileCache.findTile(level, column, row, tile))
+            {
+                // The tile may come from a coarser level while this one is rasterised
+                const float tilePixelsPerSecond = tileCache.getLevelPixelsPerSecond(tile.level);
+                const int sourceWidth = juce::roundToInt(tileSeconds * tilePixelsPerSecond);
+                const int sourceX = juce::roundToInt(startTime * tilePixelsPerSecond) - tile.tileX * tileSize;
+                
+                g.drawImageTransformed(tile.image.getClippedImage({ sourceX, 0, sourceWidth, tileSize }),
+                                       juce::AffineTransform::scale(destWidth / (float)sourceWidth, 1.0f)
+                                           .translated(destX, (float)destY));
+                bakedSegments = tile.segmentCount;
+            }
+            
+            // Draw segments the tile does not contain yet
+            if (bakedSegments < numSegments)
+            {
+                overlaySegments.clear();
+                tileCache.collectSegments(startTime - overlayMargin, startTime + tileSeconds + overlayMargin,
+                                          bakedSegments, overlaySegments);
+                
+                g.saveState();
+                g.reduceClipRegion(juce::Rectangle<float>(destX, (float)destY, destWidth, (float)tileSize)
+                                       .getSmallestIntegerContainer());
+                for (const auto& segment : overlaySegments)
+                {
+                    CanvasTileCache::drawSegment(g, segment, mapping);
+                }
+                g.restoreState();
+            }
         }
     }
+    
+    g.restoreState();
 }
 
 void RetroCanvasComponent::drawPlayhead(juce::Graphics& g, const CanvasGeometry& geom)
@@ -376,9 +424,54 @@ void RetroCanvasComponent::drawPlayhead(juce::Graphics& g, const CanvasGeometry&
 
 void RetroCanvasComponent::drawWaveformPreview(juce::Graphics& g, const CanvasGeometry& geom)
 {
-    // TODO: Get actual waveform data from PaintEngine
-    // For now, draw a placeholder waveform
+    const int centerY = geom.waveformArea.getCentreY();
     
+    if (waveformOverview != nullptr && waveformOverview->getNumSamples() > 0)
+    {
+        // One overview column per pixel, aligned with the canvas time axis
+        const int startX = geom.waveformArea.getX();
+        const int numColumns = geom.waveformArea.getWidth();
+        const double sampleRate = waveformOverview->getSampleRate();
+        const double startSample = screenXToTime(startX, geom) * sampleRate;
+        const double samplesPerColumn = sampleRate / geom.pixelsPerSecond;
+        
+        waveformColumns.resize((size_t)juce::jmax(0, numColumns));
+        waveformOverview->getColumns(startSample, samplesPerColumn, waveformColumns.data(), numColumns);
+        
+        const float halfHeight = geom.waveformArea.getHeight() * 0.45f;
+        for (int i = 0; i < numColumns; ++i)
+        {
+            const auto& column = waveformColumns[(size_t)i];
+            if (column.maxValue <= column.minValue)
+                continue;
+            
+            g.setColour(CanvasColors::EMERALD_GREEN.withAlpha(0.4f));
+            g.drawVerticalLine(startX + i, centerY - column.maxValue * halfHeight,
+                               centerY - column.minValue * halfHeight + 1.0f);
+            
+            g.setColour(CanvasColors::EMERALD_GREEN.withAlpha(0.8f));
+            g.drawVerticalLine(startX + i, centerY - column.rms * halfHeight,
+                               centerY + column.rms * halfHeight + 1.0f);
+        }
+    }
+    else
+    {
+        drawPlaceholderWaveform(g, geom);
+    }
+    
+    // Draw waveform area border
+    g.setColour(CanvasColors::EMERALD_GREEN);
+    g.drawRect(geom.waveformArea, 1);
+    
+    // Add "WAVEFORM" label
+    g.setFont(createTerminalFont(8.0f));
+    g.drawText("WAVEFORM", 
+              geom.waveformArea.getX() + 2, geom.waveformArea.getY() + 2,
+              60, 10, juce::Justification::left);
+}
+
+void RetroCanvasComponent::drawPlaceholderWaveform(juce::Graphics& g, const CanvasGeometry& geom)
+{
     g.setColour(CanvasColors::EMERALD_GREEN.withAlpha(0.6f));
     
     const int centerY = geom.waveformArea.getCentreY();
@@ -406,16 +499,6 @@ void RetroCanvasComponent::drawWaveformPreview(juce::Graphics& g, const CanvasGe
     }
     
     g.strokePath(waveform, juce::PathStrokeType(1.0f));
-    
-    // Draw waveform area border
-    g.setColour(CanvasColors::EMERALD_GREEN);
-    g.drawRect(geom.waveformArea, 1);
-    
-    // Add "WAVEFORM" label
-    g.setFont(createTerminalFont(8.0f));
-    g.drawText("WAVEFORM", 
-              geom.waveformArea.getX() + 2, geom.waveformArea.getY() + 2,
-              60, 10, juce::Justification::left);
 }
 
 void RetroCanvasComponent::drawStatusBar(juce::Graphics& g, const CanvasGeometry& geom)
@@ -520,6 +603,141 @@ void RetroCanvasComponent::drawScanlines(juce::Graphics& g, juce::Rectangle<int>
     }
 }
 
+//==============================================================================
+// Layer Cache
+
+void RetroCanvasComponent::invalidateLayers()
+{
+    geometryNeedsUpdate = true;
+    staticLayerDirty = true;
+}
+
+void RetroCanvasComponent::rebuildStaticLayer(const CanvasGeometry& geom)
+{
+    const auto bounds = getLocalBounds();
+    
+    staticLayer = juce::Image(juce::Image::RGB, bounds.getWidth(), bounds.getHeight(), false);
+    {
+        juce::Graphics g(staticLayer);
+        
+        // Fill background with terminal black
+        g.fillAll(CanvasColors::CANVAS_IVORY);
+        
+        // Draw main canvas area
+        g.setColour(CanvasColors::CANVAS_WHITE);
+        g.fillRect(geom.canvasArea);
+        
+        // Draw terminal-style border around canvas
+        drawTerminalBorder(g, geom.canvasArea, "SPECTRAL PAINT CANVAS", CanvasColors::EMERALD_GREEN);
+        
+        // Draw frequency and time grids
+        if (canvasState.showGrid)
+        {
+            drawFrequencyGrid(g, geom);
+            drawTimeGrid(g, geom);
+        }
+        
+        // Draw waveform preview
+        if (canvasState.showWaveform)
+        {
+            drawWaveformPreview(g, geom);
+        }
+    }
+    
+    // Scanlines only depend on the component size
+    scanlineLayer = juce::Image(juce::Image::ARGB, bounds.getWidth(), bounds.getHeight(), true);
+    {
+        juce::Graphics g(scanlineLayer);
+        drawScanlines(g, bounds);
+    }
+    
+    staticLayerDirty = false;
+}
+
+void RetroCanvasComponent::appendStrokeSegment(juce::Point<float> from, juce::Point<float> to, float pressure)
+{
+    CanvasTileCache::Segment segment;
+    segment.start = from;
+    segment.end = to;
+    segment.thickness = 1.0f + brushSize * pressure * 2.0f;
+    segment.colour = brushColor.withAlpha(0.7f);
+    tileCache.addSegment(segment);
+    
+    // The segment is overlaid on the affected tiles until they are rasterised again
+    const auto geom = calculateGeometry();
+    const auto start = canvasToScreen(from).toFloat();
+    const auto end = canvasToScreen(to).toFloat();
+    const auto bounds = juce::Rectangle<float>(start, end).expanded(segment.thickness + 1.0f);
+    repaint(bounds.getSmallestIntegerContainer().getIntersection(geom.canvasArea));
+}
+
+CanvasTileCache::Mapping RetroCanvasComponent::getScreenMapping(const CanvasGeometry& geom) const
+{
+    CanvasTileCache::Mapping mapping;
+    mapping.pixelsPerSecond = geom.pixelsPerSecond;
+    mapping.originX = (float)geom.canvasArea.getX() - canvasState.scrollX;
+    mapping.originY = (float)geom.canvasArea.getY();
+    mapping.height = (float)geom.canvasArea.getHeight();
+    mapping.logMinFreq = std::log2(canvasState.minFreq);
+    mapping.logMaxFreq = std::log2(canvasState.maxFreq);
+    return mapping;
+}
+
+juce::Rectangle<int> RetroCanvasComponent::getPlayheadBounds(const CanvasGeometry& geom) const
+{
+    const float playheadTime = std::fmod(animationTime, canvasState.timeRange);
+    const int playheadX = timeToScreenX(playheadTime, geom);
+    
+    if (playheadX < geom.canvasArea.getX() || playheadX > geom.canvasArea.getRight())
+        return {};
+    
+    // Covers the glow lines and the triangle marker above the canvas
+    return { playheadX - 6, geom.canvasArea.getY() - 6, 13, geom.canvasArea.getHeight() + 7 };
+}
+
+juce::Rectangle<int> RetroCanvasComponent::getCursorBounds() const
+{
+    const auto geom = calculateGeometry();
+    
+    if (!geom.canvasArea.contains(mousePosition))
+        return {};
+    
+    const int size = (int)(brushSize * 10.0f);
+    const juce::Rectangle<int> crosshair(mousePosition.x - size - 1, mousePosition.y - size - 1,
+                                         size * 2 + 2, size * 2 + 2);
+    const juce::Rectangle<int> infoText(mousePosition.x + 10, mousePosition.y - 20, 80, 15);
+    
+    return crosshair.getUnion(infoText);
+}
+
+juce::Rectangle<int> RetroCanvasComponent::getParticleBounds() const
+{
+    juce::Rectangle<float> bounds;
+    
+    for (const auto& particle : particles)
+    {
+        // Glow diameter is at most (2 + 3) * 2 pixels
+        const juce::Rectangle<float> area(particle.position.x - 6.0f, particle.position.y - 6.0f, 12.0f, 12.0f);
+        bounds = bounds.isEmpty() ? area : bounds.getUnion(area);
+    }
+    
+    return bounds.getSmallestIntegerContainer();
+}
+
+void RetroCanvasComponent::repaintIfChanged(juce::Rectangle<int>& lastBounds, juce::Rectangle<int> newBounds)
+{
+    if (newBounds == lastBounds)
+        return;
+    
+    // Erase the old overlay and draw the new one
+    if (!lastBounds.isEmpty())
+        repaint(lastBounds);
+    if (!newBounds.isEmpty())
+        repaint(newBounds);
+    
+    lastBounds = newBounds;
+}
+
 //==============================================================================
 // Font Management
 
@@ -580,12 +798,12 @@ int RetroCanvasComponent::frequencyToScreenY(float frequency, const CanvasGeomet
 
 float RetroCanvasComponent::screenXToTime(int screenX, const CanvasGeometry& geom) const
 {
-    return (float)(screenX - geom.canvasArea.getX()) / geom.pixelsPerSecond;
+    return (float)(screenX - geom.canvasArea.getX() + canvasState.scrollX) / geom.pixelsPerSecond;
 }
 
 int RetroCanvasComponent::timeToScreenX(float time, const CanvasGeometry& geom) const
 {
-    return geom.canvasArea.getX() + (int)(time * geom.pixelsPerSecond);
+    return geom.canvasArea.getX() + (int)(time * geom.pixelsPerSecond - canvasState.scrollX);
 }
 
 RetroCanvasComponent::CanvasGeometry RetroCanvasComponent::calculateGeometry() const
@@ -635,12 +853,18 @@ void RetroCanvasComponent::beginPaintStroke(juce::Point<float> canvasPoint, floa
     isPainting = true;
     lastPaintPoint = canvasPoint;
     brushPressure = pressure;
+    repaint(calculateGeometry().statusBar);
     
     // Handle SampleBrush differently - trigger ForgeVoice samples
     if (currentBrushType == BrushType::SampleBrush && processor)
     {
         processor->triggerPaintBrush(canvasPoint.y, pressure);
     }
+    else if (penInput != nullptr)
+    {
+        // Timestamped and delivered to the PaintEngine once per audio block
+        penInput->pushBegin(PaintEngine::Point(canvasPoint.x, canvasPoint.y), pressure, brushColor);
+    }
     else
     {
         // Use standard PaintEngine for other brush types
@@ -653,6 +877,8 @@ void RetroCanvasComponent::updatePaintStroke(juce::Point<float> canvasPoint, flo
     if (!isPainting)
         return;
     
+    appendStrokeSegment(lastPaintPoint, canvasPoint, pressure);
+    
     lastPaintPoint = canvasPoint;
     brushPressure = pressure;
     
@@ -661,6 +887,10 @@ void RetroCanvasComponent::updatePaintStroke(juce::Point<float> canvasPoint, flo
     {
         processor->triggerPaintBrush(canvasPoint.y, pressure);
     }
+    else if (penInput != nullptr)
+    {
+        penInput->pushMove(PaintEngine::Point(canvasPoint.x, canvasPoint.y), pressure);
+    }
     else
     {
         // Use standard PaintEngine for other brush types
@@ -674,12 +904,17 @@ void RetroCanvasComponent::endPaintStroke()
         return;
     
     isPainting = false;
+    repaint(calculateGeometry().statusBar);
     
     // Handle SampleBrush differently - stop the sample
     if (currentBrushType == BrushType::SampleBrush && processor)
     {
         processor->stopPaintBrush();
     }
+    else if (penInput != nullptr)
+    {
+        penInput->pushEnd();
+    }
     else
     {
         // Use standard PaintEngine for other brush types
@@ -696,6 +931,15 @@ void RetroCanvasComponent::sendPaintCommand(PaintCommandID commandID, juce::Poin
     }
 }
 
+float RetroCanvasComponent::getPenPressure(const juce::MouseEvent& e) const
+{
+    // Tablets report real pressure; mouse buttons fall back to two levels
+    if (e.isPressureValid())
+        return e.pressure;
+    
+    return e.mods.isLeftButtonDown() ? 1.0f : 0.5f;
+}
+
 void RetroCanvasComponent::addParticleAt(juce::Point<float> position, juce::Colour color)
 {
     Particle particle;
@@ -753,19 +997,32 @@ void RetroCanvasComponent::updateParticles()
 void RetroCanvasComponent::setCanvasState(const CanvasState& newState)
 {
     canvasState = newState;
-    geometryNeedsUpdate = true;
+    invalidateLayers();
     repaint();
 }
 
+void RetroCanvasComponent::setWaveformOverview(std::shared_ptr<const WaveformOverview> overview)
+{
+    if (overview == waveformOverview)
+        return;
+    
+    // The preview lives in the static layer
+    waveformOverview = std::move(overview);
+    staticLayerDirty = true;
+    repaint(calculateGeometry().waveformArea);
+}
+
 void RetroCanvasComponent::clearCanvas()
 {
-    if (commandTarget)
+    // Through the pen pipeline the clear stays behind strokes that are still queued
+    if ((penInput == nullptr || !penInput->pushClear()) && commandTarget)
     {
         Command cmd(PaintCommandID::ClearCanvas);
         commandTarget(cmd);
     }
     
     particles.clear();
+    tileCache.clear();
     repaint();
 }
 
@@ -774,7 +1031,7 @@ void RetroCanvasComponent::resetView()
     canvasState.zoomLevel = 1.0f;
     canvasState.scrollX = 0.0f;
     canvasState.scrollY = 0.0f;
-    geometryNeedsUpdate = true;
+    invalidateLayers();
     repaint();
 }
 
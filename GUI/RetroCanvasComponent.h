@@ -2,7 +2,10 @@
 
 #include <JuceHeader.h>
 #include "Core/PaintEngine.h"
+#include "Core/PenInputPipeline.h"
+#include "Core/WaveformOverview.h"
 #include "Core/Commands.h"
+#include "CanvasTileCache.h"
 
 /**
  * RetroCanvasComponent - Terminal-aesthetic audio painting canvas
@@ -102,6 +105,10 @@ public:
     void setPaintEngine(PaintEngine* engine) { paintEngine = engine; }
     void setCommandTarget(std::function<bool(const Command&)> target) { commandTarget = target; }
     void setProcessor(class ARTEFACTAudioProcessor* proc) { processor = proc; }
+    void setPenInput(PenInputPipeline* pipeline) { penInput = pipeline; }
+    
+    // Sample shown in the waveform preview; nullptr shows the placeholder
+    void setWaveformOverview(std::shared_ptr<const WaveformOverview> overview);
     
     // Performance monitoring
     void setPerformanceInfo(float cpuLoad, int activeOscillators, float latency);
@@ -132,6 +139,7 @@ private:
     void drawPaintedStrokes(juce::Graphics& g, const CanvasGeometry& geom);
     void drawPlayhead(juce::Graphics& g, const CanvasGeometry& geom);
     void drawWaveformPreview(juce::Graphics& g, const CanvasGeometry& geom);
+    void drawPlaceholderWaveform(juce::Graphics& g, const CanvasGeometry& geom);
     void drawStatusBar(juce::Graphics& g, const CanvasGeometry& geom);
     void drawBrushCursor(juce::Graphics& g);
     
@@ -146,6 +154,20 @@ private:
                            float intensity, juce::Colour color);
     void drawScanlines(juce::Graphics& g, juce::Rectangle<int> area);
     
+    //==============================================================================
+    // Layer Cache
+    
+    void invalidateLayers();
+    void rebuildStaticLayer(const CanvasGeometry& geom);
+    void appendStrokeSegment(juce::Point<float> from, juce::Point<float> to, float pressure);
+    CanvasTileCache::Mapping getScreenMapping(const CanvasGeometry& geom) const;
+    
+    // Dirty regions for the per-frame overlays
+    juce::Rectangle<int> getPlayheadBounds(const CanvasGeometry& geom) const;
+    juce::Rectangle<int> getCursorBounds() const;
+    juce::Rectangle<int> getParticleBounds() const;
+    void repaintIfChanged(juce::Rectangle<int>& lastBounds, juce::Rectangle<int> newBounds);
+    
     //==============================================================================
     // Coordinate Conversion
     
@@ -167,6 +189,7 @@ private:
     
     void sendPaintCommand(PaintCommandID commandID, juce::Point<float> canvasPoint, 
                          float pressure = 1.0f);
+    float getPenPressure(const juce::MouseEvent& e) const;
     
     // Visual feedback for painting
     void addParticleAt(juce::Point<float> position, juce::Colour color);
@@ -195,6 +218,7 @@ private:
     // Audio integration
     PaintEngine* paintEngine = nullptr;
     std::function<bool(const Command&)> commandTarget;
+    PenInputPipeline* penInput = nullptr;
     class ARTEFACTAudioProcessor* processor = nullptr;
     
     // Performance monitoring
@@ -222,5 +246,23 @@ private:
     mutable CanvasGeometry cachedGeometry;
     mutable bool geometryNeedsUpdate = true;
     
+    // Cached render layers, rebuilt only on resize/zoom/scroll
+    juce::Image staticLayer;                  // Background, border, grids, waveform frame
+    juce::Image scanlineLayer;                // CRT scanline overlay (transparent)
+    bool staticLayerDirty = true;
+    
+    // Waveform preview source, summarised per pixel column
+    std::shared_ptr<const WaveformOverview> waveformOverview;
+    std::vector<WaveformOverview::Column> waveformColumns;
+    
+    // Painted strokes, rasterised into a mip pyramid of tiles
+    CanvasTileCache tileCache;
+    std::vector<CanvasTileCache::Segment> overlaySegments;
+    
+    // Last painted bounds of the dynamic overlays
+    juce::Rectangle<int> lastPlayheadBounds;
+    juce::Rectangle<int> lastCursorBounds;
+    juce::Rectangle<int> lastParticleBounds;
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RetroCanvasComponent)
 };
\ No newline at end of file
@@ -61,6 +61,8 @@ void SampleSlotComponent::paint(juce::Graphics& g)
     // Draw waveform if available - modern vibrant style
     if (!waveformPath.isEmpty())
     {
+        g.setColour(ArtefactLookAndFeel::kReadoutGreen.withAlpha(0.35f));
+        g.fillPath(waveformPath);
         g.setColour(ArtefactLookAndFeel::kReadoutGreen);
         g.strokePath(waveformPath, juce::PathStrokeType(1.5f));
     }
@@ -127,6 +129,15 @@ void SampleSlotComponent::filesDropped(const juce::StringArray& files, int x, in
 
 void SampleSlotComponent::timerCallback()
 {
+    // Pick up the overview once the background build for a new sample finishes
+    auto overview = processor.getForgeProcessor().getWaveformOverview(slotIndex);
+    if (overview != waveformOverview)
+    {
+        waveformOverview = std::move(overview);
+        updateWaveformPath();
+        repaint();
+    }
+    
     updateFromProcessor();
 }
 
@@ -134,20 +145,36 @@ void SampleSlotComponent::updateWaveformPath()
 {
     waveformPath.clear();
     
-    auto& voice = processor.getForgeProcessor().getVoice(slotIndex);
-    if (voice.hasSample())
+    auto bounds = getLocalBounds().removeFromBottom(getHeight() - 20).reduced(2, 2);
+    if (waveformOverview == nullptr || waveformOverview->getNumSamples() == 0 || bounds.isEmpty())
+        return;
+    
+    // One overview column per pixel, whatever the sample length
+    const int numColumns = bounds.getWidth();
+    const double samplesPerColumn = (double)waveformOverview->getNumSamples() / numColumns;
+    waveformColumns.resize((size_t)numColumns);
+    waveformOverview->getColumns(0.0, samplesPerColumn, waveformColumns.data(), numColumns);
+    
+    const float centreY = (float)bounds.getCentreY();
+    const float halfHeight = bounds.getHeight() * 0.5f;
+    
+    // Closed min/max envelope: maxima left to right, minima back again
+    for (int x = 0; x < numColumns; ++x)
     {
-        // Simple waveform representation
-        auto bounds = getLocalBounds().removeFromBottom(getHeight() - 20);
-        waveformPath.startNewSubPath(bounds.getX(), bounds.getCentreY());
-        
-        // Draw a simple sine wave as placeholder
-        for (int x = 0; x < bounds.getWidth(); x += 4)
-        {
-            float y = bounds.getCentreY() + 10.0f * std::sin(x * 0.1f);
-            waveformPath.lineTo(bounds.getX() + x, y);
-        }
+        const float y = centreY - juce::jlimit(-1.0f, 1.0f, waveformColumns[(size_t)x].maxValue) * halfHeight;
+        if (x == 0)
+            waveformPath.startNewSubPath((float)bounds.getX(), y);
+        else
+            waveformPath.lineTo((float)(bounds.getX() + x), y);
+    }
+    
+    for (int x = numColumns - 1; x >= 0; --x)
+    {
+        const float y = centreY - juce::jlimit(-1.0f, 1.0f, waveformColumns[(size_t)x].minValue) * halfHeight;
+        waveformPath.lineTo((float)(bounds.getX() + x), y);
     }
+    
+    waveformPath.closeSubPath();
 }
 
 void SampleSlotComponent::updateFromProcessor()
@@ -168,6 +195,8 @@ void SampleSlotComponent::updateFromProcessor()
 
 void SampleSlotComponent::resized()
 {
+    updateWaveformPath();
+    
     if (isExpanded)
     {
         const int knob = 40, gap = 60;
@@ -3,6 +3,7 @@
 #include <JuceHeader.h>        // instead of juce_gui_basics/juce_gui_basics.h
 #include "Core/PluginProcessor.h" // instead of just a forward declaration
 #include <memory>
+#include <vector>
 
 class ARTEFACTAudioProcessor;
 
@@ -49,6 +50,8 @@ private:
     // Waveform display
     juce::Path waveformPath;
     float      playheadPosition = 0.0f;
+    std::shared_ptr<const WaveformOverview> waveformOverview;   // summary the path was built from
+    std::vector<WaveformOverview::Column>   waveformColumns;
 
     // State
     bool isExpanded = false;